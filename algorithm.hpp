@@ -1,7 +1,15 @@
 #ifndef ALGORITHM_HPP
 # define ALGORITHM_HPP
 
+#include "iter.hpp"
+#include "traits.hpp"
+#include "simd.hpp"
+
+#include <cstring>
 #include <functional>
+#include <iterator>
+#include <memory>
+#include <algorithm>
 
 namespace ft
 {
@@ -52,18 +60,555 @@ struct greater : std::binary_function<T, T, bool>
 	}
 };
 
+/*
+ *	copy, copy_backward
+ *	contiguous ranges of the same pod type are moved with a single memmove,
+ *	everything else falls back to element-wise assignment
+ */
+template<typename InputIt, typename OutputIt>
+struct can_memmove
+: public integral_constant<bool,
+	contiguous_iterator<InputIt>::value && contiguous_iterator<OutputIt>::value> {};
+
+template<typename InputIt, typename OutputIt, bool = can_memmove<InputIt, OutputIt>::value>
+struct copy_dispatch
+{
+	static OutputIt copy(InputIt first, InputIt last, OutputIt d_first) {
+		for (; first != last; ++first, ++d_first) *d_first = *first;
+		return d_first;
+	}
+	static OutputIt copy_backward(InputIt first, InputIt last, OutputIt d_last) {
+		for (; first != last; ) *(--d_last) = *(--last);
+		return d_last;
+	}
+};
+
+template<typename InputIt, typename OutputIt>
+struct copy_dispatch<InputIt, OutputIt, true>
+{
+	typedef contiguous_iterator<InputIt>	in_traits;
+	typedef contiguous_iterator<OutputIt>	out_traits;
+	typedef typename out_traits::value_type	value_type;
+
+	typedef integral_constant<bool,
+		is_same<typename in_traits::value_type, value_type>::value
+		&& is_pod<value_type>::value>		trivial;
+
+	static OutputIt copy(InputIt first, InputIt last, OutputIt d_first) {
+		return copy(first, last, d_first, trivial());
+	}
+	static OutputIt copy_backward(InputIt first, InputIt last, OutputIt d_last) {
+		return copy_backward(first, last, d_last, trivial());
+	}
+
+private:
+	static OutputIt copy(InputIt first, InputIt last, OutputIt d_first, true_type) {
+		const std::ptrdiff_t n = last - first;
+		if (n > 0)
+			std::memmove(out_traits::address(d_first), in_traits::address(first), n * sizeof(value_type));
+		return d_first + n;
+	}
+	static OutputIt copy(InputIt first, InputIt last, OutputIt d_first, false_type) {
+		return copy_dispatch<InputIt, OutputIt, false>::copy(first, last, d_first);
+	}
+	static OutputIt copy_backward(InputIt first, InputIt last, OutputIt d_last, true_type) {
+		const std::ptrdiff_t n = last - first;
+		if (n > 0)
+			std::memmove(out_traits::address(d_last) - n, in_traits::address(first), n * sizeof(value_type));
+		return d_last - n;
+	}
+	static OutputIt copy_backward(InputIt first, InputIt last, OutputIt d_last, false_type) {
+		return copy_dispatch<InputIt, OutputIt, false>::copy_backward(first, last, d_last);
+	}
+};
+
 template<typename InputIt, typename OutputIt>
 OutputIt copy(InputIt first, InputIt last, OutputIt d_first) {
-	for (; first != last; ++first, ++d_first) *d_first = *first;
-	return d_first;
+	return copy_dispatch<InputIt, OutputIt>::copy(first, last, d_first);
 }
 
 template<typename InputIt, typename OutputIt>
 OutputIt copy_backward(InputIt first, InputIt last, OutputIt d_last) {
-	for (; first != last; ) *(--d_last) = *(--last);
-	return d_last;
+	return copy_dispatch<InputIt, OutputIt>::copy_backward(first, last, d_last);
+}
+
+/*
+ *	find, count, min_element, max_element, accumulate
+ *	contiguous ranges of simd::supported types go through the vector kernels
+ */
+template<typename Iter, typename T, bool = contiguous_iterator<Iter>::value>
+struct search_dispatch
+{
+	typedef typename iterator_traits<Iter>::difference_type	difference_type;
+
+	static Iter find(Iter first, Iter last, const T& value) {
+		for (; first != last; ++first) if (*first == value) return first;
+		return last;
+	}
+	static difference_type count(Iter first, Iter last, const T& value) {
+		difference_type ret = 0;
+		for (; first != last; ++first) if (*first == value) ++ret;
+		return ret;
+	}
+	static Iter min_element(Iter first, Iter last) {
+		if (first == last) return last;
+		Iter smallest = first;
+		while (++first != last) if (*first < *smallest) smallest = first;
+		return smallest;
+	}
+	static Iter max_element(Iter first, Iter last) {
+		if (first == last) return last;
+		Iter largest = first;
+		while (++first != last) if (*largest < *first) largest = first;
+		return largest;
+	}
+	static T accumulate(Iter first, Iter last, T init) {
+		for (; first != last; ++first) init = init + *first;
+		return init;
+	}
 };
 
+template<typename Iter, typename T>
+struct search_dispatch<Iter, T, true>
+{
+	typedef contiguous_iterator<Iter>						traits;
+	typedef typename traits::value_type						value_type;
+	typedef typename iterator_traits<Iter>::difference_type	difference_type;
+	typedef search_dispatch<Iter, T, false>					generic;
+
+	typedef integral_constant<bool,
+		is_same<value_type, T>::value && simd::supported<value_type>::value>	vector;
+
+	static Iter find(Iter first, Iter last, const T& value) {
+		return find(first, last, value, vector());
+	}
+	static difference_type count(Iter first, Iter last, const T& value) {
+		return count(first, last, value, vector());
+	}
+	static Iter min_element(Iter first, Iter last) {
+		return min_element(first, last, vector());
+	}
+	static Iter max_element(Iter first, Iter last) {
+		return max_element(first, last, vector());
+	}
+	static T accumulate(Iter first, Iter last, T init) {
+		return accumulate(first, last, init, vector());
+	}
+
+private:
+	static Iter find(Iter first, Iter last, const T& value, true_type) {
+		return first + simd::find(traits::address(first), last - first, value);
+	}
+	static Iter find(Iter first, Iter last, const T& value, false_type) {
+		return generic::find(first, last, value);
+	}
+	static difference_type count(Iter first, Iter last, const T& value, true_type) {
+		return simd::count(traits::address(first), last - first, value);
+	}
+	static difference_type count(Iter first, Iter last, const T& value, false_type) {
+		return generic::count(first, last, value);
+	}
+	//	a leading NaN is never replaced by the scalar loop, keep that answer
+	static Iter min_element(Iter first, Iter last, true_type) {
+		if (first == last || !(*first == *first)) return first;
+		return find(first, last, simd::min(traits::address(first), last - first), true_type());
+	}
+	static Iter min_element(Iter first, Iter last, false_type) {
+		return generic::min_element(first, last);
+	}
+	static Iter max_element(Iter first, Iter last, true_type) {
+		if (first == last || !(*first == *first)) return first;
+		return find(first, last, simd::max(traits::address(first), last - first), true_type());
+	}
+	static Iter max_element(Iter first, Iter last, false_type) {
+		return generic::max_element(first, last);
+	}
+	static T accumulate(Iter first, Iter last, T init, true_type) {
+		return simd::sum(traits::address(first), last - first, init);
+	}
+	static T accumulate(Iter first, Iter last, T init, false_type) {
+		return generic::accumulate(first, last, init);
+	}
+};
+
+template<typename InputIt, typename T>
+InputIt find(InputIt first, InputIt last, const T& value) {
+	return search_dispatch<InputIt, T>::find(first, last, value);
+}
+
+template<typename InputIt, typename UnaryPred>
+InputIt find_if(InputIt first, InputIt last, UnaryPred pred) {
+	for (; first != last; ++first) if (pred(*first)) return first;
+	return last;
+}
+
+template<typename InputIt, typename T>
+typename iterator_traits<InputIt>::difference_type
+count(InputIt first, InputIt last, const T& value) {
+	return search_dispatch<InputIt, T>::count(first, last, value);
+}
+
+template<typename InputIt, typename UnaryPred>
+typename iterator_traits<InputIt>::difference_type
+count_if(InputIt first, InputIt last, UnaryPred pred) {
+	typename iterator_traits<InputIt>::difference_type ret = 0;
+	for (; first != last; ++first) if (pred(*first)) ++ret;
+	return ret;
+}
+
+template<typename ForwardIt>
+ForwardIt min_element(ForwardIt first, ForwardIt last) {
+	return search_dispatch<ForwardIt, typename iterator_traits<ForwardIt>::value_type>::min_element(first, last);
+}
+
+template<typename ForwardIt, typename Compare>
+ForwardIt min_element(ForwardIt first, ForwardIt last, Compare comp) {
+	if (first == last) return last;
+	ForwardIt smallest = first;
+	while (++first != last) if (comp(*first, *smallest)) smallest = first;
+	return smallest;
+}
+
+template<typename ForwardIt>
+ForwardIt max_element(ForwardIt first, ForwardIt last) {
+	return search_dispatch<ForwardIt, typename iterator_traits<ForwardIt>::value_type>::max_element(first, last);
+}
+
+template<typename ForwardIt, typename Compare>
+ForwardIt max_element(ForwardIt first, ForwardIt last, Compare comp) {
+	if (first == last) return last;
+	ForwardIt largest = first;
+	while (++first != last) if (comp(*largest, *first)) largest = first;
+	return largest;
+}
+
+template<typename InputIt, typename T>
+T accumulate(InputIt first, InputIt last, T init) {
+	return search_dispatch<InputIt, T>::accumulate(first, last, init);
+}
+
+template<typename InputIt, typename T, typename BinaryOp>
+T accumulate(InputIt first, InputIt last, T init, BinaryOp op) {
+	for (; first != last; ++first) init = op(init, *first);
+	return init;
+}
+
+template<typename InputIt, typename UnaryFunc>
+UnaryFunc for_each(InputIt first, InputIt last, UnaryFunc f) {
+	for (; first != last; ++first) f(*first);
+	return f;
+}
+
+template<typename InputIt, typename OutputIt, typename UnaryOp>
+OutputIt transform(InputIt first, InputIt last, OutputIt d_first, UnaryOp op) {
+	for (; first != last; ++first, ++d_first) *d_first = op(*first);
+	return d_first;
+}
+
+template<typename InputIt1, typename InputIt2, typename OutputIt, typename BinaryOp>
+OutputIt transform(InputIt1 first1, InputIt1 last1, InputIt2 first2, OutputIt d_first, BinaryOp op) {
+	for (; first1 != last1; ++first1, ++first2, ++d_first) *d_first = op(*first1, *first2);
+	return d_first;
+}
+
+template<typename InputIt, typename T>
+T reduce(InputIt first, InputIt last, T init) {
+	return ft::accumulate(first, last, init);
+}
+
+template<typename InputIt, typename T, typename BinaryOp>
+T reduce(InputIt first, InputIt last, T init, BinaryOp op) {
+	return ft::accumulate(first, last, init, op);
+}
+
+/*
+ *	lower_bound, upper_bound, merge
+ */
+template<typename ForwardIt, typename T, typename Compare>
+ForwardIt lower_bound(ForwardIt first, ForwardIt last, const T& value, Compare comp) {
+	typename iterator_traits<ForwardIt>::difference_type len = std::distance(first, last);
+
+	while (len > 0) {
+		typename iterator_traits<ForwardIt>::difference_type half = len / 2;
+		ForwardIt mid = first;
+		std::advance(mid, half);
+		if (comp(*mid, value)) {
+			first = ++mid;
+			len -= half + 1;
+		}
+		else len = half;
+	}
+	return first;
+}
+
+template<typename ForwardIt, typename T>
+ForwardIt lower_bound(ForwardIt first, ForwardIt last, const T& value) {
+	return ft::lower_bound(first, last, value, ft::less<T>());
+}
+
+template<typename ForwardIt, typename T, typename Compare>
+ForwardIt upper_bound(ForwardIt first, ForwardIt last, const T& value, Compare comp) {
+	typename iterator_traits<ForwardIt>::difference_type len = std::distance(first, last);
+
+	while (len > 0) {
+		typename iterator_traits<ForwardIt>::difference_type half = len / 2;
+		ForwardIt mid = first;
+		std::advance(mid, half);
+		if (!comp(value, *mid)) {
+			first = ++mid;
+			len -= half + 1;
+		}
+		else len = half;
+	}
+	return first;
+}
+
+template<typename ForwardIt, typename T>
+ForwardIt upper_bound(ForwardIt first, ForwardIt last, const T& value) {
+	return ft::upper_bound(first, last, value, ft::less<T>());
+}
+
+//	stable : on ties the element of the first range is taken
+template<typename InputIt1, typename InputIt2, typename OutputIt, typename Compare>
+OutputIt merge(InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2, OutputIt d_first, Compare comp) {
+	for (; first1 != last1 && first2 != last2; ++d_first) {
+		if (comp(*first2, *first1)) *d_first = *first2++;
+		else *d_first = *first1++;
+	}
+	return ft::copy(first2, last2, ft::copy(first1, last1, d_first));
+}
+
+template<typename InputIt1, typename InputIt2, typename OutputIt>
+OutputIt merge(InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2, OutputIt d_first) {
+	return ft::merge(first1, last1, first2, last2, d_first,
+		ft::less<typename iterator_traits<InputIt1>::value_type>());
+}
+
+/*
+ *	Heap : max heap on comp, same layout as std::make_heap
+ */
+template<typename RandomIt, typename Compare>
+void sift_down(RandomIt first, typename iterator_traits<RandomIt>::difference_type hole,
+				typename iterator_traits<RandomIt>::difference_type len, Compare comp) {
+	typedef typename iterator_traits<RandomIt>::difference_type	difference_type;
+	typename iterator_traits<RandomIt>::value_type	value = first[hole];
+
+	for (;;) {
+		difference_type child = 2 * hole + 1;
+		if (child >= len) break;
+		if (child + 1 < len && comp(first[child], first[child + 1])) ++child;
+		if (!comp(value, first[child])) break;
+		first[hole] = first[child];
+		hole = child;
+	}
+	first[hole] = value;
+}
+
+template<typename RandomIt, typename Compare>
+void push_heap(RandomIt first, RandomIt last, Compare comp) {
+	typedef typename iterator_traits<RandomIt>::difference_type	difference_type;
+	difference_type hole = (last - first) - 1;
+	if (hole <= 0) return ;
+
+	typename iterator_traits<RandomIt>::value_type	value = first[hole];
+	while (hole > 0) {
+		difference_type parent = (hole - 1) / 2;
+		if (!comp(first[parent], value)) break;
+		first[hole] = first[parent];
+		hole = parent;
+	}
+	first[hole] = value;
+}
+
+template<typename RandomIt, typename Compare>
+void pop_heap(RandomIt first, RandomIt last, Compare comp) {
+	if (last - first < 2) return ;
+	std::swap(*first, *(last - 1));
+	ft::sift_down(first, 0, (last - first) - 1, comp);
+}
+
+template<typename RandomIt, typename Compare>
+void make_heap(RandomIt first, RandomIt last, Compare comp) {
+	typename iterator_traits<RandomIt>::difference_type len = last - first;
+	for (typename iterator_traits<RandomIt>::difference_type i = len / 2; i > 0; --i)
+		ft::sift_down(first, i - 1, len, comp);
+}
+
+template<typename RandomIt, typename Compare>
+void sort_heap(RandomIt first, RandomIt last, Compare comp) {
+	for (; last - first > 1; --last) ft::pop_heap(first, last, comp);
+}
+
+template<typename RandomIt>
+void push_heap(RandomIt first, RandomIt last) {
+	ft::push_heap(first, last, ft::less<typename iterator_traits<RandomIt>::value_type>());
+}
+template<typename RandomIt>
+void pop_heap(RandomIt first, RandomIt last) {
+	ft::pop_heap(first, last, ft::less<typename iterator_traits<RandomIt>::value_type>());
+}
+template<typename RandomIt>
+void make_heap(RandomIt first, RandomIt last) {
+	ft::make_heap(first, last, ft::less<typename iterator_traits<RandomIt>::value_type>());
+}
+template<typename RandomIt>
+void sort_heap(RandomIt first, RandomIt last) {
+	ft::sort_heap(first, last, ft::less<typename iterator_traits<RandomIt>::value_type>());
+}
+
+/*
+ *	Sort : introsort, heapsort past 2 * log2(n) bad partitions
+ */
+static const int insertion_threshold = 16;
+
+template<typename RandomIt, typename Compare>
+void insertion_sort(RandomIt first, RandomIt last, Compare comp) {
+	if (first == last) return ;
+	for (RandomIt i = first + 1; i != last; ++i) {
+		typename iterator_traits<RandomIt>::value_type	value = *i;
+
+		if (comp(value, *first)) {
+			ft::copy_backward(first, i, i + 1);
+			*first = value;
+		} else {
+			RandomIt hole = i;
+			RandomIt prev = i;
+			for (--prev; comp(value, *prev); --prev) {
+				*hole = *prev;
+				hole = prev;
+			}
+			*hole = value;
+		}
+	}
+}
+
+template<typename RandomIt, typename Compare>
+void move_median_to_first(RandomIt result, RandomIt a, RandomIt b, RandomIt c, Compare comp) {
+	if (comp(*a, *b)) {
+		if (comp(*b, *c)) std::swap(*result, *b);
+		else if (comp(*a, *c)) std::swap(*result, *c);
+		else std::swap(*result, *a);
+	}
+	else if (comp(*a, *c)) std::swap(*result, *a);
+	else if (comp(*b, *c)) std::swap(*result, *c);
+	else std::swap(*result, *b);
+}
+
+//	pivot sits at *pivot, both scans are stopped by it or by the median of three
+template<typename RandomIt, typename Compare>
+RandomIt unguarded_partition(RandomIt first, RandomIt last, RandomIt pivot, Compare comp) {
+	for (;;) {
+		while (comp(*first, *pivot)) ++first;
+		--last;
+		while (comp(*pivot, *last)) --last;
+		if (!(first < last)) return first;
+		std::swap(*first, *last);
+		++first;
+	}
+}
+
+template<typename RandomIt, typename Compare>
+void introsort_loop(RandomIt first, RandomIt last, int depth, Compare comp) {
+	while (last - first > insertion_threshold) {
+		if (depth == 0) {
+			ft::make_heap(first, last, comp);
+			ft::sort_heap(first, last, comp);
+			return ;
+		}
+		--depth;
+		ft::move_median_to_first(first, first + 1, first + (last - first) / 2, last - 1, comp);
+		RandomIt cut = ft::unguarded_partition(first + 1, last, first, comp);
+		ft::introsort_loop(cut, last, depth, comp);
+		last = cut;
+	}
+}
+
+template<typename RandomIt, typename Compare>
+void sort(RandomIt first, RandomIt last, Compare comp) {
+	int depth = 0;
+	for (typename iterator_traits<RandomIt>::difference_type n = last - first; n > 1; n >>= 1) depth += 2;
+	ft::introsort_loop(first, last, depth, comp);
+	ft::insertion_sort(first, last, comp);
+}
+
+template<typename RandomIt>
+void sort(RandomIt first, RandomIt last) {
+	ft::sort(first, last, ft::less<typename iterator_traits<RandomIt>::value_type>());
+}
+
+/*
+ *	Temporary Buffer
+ *	copy constructed scratch space, the element type needs no default constructor
+ */
+template<typename T>
+class temporary_buffer
+{
+	std::allocator<T>	alloc;
+	T*					buf;
+	std::size_t			len;
+
+	temporary_buffer(const temporary_buffer&);
+	temporary_buffer& operator=(const temporary_buffer&);
+
+public:
+	template<typename InputIt>
+	temporary_buffer(InputIt first, InputIt last) : alloc(), buf(0), len(std::distance(first, last)) {
+		buf = alloc.allocate(len);
+		try {
+			std::uninitialized_copy(first, last, buf);
+		}
+		catch (...) {
+			alloc.deallocate(buf, len);
+			throw ;
+		}
+	}
+	~temporary_buffer() {
+		for (std::size_t i = 0; i < len; ++i) alloc.destroy(buf + i);
+		alloc.deallocate(buf, len);
+	}
+
+	T* begin() const { return buf; }
+	T* end() const { return buf + len; }
+	std::size_t size() const { return len; }
+};
+
+/*
+ *	Stable Sort : insertion sorted runs, then bottom up merge passes
+ *	that bounce between the range and a temporary buffer
+ */
+template<typename Src, typename Dst, typename Compare>
+void merge_pass(Src src, Dst dst, std::ptrdiff_t n, std::ptrdiff_t width, Compare comp) {
+	for (std::ptrdiff_t lo = 0; lo < n; lo += 2 * width) {
+		std::ptrdiff_t mid = std::min(lo + width, n);
+		std::ptrdiff_t hi = std::min(lo + 2 * width, n);
+		ft::merge(src + lo, src + mid, src + mid, src + hi, dst + lo, comp);
+	}
+}
+
+template<typename RandomIt, typename Compare>
+void stable_sort(RandomIt first, RandomIt last, Compare comp) {
+	typedef typename iterator_traits<RandomIt>::value_type	value_type;
+	const std::ptrdiff_t n = last - first;
+	const std::ptrdiff_t run = 32;
+
+	for (std::ptrdiff_t lo = 0; lo < n; lo += run)
+		ft::insertion_sort(first + lo, first + std::min(lo + run, n), comp);
+	if (n <= run) return ;
+
+	temporary_buffer<value_type>	buf(first, last);
+	bool	in_buf = false;
+	for (std::ptrdiff_t width = run; width < n; width *= 2, in_buf = !in_buf) {
+		if (in_buf) ft::merge_pass(buf.begin(), first, n, width, comp);
+		else ft::merge_pass(first, buf.begin(), n, width, comp);
+	}
+	if (in_buf) ft::copy(buf.begin(), buf.end(), first);
+}
+
+template<typename RandomIt>
+void stable_sort(RandomIt first, RandomIt last) {
+	ft::stable_sort(first, last, ft::less<typename iterator_traits<RandomIt>::value_type>());
+}
+
 template<typename Pair>
 struct Select1st : public std::unary_function<Pair, typename Pair::first_type>
 {
@@ -0,0 +1,75 @@
+#include "bench.hpp"
+#include "../map.hpp"
+#include <cstdio>
+
+typedef ft::map<int, long>	plain_map;
+typedef ft::map<int, long, std::less<int>, std::allocator<ft::pair<const int, long> >,
+				ft::augmented_tree<ft::plus_monoid<long> > >	sum_map;
+
+static unsigned long long xorshift(unsigned long long& x) {
+	x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+	return x;
+}
+
+struct counting
+{
+	int		i;
+	bool operator!=(const counting& rhs) const { return i != rhs.i; }
+	counting& operator++() { ++i; return *this; }
+	ft::pair<int, long> operator*() const { return ft::make_pair(i, long(i % 7)); }
+};
+
+//	what the aggregates cost on updates : random inserts, then erases
+template<typename M>
+static void updates(const char* name, size_t n) {
+	unsigned long long x = 88172645463325252ULL;
+	M m;
+	bench::timer t;
+	for (size_t i = 0; i < n; ++i) m.insert(ft::make_pair(int(xorshift(x) % (n * 4)), long(i)));
+	for (size_t i = 0; i < n; ++i) m.erase(int(xorshift(x) % (n * 4)));
+	bench::report(name, n, t.ms());
+	bench::do_not_optimize(m.size());
+}
+
+int main(int argc, char** argv) {
+	const size_t	n = bench::arg(argc, argv, 1, 10000000);
+	const size_t	queries = bench::arg(argc, argv, 2, 1000);
+	unsigned long long x = 2463534242ULL;
+	sum_map			m;
+	long			sum = 0;
+
+	counting	first = { 0 };
+	m.assign_sorted(first, n);
+
+	std::cout << "range sums over " << n << " keys, " << queries << " queries per width" << std::endl;
+	for (size_t width = 10; width <= n; width *= 10) {
+		char	name[64];
+
+		//	iteration walks width nodes a query : fewer queries on wide ranges
+		const size_t	walks = width * queries > 100000000 ? 100000000 / width : queries;
+
+		std::snprintf(name, sizeof(name), "  width %zu, iteration", width);
+		bench::timer t;
+		for (size_t q = 0; q < walks; ++q) {
+			const int lo = int(xorshift(x) % (n - width + 1));
+			sum_map::const_iterator last = m.lower_bound(lo + int(width));
+			for (sum_map::const_iterator it = m.lower_bound(lo); it != last; ++it) sum += it->second;
+		}
+		bench::report(name, walks, t.ms());
+
+		std::snprintf(name, sizeof(name), "  width %zu, aggregate", width);
+		t.reset();
+		for (size_t q = 0; q < queries; ++q) {
+			const int lo = int(xorshift(x) % (n - width + 1));
+			sum += m.aggregate(lo, lo + int(width));
+		}
+		bench::report(name, queries, t.ms());
+	}
+
+	const size_t	u = n / 10;
+	std::cout << "random inserts then erases" << std::endl;
+	updates<plain_map>("  ft::map", u);
+	updates<sum_map>("  ft::map<..., augmented_tree>", u);
+	bench::do_not_optimize(sum);
+	return 0;
+}
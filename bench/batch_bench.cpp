@@ -0,0 +1,51 @@
+#include "bench.hpp"
+#include "../map.hpp"
+#include <cstdio>
+#include <vector>
+
+//	keys handed over batch at a time : batch 1 is the one at a time path through find_batch
+int main(int argc, char** argv) {
+	const size_t n = bench::arg(argc, argv, 1, 8000000);
+	const size_t queries = bench::arg(argc, argv, 2, 2000000);
+	long sum = 0;
+
+	ft::map<int, int> m;
+	//	random inserts : tree order is not address order
+	{
+		unsigned long long x = 88172645463325252ULL;
+		for (size_t i = 0; i < n; ++i) {
+			x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+			m.insert(ft::make_pair(int(x % (2 * n)), int(i)));
+		}
+	}
+	std::vector<int> keys(queries);
+	unsigned long long x = 2463534242ULL;
+	for (size_t i = 0; i < queries; ++i) {
+		x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+		keys[i] = int(x % (2 * n));
+	}
+
+	std::cout << m.size() << " keys, " << queries << " lookups" << std::endl;
+	{
+		bench::timer t;
+		for (size_t i = 0; i < queries; ++i) {
+			ft::map<int, int>::iterator it = m.find(keys[i]);
+			if (it != m.end()) sum += it->second;
+		}
+		bench::report("find, one at a time", queries, t.ms());
+	}
+	std::vector<ft::map<int, int>::iterator> out(64);
+	for (size_t batch = 1; batch <= 64; batch *= 2) {
+		bench::timer t;
+		for (size_t i = 0; i + batch <= queries; i += batch) {
+			m.find_batch(keys.begin() + i, keys.begin() + i + batch, out.begin());
+			for (size_t j = 0; j < batch; ++j)
+				if (out[j] != m.end()) sum += out[j]->second;
+		}
+		char name[64];
+		std::snprintf(name, sizeof(name), "find_batch, %2zu keys per call", batch);
+		bench::report(name, queries, t.ms());
+	}
+	bench::do_not_optimize(sum);
+	return 0;
+}
@@ -0,0 +1,48 @@
+#ifndef BENCH_HPP
+# define BENCH_HPP
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+
+namespace bench
+{
+
+class timer
+{
+	typedef std::chrono::steady_clock	clock;
+
+	clock::time_point	start;
+
+public:
+	timer() : start(clock::now()) {}
+
+	void reset() { start = clock::now(); }
+	double sec() const {
+		return std::chrono::duration<double>(clock::now() - start).count();
+	}
+	double ms() const { return sec() * 1000.0; }
+};
+
+/*
+ *	Keep the optimizer from dropping a computed value
+ */
+template<typename T>
+void do_not_optimize(const T& value) {
+	asm volatile("" : : "r,m"(value) : "memory");
+}
+
+inline size_t arg(int argc, char** argv, int idx, size_t fallback) {
+	return argc > idx ? std::strtoull(argv[idx], 0, 10) : fallback;
+}
+
+inline void report(const char* name, size_t n, double ms) {
+	std::cout << std::left << std::setw(40) << name
+			  << std::right << std::setw(12) << n
+			  << std::setw(12) << std::fixed << std::setprecision(2) << ms << " ms" << std::endl;
+}
+
+}	//	BENCH
+
+#endif
@@ -0,0 +1,81 @@
+#include "bench.hpp"
+#include "../concurrent_stack.hpp"
+#include "../concurrent_queue.hpp"
+#include "../stack.hpp"
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+ *	Baseline : ft::stack behind a mutex, the way it is shared today
+ */
+class locked_stack
+{
+	ft::stack<int>	st;
+	std::mutex		lock;
+
+public:
+	void push(int v) {
+		std::lock_guard<std::mutex> guard(lock);
+		st.push(v);
+	}
+	bool try_pop(int& out) {
+		std::lock_guard<std::mutex> guard(lock);
+		if (st.empty()) return false;
+		out = st.top();
+		st.pop();
+		return true;
+	}
+};
+
+template<typename Container>
+double run(Container& con, int producers, int consumers, size_t per_producer) {
+	const size_t total = producers * per_producer;
+	std::atomic<size_t> consumed(0);
+	std::vector<std::thread> threads;
+
+	bench::timer t;
+	for (int p = 0; p < producers; p++)
+		threads.push_back(std::thread([&] {
+			for (size_t i = 0; i < per_producer; i++) con.push(int(i));
+		}));
+	for (int c = 0; c < consumers; c++)
+		threads.push_back(std::thread([&] {
+			int v;
+			while (consumed.load(std::memory_order_relaxed) < total) {
+				if (con.try_pop(v)) consumed.fetch_add(1, std::memory_order_relaxed);
+				else std::this_thread::yield();
+			}
+		}));
+	for (size_t i = 0; i < threads.size(); i++) threads[i].join();
+	return t.ms();
+}
+
+void report_ops(const char* name, size_t ops, double ms) {
+	std::cout << std::left << std::setw(36) << name << std::right << std::setw(10)
+			  << std::fixed << std::setprecision(2) << ops / (ms * 1000.0) << " Mops/s" << std::endl;
+}
+
+int main(int argc, char** argv) {
+	const size_t per_producer = bench::arg(argc, argv, 1, 1000000);
+	const int max_threads = bench::arg(argc, argv, 2, std::max(2u, std::thread::hardware_concurrency()));
+
+	for (int pairs = 1; pairs * 2 <= max_threads; pairs *= 2) {
+		std::cout << pairs << " producer(s) / " << pairs << " consumer(s)" << std::endl;
+		const size_t ops = pairs * per_producer;
+		{
+			locked_stack st;
+			report_ops("  mutex + ft::stack", ops, run(st, pairs, pairs, per_producer));
+		}
+		{
+			ft::concurrent_stack<int> st;
+			report_ops("  ft::concurrent_stack", ops, run(st, pairs, pairs, per_producer));
+		}
+		{
+			ft::concurrent_queue<int> q(1 << 16);
+			report_ops("  ft::concurrent_queue", ops, run(q, pairs, pairs, per_producer));
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,51 @@
+#include "bench.hpp"
+#include "../vector.hpp"
+#include <vector>
+
+/*
+ *	Same layout as int, but not a pod: forces the element-wise copy loop
+ */
+struct boxed
+{
+	int v;
+
+	boxed() : v() {}
+	boxed(int x) : v(x) {}
+	boxed(const boxed& rhs) : v(rhs.v) {}
+	boxed& operator=(const boxed& rhs) { v = rhs.v; return *this; }
+};
+
+template<typename Vec>
+double front_erase(size_t n, size_t rounds) {
+	Vec v(n);
+	bench::timer t;
+	for (size_t i = 0; i < rounds; i++) v.erase(v.begin());
+	double ms = t.ms();
+	bench::do_not_optimize(v[0]);
+	return ms;
+}
+
+template<typename Vec>
+double middle_insert(size_t n, size_t rounds) {
+	Vec v(n);
+	v.reserve(n + rounds);
+	bench::timer t;
+	for (size_t i = 0; i < rounds; i++) v.insert(v.begin() + v.size() / 2, typename Vec::value_type(1));
+	double ms = t.ms();
+	bench::do_not_optimize(v[0]);
+	return ms;
+}
+
+int main(int argc, char** argv) {
+	const size_t n = bench::arg(argc, argv, 1, 10000000);
+	const size_t rounds = bench::arg(argc, argv, 2, 20);
+
+	std::cout << "elements: " << n << ", rounds: " << rounds << std::endl;
+	bench::report("front erase   ft::vector<int>", n, front_erase<ft::vector<int> >(n, rounds));
+	bench::report("front erase   ft::vector<boxed>", n, front_erase<ft::vector<boxed> >(n, rounds));
+	bench::report("front erase   std::vector<int>", n, front_erase<std::vector<int> >(n, rounds));
+	bench::report("middle insert ft::vector<int>", n, middle_insert<ft::vector<int> >(n, rounds));
+	bench::report("middle insert ft::vector<boxed>", n, middle_insert<ft::vector<boxed> >(n, rounds));
+	bench::report("middle insert std::vector<int>", n, middle_insert<std::vector<int> >(n, rounds));
+	return 0;
+}
@@ -0,0 +1,46 @@
+#include "bench.hpp"
+#include "../deque.hpp"
+#include "../stack.hpp"
+#include "../vector.hpp"
+#include <deque>
+
+#define BUFFER_SIZE 4096
+struct Buffer
+{
+	int idx;
+	char buff[BUFFER_SIZE];
+};
+
+template<typename Container>
+void run(const char* name, size_t n) {
+	ft::stack<Buffer, Container> st;
+	Buffer b;
+	b.idx = 0;
+
+	bench::timer t;
+	for (size_t i = 0; i < n; i++) {
+		b.idx = int(i);
+		st.push(b);
+	}
+	const double push_ms = t.ms();
+	t.reset();
+	long sum = 0;
+	while (!st.empty()) {
+		sum += st.top().idx;
+		st.pop();
+	}
+	const double pop_ms = t.ms();
+	bench::do_not_optimize(sum);
+	std::cout << name << std::endl;
+	bench::report("  push", n, push_ms);
+	bench::report("  pop", n, pop_ms);
+}
+
+int main(int argc, char** argv) {
+	const size_t n = bench::arg(argc, argv, 1, 200000);
+
+	run<ft::vector<Buffer> >("ft::stack<Buffer, ft::vector<Buffer> >", n);
+	run<ft::deque<Buffer> >("ft::stack<Buffer, ft::deque<Buffer> >", n);
+	run<std::deque<Buffer> >("ft::stack<Buffer, std::deque<Buffer> >", n);
+	return 0;
+}
@@ -0,0 +1,69 @@
+#include "bench.hpp"
+#include "../external_sort.hpp"
+#include "../map.hpp"
+
+struct record
+{
+	long	key;
+	long	payload;
+
+	bool operator<(const record& rhs) const { return key < rhs.key; }
+};
+
+static long next_key(unsigned long long& x) {
+	x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+	return long(x >> 1);
+}
+
+int main(int argc, char** argv) {
+	const size_t budget = bench::arg(argc, argv, 1, 128) << 20;
+	long sum = 0;
+
+	std::cout << "memory budget " << (budget >> 20) << " MB, 16 byte records" << std::endl;
+	for (size_t factor = 1; factor <= 4; factor *= 2) {
+		const size_t		n = factor * budget / sizeof(record);
+		unsigned long long	x = 88172645463325252ULL;
+
+		std::cout << factor << "x the budget" << std::endl;
+		{
+			bench::timer t;
+			ft::external_sorter<record> s(budget);
+			for (size_t i = 0; i < n; ++i) {
+				const record r = { next_key(x), long(i) };
+				s.push(r);
+			}
+			bench::report("  runs (sort + spill)", n, t.ms());
+			t.reset();
+			for (ft::external_sorter<record>::iterator it = s.begin(); it != s.end(); ++it) sum += it->payload;
+			bench::report("  merge", n, t.ms());
+			std::cout << "    " << s.spilled_runs() << " runs merged from disk" << std::endl;
+		}
+		{
+			//	everything in memory, for reference : needs factor x the budget
+			x = 88172645463325252ULL;
+			bench::timer t;
+			ft::vector<record> v;
+			v.reserve(n);
+			for (size_t i = 0; i < n; ++i) {
+				const record r = { next_key(x), long(i) };
+				v.push_back(r);
+			}
+			ft::sort(v.begin(), v.end());
+			bench::report("  ft::sort in memory", n, t.ms());
+			sum += v[n / 2].payload;
+		}
+	}
+	{
+		//	sorted unique keys straight into a map, linear build
+		const size_t	n = 2 * budget / sizeof(ft::pair<long, long>);
+		bench::timer t;
+		ft::external_sorter<ft::pair<long, long> > s(budget);
+		for (size_t i = 0; i < n; ++i) s.push(ft::make_pair(long((i * 2654435761u) % n), long(i)));
+		ft::map<long, long> m;
+		m.assign_sorted(s.begin(), s.size());
+		bench::report("map from 2x the budget (sort + assign_sorted)", m.size(), t.ms());
+		sum += m.begin()->second;
+	}
+	bench::do_not_optimize(sum);
+	return 0;
+}
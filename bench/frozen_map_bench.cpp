@@ -0,0 +1,67 @@
+//	g++ -std=c++14 -O2 frozen_map_bench.cpp
+#include "bench.hpp"
+#include "../frozen_map.hpp"
+#include "../map.hpp"
+#include <vector>
+
+static const int	table_size = 1024;
+
+//	scrambled distinct keys, the way a hand written table comes
+constexpr ft::pair<int, int> entry(int i) { return ft::pair<int, int>((i * 7919) % 1048576, i); }
+
+constexpr ft::frozen_map<int, int, table_size> make_table() {
+	ft::pair<int, int>	raw[table_size] = {};
+	for (int i = 0; i < table_size; ++i) raw[i] = entry((i * 389) % table_size);
+	return ft::frozen_map<int, int, table_size>(raw);
+}
+
+//	sorted by the compiler : nothing left to do at startup
+constexpr ft::frozen_map<int, int, table_size>	table = make_table();
+
+static unsigned long long xorshift(unsigned long long& x) {
+	x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+	return x;
+}
+
+int main(int argc, char** argv) {
+	const size_t	builds = bench::arg(argc, argv, 1, 2000);
+	const size_t	lookups = bench::arg(argc, argv, 2, 20000000);
+	unsigned long long x = 88172645463325252ULL;
+	long			sum = 0;
+
+	std::vector<ft::pair<int, int> >	raw;
+	for (int i = 0; i < table_size; ++i) raw.push_back(entry((i * 389) % table_size));
+
+	std::cout << "startup, " << table_size << " entries, " << builds << " builds" << std::endl;
+	bench::timer t;
+	for (size_t b = 0; b < builds; ++b) {
+		ft::map<int, int>	m(raw.begin(), raw.end());
+		sum += long(m.size());
+	}
+	bench::report("  ft::map", builds, t.ms());
+	t.reset();
+	for (size_t b = 0; b < builds; ++b) {
+		ft::pair<int, int>	arr[table_size];
+		for (int i = 0; i < table_size; ++i) arr[i] = raw[i];
+		bench::do_not_optimize(arr);
+		const ft::frozen_map<int, int, table_size>	f(arr);
+		sum += f.begin()->second;
+	}
+	bench::report("  frozen_map sorted at runtime", builds, t.ms());
+	std::cout << "  frozen_map constexpr : constant initialized, no startup work" << std::endl;
+
+	ft::map<int, int>	m(raw.begin(), raw.end());
+	std::vector<int>	keys;
+	for (size_t i = 0; i < 4096; ++i) keys.push_back(raw[xorshift(x) % table_size].first);
+
+	std::cout << "lookups, " << lookups << " hits" << std::endl;
+	t.reset();
+	for (size_t i = 0; i < lookups; ++i) sum += m.find(keys[i & 4095])->second;
+	bench::report("  ft::map::find", lookups, t.ms());
+	t.reset();
+	for (size_t i = 0; i < lookups; ++i) sum += table.find(keys[i & 4095])->second;
+	bench::report("  frozen_map::find", lookups, t.ms());
+
+	bench::do_not_optimize(sum);
+	return 0;
+}
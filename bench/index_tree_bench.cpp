@@ -0,0 +1,52 @@
+#include "bench.hpp"
+#include "../index_tree.hpp"
+#include "../map.hpp"
+#include <malloc.h>
+#include <vector>
+
+//	bytes handed out by malloc, chunk overhead included
+static size_t heap_in_use() {
+	struct mallinfo2 mi = mallinfo2();
+	return mi.uordblks + mi.hblkhd;
+}
+
+template<typename Map>
+void run(const char* name, const std::vector<int>& keys) {
+	std::cout << name << std::endl;
+	const size_t before = heap_in_use();
+	long sum = 0;
+	{
+		Map m;
+		bench::timer t;
+		for (size_t i = 0; i < keys.size(); ++i) m.insert(ft::make_pair(keys[i], int(i)));
+		bench::report("  insert", m.size(), t.ms());
+		std::cout << "  heap " << double(heap_in_use() - before) / m.size() << " bytes / element" << std::endl;
+
+		t.reset();
+		for (size_t i = 0; i < keys.size(); ++i) sum += m.find(keys[i])->second;
+		bench::report("  find", keys.size(), t.ms());
+
+		t.reset();
+		for (typename Map::const_iterator it = m.begin(); it != m.end(); ++it) sum += it->second;
+		bench::report("  iterate", m.size(), t.ms());
+
+		t.reset();
+		Map copy(m);
+		bench::report("  copy", copy.size(), t.ms());
+		sum += copy.begin()->second;
+	}
+	bench::do_not_optimize(sum);
+}
+
+int main(int argc, char** argv) {
+	const size_t n = bench::arg(argc, argv, 1, 2000000);
+
+	std::vector<int> keys(n);
+	unsigned x = 35;
+	for (size_t i = 0; i < n; ++i) keys[i] = int((x = x * 1103515245u + 12345u) >> 1);
+
+	run<ft::map<int, int> >("ft::map<int, int>", keys);
+	run<ft::map<int, int, std::less<int>, std::allocator<ft::pair<const int, int> >, ft::index_tree> >(
+		"ft::map<int, int, ..., ft::index_tree>", keys);
+	return 0;
+}
@@ -0,0 +1,87 @@
+#include "bench.hpp"
+#include "../interval_map.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+typedef ft::interval_map<int, int>	imap;
+typedef imap::value_type			value_type;
+
+struct window
+{
+	int	lo, hi, id;
+	bool operator<(const window& rhs) const { return lo < rhs.lo || (lo == rhs.lo && hi < rhs.hi); }
+};
+
+struct window_values
+{
+	const window*	w;
+	value_type operator*() const { return value_type(ft::interval<int>(w->lo, w->hi), w->id); }
+	window_values& operator++() { ++w; return *this; }
+};
+
+//	counts matches instead of storing them
+struct counter
+{
+	size_t*	n;
+	counter& operator*() { return *this; }
+	counter& operator=(const imap::const_iterator&) { ++*n; return *this; }
+	counter& operator++() { return *this; }
+};
+
+static unsigned long long xorshift(unsigned long long& x) {
+	x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+	return x;
+}
+
+//	n windows over a span of 10 n, 20 long on average : about 2 match a point
+static void run(size_t n, size_t queries) {
+	unsigned long long	x = 88172645463325252ULL;
+	const int			span = int(n * 10);
+	std::vector<window>	w(n);
+	char				name[64];
+
+	for (size_t i = 0; i < n; ++i) {
+		w[i].lo = int(xorshift(x) % span);
+		w[i].hi = w[i].lo + 1 + int(xorshift(x) % 40);
+		w[i].id = int(i);
+	}
+	std::sort(w.begin(), w.end());
+
+	std::vector<int>	points(queries);
+	for (size_t q = 0; q < queries; ++q) points[q] = int(xorshift(x) % span);
+
+	std::cout << n << " intervals" << std::endl;
+	imap			m;
+	bench::timer	t;
+	window_values	first = { &w[0] };
+	m.assign_sorted(first, n);
+	bench::report("  assign_sorted", n, t.ms());
+
+	size_t	tree_hits = 0;
+	counter	out = { &tree_hits };
+	const imap&	cm = m;
+	t.reset();
+	for (size_t q = 0; q < queries; ++q) cm.overlapping(points[q], out);
+	bench::report("  interval_map stabbing", queries, t.ms());
+
+	//	a scan per point : a few points are enough to time it
+	const size_t	scans = queries < 20 ? queries : 20;
+	size_t			scan_hits = 0;
+	t.reset();
+	for (size_t q = 0; q < scans; ++q)
+		for (size_t i = 0; i < n; ++i)
+			scan_hits += w[i].lo <= points[q] && points[q] < w[i].hi;
+	std::snprintf(name, sizeof(name), "  linear scan stabbing");
+	bench::report(name, scans, t.ms());
+	bench::do_not_optimize(tree_hits + scan_hits);
+}
+
+int main(int argc, char** argv) {
+	const size_t	largest = bench::arg(argc, argv, 1, 50000000);
+	const size_t	queries = bench::arg(argc, argv, 2, 100000);
+
+	for (size_t n = 1000000; n <= largest; n = n < 10000000 ? n * 10 : n * 5)
+		run(n, queries);
+	return 0;
+}
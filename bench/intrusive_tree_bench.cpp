@@ -0,0 +1,73 @@
+#include "bench.hpp"
+#include "../intrusive_tree.hpp"
+#include "../map.hpp"
+#include <vector>
+
+//	objects already living in a slab, indexed by a key that keeps changing
+struct order
+{
+	long			price;
+	long			quantity;
+	ft::tree_node	hook;
+};
+
+struct price_of { const long& operator()(const order& o) const { return o.price; } };
+
+typedef ft::intrusive_tree<order, long, price_of, &order::hook>	intrusive_index;
+typedef ft::map<long, order*>									map_index;
+
+static unsigned long long xorshift(unsigned long long& x) {
+	x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+	return x;
+}
+
+int main(int argc, char** argv) {
+	const size_t	n = bench::arg(argc, argv, 1, 1000000);
+	const size_t	updates = bench::arg(argc, argv, 2, 5000000);
+	std::vector<order>	slab(n);
+	long			sum = 0;
+
+	{
+		unsigned long long x = 88172645463325252ULL;
+		for (size_t i = 0; i < n; ++i) slab[i].price = long(i * 7919 % n), slab[i].quantity = long(i);
+		std::cout << n << " objects, " << updates << " re-keys" << std::endl;
+
+		bench::timer	t;
+		map_index		m;
+		for (size_t i = 0; i < n; ++i) m.insert(ft::make_pair(slab[i].price, &slab[i]));
+		bench::report("  ft::map<K, T*> build", n, t.ms());
+		t.reset();
+		for (size_t u = 0; u < updates; ++u) {
+			order& o = slab[xorshift(x) % n];
+			m.erase(o.price);
+			o.price += long(n);
+			m.insert(ft::make_pair(o.price, &o));
+		}
+		bench::report("  ft::map<K, T*> erase + insert", updates, t.ms());
+		t.reset();
+		for (size_t i = 0; i < n; ++i) sum += m.find(slab[i].price)->second->quantity;
+		bench::report("  ft::map<K, T*> find", n, t.ms());
+	}
+	{
+		unsigned long long x = 88172645463325252ULL;
+		for (size_t i = 0; i < n; ++i) slab[i].price = long(i * 7919 % n);
+
+		bench::timer	t;
+		intrusive_index	m;
+		for (size_t i = 0; i < n; ++i) m.insert(slab[i]);
+		bench::report("  intrusive_tree build", n, t.ms());
+		t.reset();
+		for (size_t u = 0; u < updates; ++u) {
+			order& o = slab[xorshift(x) % n];
+			m.erase(o);
+			o.price += long(n);
+			m.insert(o);
+		}
+		bench::report("  intrusive_tree erase + insert", updates, t.ms());
+		t.reset();
+		for (size_t i = 0; i < n; ++i) sum += m.find(slab[i].price)->quantity;
+		bench::report("  intrusive_tree find", n, t.ms());
+	}
+	bench::do_not_optimize(sum);
+	return 0;
+}
@@ -0,0 +1,95 @@
+#include "bench.hpp"
+#include "../lru_cache.hpp"
+#include "../map.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <list>
+#include <vector>
+
+//	what the caches replace : a map plus a list, two allocations and two lookups per entry
+class map_list_cache
+{
+	typedef std::list<int>							order_type;
+	typedef ft::map<int, ft::pair<int, order_type::iterator> >	map_type;
+
+	size_t		cap;
+	order_type	order;
+	map_type	values;
+
+public:
+	explicit map_list_cache(size_t capacity) : cap(capacity) {}
+
+	int* get(int k) {
+		map_type::iterator it = values.find(k);
+		if (it == values.end()) return 0;
+		order.splice(order.begin(), order, it->second.second);
+		return &it->second.first;
+	}
+	void put(int k, int v) {
+		order.push_front(k);
+		values.insert(ft::make_pair(k, ft::make_pair(v, order.begin())));
+		if (values.size() > cap) {
+			values.erase(order.back());
+			order.pop_back();
+		}
+	}
+};
+
+static unsigned long long xorshift(unsigned long long& x) {
+	x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+	return x;
+}
+
+//	keys drawn with P(rank r) ~ 1 / r^s, scattered over the key space
+static std::vector<int> zipf_keys(size_t universe, size_t n, double s) {
+	std::vector<double>	cdf(universe);
+	double				total = 0;
+	for (size_t r = 0; r < universe; ++r) cdf[r] = total += 1.0 / std::pow(double(r + 1), s);
+
+	unsigned long long	x = 88172645463325252ULL;
+	std::vector<int>	keys(n);
+	for (size_t i = 0; i < n; ++i) {
+		const double u = double(xorshift(x) >> 11) / double(1ULL << 53) * total;
+		const size_t r = std::lower_bound(cdf.begin(), cdf.end(), u) - cdf.begin();
+		keys[i] = int((r * 2654435761ULL) % 1000000007ULL);
+	}
+	return keys;
+}
+
+//	get, put on a miss : the usual read through cache
+template<typename Cache>
+static void replay(const char* name, const std::vector<int>& keys, size_t capacity) {
+	Cache			c(capacity);
+	size_t			hits = 0;
+	bench::timer	t;
+	for (size_t i = 0; i < keys.size(); ++i) {
+		if (int* v = c.get(keys[i])) {
+			++hits;
+			++*v;
+		}
+		else c.put(keys[i], 1);
+	}
+	const double	ms = t.ms();
+	char			label[64];
+	std::snprintf(label, sizeof(label), "  %s (%.0f%% hits)", name, 100.0 * hits / keys.size());
+	bench::report(label, keys.size(), ms);
+}
+
+int main(int argc, char** argv) {
+	const size_t	universe = bench::arg(argc, argv, 1, 1000000);
+	const size_t	n = bench::arg(argc, argv, 2, 10000000);
+	static const double	skews[] = { 0.8, 0.99, 1.2 };
+
+	for (int s = 0; s < 3; ++s) {
+		const std::vector<int>	keys = zipf_keys(universe, n, skews[s]);
+		for (size_t capacity = universe / 100; capacity <= universe / 10; capacity *= 10) {
+			std::printf("zipf s = %.2f, %zu keys, capacity %zu\n", skews[s], universe, capacity);
+			std::fflush(stdout);
+			replay<map_list_cache>("ft::map + std::list", keys, capacity);
+			replay<ft::lru_cache<int, int> >("ft::lru_cache", keys, capacity);
+			replay<ft::ordered_lru_cache<int, int> >("ft::ordered_lru_cache", keys, capacity);
+		}
+	}
+	return 0;
+}
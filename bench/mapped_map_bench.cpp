@@ -0,0 +1,72 @@
+#include "bench.hpp"
+#include "../mapped_map.hpp"
+#include "../snapshot.hpp"
+#include <cstdio>
+
+static const char* path = "/tmp/ft_mapped_map_bench.bin";
+static const char* snap = "/tmp/ft_mapped_map_bench.snap";
+
+//	keys spread over the whole range, visited in a random order
+template<typename M>
+static long lookups(const M& m, size_t n, size_t queries) {
+	long		sum = 0;
+	uint64_t	x = 88172645463325252ULL;
+	for (size_t i = 0; i < queries; ++i) {
+		x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+		typename M::const_iterator it = m.find(int(x % n) * 3);
+		if (it != m.end()) sum += it->second;
+	}
+	return sum;
+}
+
+int main(int argc, char** argv) {
+	const size_t n = bench::arg(argc, argv, 1, 5000000);
+	const size_t queries = bench::arg(argc, argv, 2, 1000000);
+	long sum = 0;
+
+	std::remove(path);
+	{
+		bench::timer t;
+		ft::mapped_map<int, int> m(path);
+		for (size_t i = 0; i < n; ++i) m.insert(ft::make_pair(int(i * 3), int(i)));
+		m.sync();
+		bench::report("mapped_map build + sync", n, t.ms());
+	}
+	{
+		ft::map<int, int> m;
+		for (size_t i = 0; i < n; ++i) m.insert(m.end(), ft::make_pair(int(i * 3), int(i)));
+		ft::save(snap, m);
+	}
+
+	std::cout << "open, then " << queries << " lookups" << std::endl;
+	{
+		bench::timer t;
+		ft::mapped_map<int, int> m(path);
+		bench::report("  mapped_map open", m.size(), t.ms());
+		sum += lookups(m, n, 1);
+		bench::report("  mapped_map open + first lookup", 1, t.ms());
+		t.reset();
+		sum += lookups(m, n, queries);
+		bench::report("  mapped_map lookups", queries, t.ms());
+	}
+	{
+		//	the in memory alternatives : replay the inserts, or load a snapshot
+		bench::timer t;
+		ft::map<int, int> m;
+		for (size_t i = 0; i < n; ++i) m.insert(ft::make_pair(int(i * 3), int(i)));
+		bench::report("  ft::map rebuild by insert", m.size(), t.ms());
+		t.reset();
+		sum += lookups(m, n, queries);
+		bench::report("  ft::map lookups", queries, t.ms());
+	}
+	{
+		bench::timer t;
+		ft::map<int, int> m;
+		ft::load(snap, m);
+		bench::report("  ft::map snapshot load", m.size(), t.ms());
+	}
+	std::remove(path);
+	std::remove(snap);
+	bench::do_not_optimize(sum);
+	return 0;
+}
@@ -0,0 +1,84 @@
+#include "bench.hpp"
+#include "../memory_resource.hpp"
+#include <cstdio>
+
+static unsigned long long xorshift(unsigned long long& x) {
+	x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+	return x;
+}
+
+//	one request : a few dozen short lived vectors and maps, all dropped at the end
+template<typename Vector, typename Map>
+static long request(ft::pmr::memory_resource* res, unsigned long long& x) {
+	long	sum = 0;
+	for (int c = 0; c < 32; ++c) {
+		Vector	v(res);
+		Map		m(res);
+		const int	n = 16 + int(xorshift(x) % 64);
+		for (int i = 0; i < n; ++i) {
+			v.push_back(int(xorshift(x) % 1000));
+			m[int(xorshift(x) % 65536)] += i;
+		}
+		sum += long(v.size() + m.size()) + v.back() + m.begin()->second;
+	}
+	return sum;
+}
+
+struct plain_vector : public ft::vector<int>
+{
+	plain_vector(ft::pmr::memory_resource*) {}
+};
+struct plain_map : public ft::map<int, int>
+{
+	plain_map(ft::pmr::memory_resource*) {}
+};
+
+typedef ft::pmr::vector<int>		pmr_vector;
+typedef ft::pmr::map<int, int>		pmr_map;
+
+int main(int argc, char** argv) {
+	const size_t	n = bench::arg(argc, argv, 1, 20000);
+	long			sum = 0;
+	unsigned long long x;
+
+	std::cout << n << " requests, 32 vectors and maps each" << std::endl;
+
+	x = 88172645463325252ULL;
+	bench::timer t;
+	for (size_t r = 0; r < n; ++r) sum += request<plain_vector, plain_map>(0, x);
+	bench::report("  std::allocator", n, t.ms());
+
+	x = 88172645463325252ULL;
+	t.reset();
+	for (size_t r = 0; r < n; ++r) sum += request<pmr_vector, pmr_map>(ft::pmr::new_delete_resource(), x);
+	bench::report("  new_delete_resource", n, t.ms());
+
+	{
+		//	the arena outlives the requests, release() hands it back in one shot
+		static char		buf[1 << 16];
+		ft::pmr::monotonic_buffer_resource	arena(buf, sizeof(buf));
+		x = 88172645463325252ULL;
+		t.reset();
+		for (size_t r = 0; r < n; ++r) {
+			sum += request<pmr_vector, pmr_map>(&arena, x);
+			arena.release();
+		}
+		bench::report("  monotonic, release per request", n, t.ms());
+	}
+	{
+		ft::pmr::unsynchronized_pool_resource	pool;
+		x = 88172645463325252ULL;
+		t.reset();
+		for (size_t r = 0; r < n; ++r) sum += request<pmr_vector, pmr_map>(&pool, x);
+		bench::report("  unsynchronized_pool_resource", n, t.ms());
+	}
+	{
+		ft::pmr::synchronized_pool_resource	pool;
+		x = 88172645463325252ULL;
+		t.reset();
+		for (size_t r = 0; r < n; ++r) sum += request<pmr_vector, pmr_map>(&pool, x);
+		bench::report("  synchronized_pool_resource", n, t.ms());
+	}
+	bench::do_not_optimize(sum);
+	return 0;
+}
@@ -0,0 +1,47 @@
+//	g++ -std=c++11 -O2 node_bench.cpp [-DFT_RBTREE_COMPACT]
+#include "bench.hpp"
+#include "../map.hpp"
+#include <cstdio>
+#include <vector>
+
+//	resident set size in bytes
+static size_t rss() {
+	long pages = 0, resident = 0;
+	FILE* f = std::fopen("/proc/self/statm", "r");
+	if (f == 0) return 0;
+	if (std::fscanf(f, "%ld %ld", &pages, &resident) != 2) resident = 0;
+	std::fclose(f);
+	return size_t(resident) * 4096;
+}
+
+int main(int argc, char** argv) {
+	const size_t n = bench::arg(argc, argv, 1, 10000000);
+
+	std::vector<int> keys(n);
+	unsigned x = 34;
+	for (size_t i = 0; i < n; ++i) keys[i] = int((x = x * 1103515245u + 12345u) >> 1);
+
+#ifdef FT_RBTREE_COMPACT
+	std::cout << "ft::map<int, int> (compact nodes)" << std::endl;
+#else
+	std::cout << "ft::map<int, int>" << std::endl;
+#endif
+	const size_t before = rss();
+	ft::map<int, int> m;
+	bench::timer t;
+	for (size_t i = 0; i < n; ++i) m.insert(ft::make_pair(keys[i], int(i)));
+	bench::report("  insert", m.size(), t.ms());
+	std::cout << "  node " << sizeof(ft::rb_node<ft::pair<const int, int> >) << " bytes, resident "
+			  << double(rss() - before) / m.size() << " bytes / element" << std::endl;
+
+	long sum = 0;
+	t.reset();
+	for (size_t i = 0; i < n; ++i) sum += m.find(keys[i])->second;
+	bench::report("  find", n, t.ms());
+
+	t.reset();
+	for (ft::map<int, int>::const_iterator it = m.begin(); it != m.end(); ++it) sum += it->second;
+	bench::report("  iterate", m.size(), t.ms());
+	bench::do_not_optimize(sum);
+	return 0;
+}
@@ -0,0 +1,67 @@
+#include "bench.hpp"
+#include "../execution.hpp"
+#include "../vector.hpp"
+#include "../pair.hpp"
+#include <algorithm>
+#include <thread>
+
+typedef ft::pair<int, ft::pair<int, int> >	conn;
+
+struct square
+{
+	double operator()(int x) const { return double(x) * x; }
+};
+
+int main(int argc, char** argv) {
+	const size_t n = bench::arg(argc, argv, 1, 10000000);
+	const unsigned max_threads = bench::arg(argc, argv, 2, std::max(1u, std::thread::hardware_concurrency()));
+
+	ft::vector<int> src(n);
+	ft::vector<conn> csrc(n);
+	for (size_t i = 0; i < n; i++) {
+		src[i] = rand();
+		csrc[i] = conn(rand(), ft::make_pair(rand(), rand()));
+	}
+	std::cout << "elements: " << n << std::endl;
+	{
+		ft::vector<int> v = src;
+		bench::timer t;
+		std::sort(v.begin(), v.end());
+		bench::report("std::sort int", n, t.ms());
+		ft::vector<conn> c = csrc;
+		t.reset();
+		std::sort(c.begin(), c.end());
+		bench::report("std::sort conn", n, t.ms());
+	}
+	for (unsigned threads = 1; threads <= max_threads; threads *= 2) {
+		ft::thread_pool pool(threads);
+		ft::execution::parallel_policy policy = ft::execution::par.on(pool);
+		std::cout << "threads: " << threads << std::endl;
+
+		ft::vector<int> v = src;
+		bench::timer t;
+		ft::sort(policy, v.begin(), v.end());
+		bench::report("  ft::sort int", n, t.ms());
+
+		ft::vector<conn> c = csrc;
+		t.reset();
+		ft::sort(policy, c.begin(), c.end());
+		bench::report("  ft::sort conn", n, t.ms());
+
+		c = csrc;
+		t.reset();
+		ft::stable_sort(policy, c.begin(), c.end());
+		bench::report("  ft::stable_sort conn", n, t.ms());
+
+		ft::vector<double> out(n);
+		t.reset();
+		ft::transform(policy, src.begin(), src.end(), out.begin(), square());
+		bench::report("  ft::transform", n, t.ms());
+
+		t.reset();
+		bench::do_not_optimize(ft::reduce(policy, out.begin(), out.end(), 0.0));
+		bench::report("  ft::reduce", n, t.ms());
+		if (threads < max_threads && threads * 2 > max_threads) threads = max_threads / 2;
+	}
+	return 0;
+}
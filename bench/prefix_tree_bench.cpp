@@ -0,0 +1,54 @@
+#include "bench.hpp"
+#include "../map.hpp"
+#include <cstdio>
+#include <string>
+#include <vector>
+
+typedef ft::map<std::string, long>	plain_map;
+typedef ft::map<std::string, long, std::less<std::string>,
+	std::allocator<ft::pair<const std::string, long> >, ft::prefix_tree>	cached_map;
+
+template<typename M>
+static long lookups(const char* name, const std::vector<std::string>& keys, const std::vector<std::string>& probes) {
+	M m;
+	for (size_t i = 0; i < keys.size(); ++i) m.insert(ft::make_pair(keys[i], long(i)));
+	long sum = 0;
+	bench::timer t;
+	for (size_t i = 0; i < probes.size(); ++i) {
+		typename M::const_iterator it = m.find(probes[i]);
+		if (it != m.end()) sum += it->second;
+	}
+	bench::report(name, probes.size(), t.ms());
+	return sum;
+}
+
+static unsigned long long xorshift(unsigned long long& x) {
+	x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+	return x;
+}
+
+int main(int argc, char** argv) {
+	const size_t n = bench::arg(argc, argv, 1, 1000000);
+	unsigned long long x = 88172645463325252ULL;
+	long sum = 0;
+
+	//	random : the first 8 bytes nearly always decide
+	//	common prefix : 5 shared bytes, the cache still splits the next 3
+	//	long prefix : 24 shared bytes, every step ties and falls back
+	static const char* const shapes[] = { "", "user:", "https://example.com/item" };
+	static const char* const names[] = { "random keys", "common prefix (5 bytes)", "long prefix (24 bytes)" };
+	for (int s = 0; s < 3; ++s) {
+		std::vector<std::string> keys(n), probes(n);
+		for (size_t i = 0; i < n; ++i) {
+			char buf[64];
+			std::snprintf(buf, sizeof(buf), "%s%016llx", shapes[s], xorshift(x));
+			keys[i] = buf;
+		}
+		for (size_t i = 0; i < n; ++i) probes[i] = keys[xorshift(x) % n];
+		std::cout << names[s] << ", " << n << " keys" << std::endl;
+		sum += lookups<plain_map>("  ft::map find", keys, probes);
+		sum += lookups<cached_map>("  ft::map<..., prefix_tree> find", keys, probes);
+	}
+	bench::do_not_optimize(sum);
+	return 0;
+}
@@ -0,0 +1,59 @@
+#include "bench.hpp"
+#include "../queue.hpp"
+#include <queue>
+#include <vector>
+
+typedef ft::vector<int, ft::cache_aligned_allocator<int> >	aligned;
+
+template<typename PQ>
+void run(const char* name, size_t n) {
+	std::vector<int> keys(n);
+	for (size_t i = 0; i < n; i++) keys[i] = rand();
+
+	PQ pq;
+	bench::timer t;
+	for (size_t i = 0; i < n; i++) pq.push(keys[i]);
+	for (size_t i = 0; i < n; i++) pq.pop();
+	const double push_pop = t.ms();
+
+	for (size_t i = 0; i < n / 4; i++) pq.push(keys[i]);
+	t.reset();
+	for (size_t i = 0; i < n; i++) {
+		int v = pq.top() - keys[i] % 1024;
+		pq.pop();
+		pq.push(v);
+	}
+	const double pop_then_push = t.ms();
+
+	std::cout << name << std::endl;
+	bench::report("  push n + pop n", n, push_pop);
+	bench::report("  pop + push", n, pop_then_push);
+}
+
+template<typename PQ>
+void run_ft(const char* name, size_t n) {
+	run<PQ>(name, n);
+
+	std::vector<int> keys(n);
+	for (size_t i = 0; i < n; i++) keys[i] = rand();
+	PQ pq;
+	for (size_t i = 0; i < n / 4; i++) pq.push(keys[i]);
+	bench::timer t;
+	for (size_t i = 0; i < n; i++) pq.pop_push(pq.top() - keys[i] % 1024);
+	bench::report("  pop_push", n, t.ms());
+
+	PQ bulk;
+	t.reset();
+	bulk.push_range(keys.begin(), keys.end());
+	bench::report("  push_range", n, t.ms());
+}
+
+int main(int argc, char** argv) {
+	const size_t n = bench::arg(argc, argv, 1, 1000000);
+
+	run<std::priority_queue<int> >("std::priority_queue<int>", n);
+	run_ft<ft::priority_queue<int, aligned, ft::less<int>, 2> >("ft::priority_queue<int> D=2", n);
+	run_ft<ft::priority_queue<int, aligned, ft::less<int>, 4> >("ft::priority_queue<int> D=4", n);
+	run_ft<ft::priority_queue<int, aligned, ft::less<int>, 8> >("ft::priority_queue<int> D=8", n);
+	return 0;
+}
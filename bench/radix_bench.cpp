@@ -0,0 +1,44 @@
+#include "bench.hpp"
+#include "../radix_sort.hpp"
+#include "../vector.hpp"
+#include "../pair.hpp"
+#include <algorithm>
+
+typedef ft::pair<int, ft::pair<int, int> >	conn;
+
+struct by_first
+{
+	bool operator()(const conn& lhs, const conn& rhs) const { return lhs.first < rhs.first; }
+};
+
+int main(int argc, char** argv) {
+	const size_t max_n = bench::arg(argc, argv, 1, 10000000);
+
+	for (size_t n = 1000; n <= max_n; n *= 10) {
+		ft::vector<int> src(n);
+		ft::vector<conn> csrc(n);
+		for (size_t i = 0; i < n; i++) {
+			src[i] = rand() - RAND_MAX / 2;
+			csrc[i] = conn(rand(), ft::make_pair(int(i), rand()));
+		}
+
+		ft::vector<int> v = src;
+		bench::timer t;
+		std::sort(v.begin(), v.end());
+		bench::report("std::sort int", n, t.ms());
+		v = src;
+		t.reset();
+		ft::radix_sort(v);
+		bench::report("ft::radix_sort int", n, t.ms());
+
+		ft::vector<conn> c = csrc;
+		t.reset();
+		std::sort(c.begin(), c.end(), by_first());
+		bench::report("std::sort conn by first", n, t.ms());
+		c = csrc;
+		t.reset();
+		ft::radix_sort(c);
+		bench::report("ft::radix_sort conn", n, t.ms());
+	}
+	return 0;
+}
@@ -0,0 +1,67 @@
+#include "bench.hpp"
+#include "../radix_map.hpp"
+#include "../map.hpp"
+#include <cstdio>
+#include <string>
+#include <vector>
+
+template<typename M, typename K>
+static long run(const char* name, const std::vector<K>& keys, const std::vector<K>& probes) {
+	char label[64];
+	long sum = 0;
+	bench::timer t;
+	M m;
+	for (size_t i = 0; i < keys.size(); ++i) m.insert(ft::make_pair(keys[i], long(i)));
+	std::snprintf(label, sizeof(label), "  %s insert", name);
+	bench::report(label, keys.size(), t.ms());
+
+	t.reset();
+	for (size_t i = 0; i < probes.size(); ++i) {
+		typename M::const_iterator it = m.find(probes[i]);
+		if (it != m.end()) sum += it->second;
+	}
+	std::snprintf(label, sizeof(label), "  %s find", name);
+	bench::report(label, probes.size(), t.ms());
+
+	t.reset();
+	for (typename M::const_iterator it = m.begin(); it != m.end(); ++it) sum += it->second;
+	std::snprintf(label, sizeof(label), "  %s ordered scan", name);
+	bench::report(label, m.size(), t.ms());
+	return sum;
+}
+
+static unsigned long long xorshift(unsigned long long& x) {
+	x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+	return x;
+}
+
+int main(int argc, char** argv) {
+	const size_t n = bench::arg(argc, argv, 1, 2000000);
+	unsigned long long x = 88172645463325252ULL;
+	long sum = 0;
+
+	{
+		std::vector<unsigned long> keys(n), probes(n);
+		for (size_t i = 0; i < n; ++i) keys[i] = xorshift(x);
+		for (size_t i = 0; i < n; ++i) probes[i] = keys[xorshift(x) % n];
+		std::cout << "uint64 keys" << std::endl;
+		sum += run<ft::map<unsigned long, long> >("ft::map      ", keys, probes);
+		sum += run<ft::radix_map<unsigned long, long> >("ft::radix_map", keys, probes);
+	}
+	{
+		//	url like keys : long shared prefixes, then a random tail
+		static const char* hosts[] = { "https://example.com/users/", "https://example.com/items/", "https://cdn.example.org/" };
+		std::vector<std::string> keys(n), probes(n);
+		for (size_t i = 0; i < n; ++i) {
+			char tail[32];
+			std::snprintf(tail, sizeof(tail), "%llx/profile", xorshift(x) % 100000000000ULL);
+			keys[i] = std::string(hosts[i % 3]) + tail;
+		}
+		for (size_t i = 0; i < n; ++i) probes[i] = keys[xorshift(x) % n];
+		std::cout << "string keys" << std::endl;
+		sum += run<ft::map<std::string, long> >("ft::map      ", keys, probes);
+		sum += run<ft::radix_map<std::string, long> >("ft::radix_map", keys, probes);
+	}
+	bench::do_not_optimize(sum);
+	return 0;
+}
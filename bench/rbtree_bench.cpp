@@ -0,0 +1,47 @@
+//	g++ -std=c++11 -O2 rbtree_bench.cpp [-DFT_RBTREE_THREADED]
+#include "bench.hpp"
+#include "../map.hpp"
+#include <map>
+#include <vector>
+
+template<typename Map>
+void run(const char* name, const std::vector<int>& keys, size_t scans) {
+	Map m;
+	for (size_t i = 0; i < keys.size(); ++i) m[keys[i]] = int(i);
+	std::cout << name << std::endl;
+
+	long sum = 0;
+	bench::timer t;
+	for (typename Map::const_iterator it = m.begin(); it != m.end(); ++it) sum += it->second;
+	bench::report("  forward scan", m.size(), t.ms());
+
+	t.reset();
+	for (typename Map::const_iterator it = m.end(); it != m.begin(); ) sum += (--it)->second;
+	bench::report("  backward scan", m.size(), t.ms());
+
+	//	lower_bound then 100 steps
+	t.reset();
+	for (size_t i = 0; i < scans; ++i) {
+		typename Map::const_iterator it = m.lower_bound(keys[i % keys.size()]);
+		for (int step = 0; step < 100 && it != m.end(); ++step, ++it) sum += it->first;
+	}
+	bench::report("  range scans x100", scans, t.ms());
+	bench::do_not_optimize(sum);
+}
+
+int main(int argc, char** argv) {
+	const size_t n = bench::arg(argc, argv, 1, 2000000);
+	const size_t scans = bench::arg(argc, argv, 2, 200000);
+
+	std::vector<int> keys(n);
+	unsigned x = 7;
+	for (size_t i = 0; i < n; ++i) keys[i] = int((x = x * 1103515245u + 12345u) >> 1);
+
+#ifdef FT_RBTREE_THREADED
+	run<ft::map<int, int> >("ft::map<int, int> (threaded)", keys, scans);
+#else
+	run<ft::map<int, int> >("ft::map<int, int>", keys, scans);
+#endif
+	run<std::map<int, int> >("std::map<int, int>", keys, scans);
+	return 0;
+}
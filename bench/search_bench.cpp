@@ -0,0 +1,66 @@
+#include "bench.hpp"
+#include "../vector.hpp"
+#include <algorithm>
+#include <numeric>
+
+template<typename T>
+void report_gbs(const char* name, size_t n, size_t rounds, double ms) {
+	const double gb = double(n) * sizeof(T) * rounds / 1e9;
+	std::cout << std::left << std::setw(32) << name
+			  << std::right << std::setw(10) << std::fixed << std::setprecision(2)
+			  << gb / (ms / 1000.0) << " GB/s" << std::endl;
+}
+
+template<typename T>
+void run(const char* type, size_t n, size_t rounds) {
+	ft::vector<T> v(n);
+	for (size_t i = 0; i < n; i++) v[i] = T(i % 1000);
+	const T missing = T(-1);
+	std::string prefix = std::string(type) + " ";
+	bench::timer t;
+
+	t.reset();
+	for (size_t r = 0; r < rounds; r++) bench::do_not_optimize(ft::find(v.begin(), v.end(), missing));
+	report_gbs<T>((prefix + "ft::find").c_str(), n, rounds, t.ms());
+	t.reset();
+	for (size_t r = 0; r < rounds; r++) bench::do_not_optimize(std::find(v.data(), v.data() + n, missing));
+	report_gbs<T>((prefix + "std::find").c_str(), n, rounds, t.ms());
+
+	t.reset();
+	for (size_t r = 0; r < rounds; r++) bench::do_not_optimize(ft::count(v.begin(), v.end(), T(7)));
+	report_gbs<T>((prefix + "ft::count").c_str(), n, rounds, t.ms());
+	t.reset();
+	for (size_t r = 0; r < rounds; r++) bench::do_not_optimize(std::count(v.data(), v.data() + n, T(7)));
+	report_gbs<T>((prefix + "std::count").c_str(), n, rounds, t.ms());
+
+	t.reset();
+	for (size_t r = 0; r < rounds; r++) bench::do_not_optimize(ft::min_element(v.begin(), v.end()));
+	report_gbs<T>((prefix + "ft::min_element").c_str(), n, rounds, t.ms());
+	t.reset();
+	for (size_t r = 0; r < rounds; r++) bench::do_not_optimize(std::min_element(v.data(), v.data() + n));
+	report_gbs<T>((prefix + "std::min_element").c_str(), n, rounds, t.ms());
+
+	t.reset();
+	for (size_t r = 0; r < rounds; r++) bench::do_not_optimize(ft::max_element(v.begin(), v.end()));
+	report_gbs<T>((prefix + "ft::max_element").c_str(), n, rounds, t.ms());
+	t.reset();
+	for (size_t r = 0; r < rounds; r++) bench::do_not_optimize(std::max_element(v.data(), v.data() + n));
+	report_gbs<T>((prefix + "std::max_element").c_str(), n, rounds, t.ms());
+
+	t.reset();
+	for (size_t r = 0; r < rounds; r++) bench::do_not_optimize(ft::accumulate(v.begin(), v.end(), T()));
+	report_gbs<T>((prefix + "ft::accumulate").c_str(), n, rounds, t.ms());
+	t.reset();
+	for (size_t r = 0; r < rounds; r++) bench::do_not_optimize(std::accumulate(v.data(), v.data() + n, T()));
+	report_gbs<T>((prefix + "std::accumulate").c_str(), n, rounds, t.ms());
+}
+
+int main(int argc, char** argv) {
+	const size_t n = bench::arg(argc, argv, 1, 1 << 20);
+	const size_t rounds = bench::arg(argc, argv, 2, 200);
+
+	std::cout << "elements: " << n << ", rounds: " << rounds << std::endl;
+	run<int>("int", n, rounds);
+	run<float>("float", n, rounds);
+	return 0;
+}
@@ -0,0 +1,60 @@
+#include "bench.hpp"
+#include "../snapshot.hpp"
+#include <cstdio>
+
+static const char* path = "/tmp/ft_snapshot_bench.bin";
+
+static void report_rate(const char* name, size_t n, size_t bytes, double ms) {
+	bench::report(name, n, ms);
+	std::cout << "    " << bytes / ms / 1e6 << " GB/s" << std::endl;
+}
+
+int main(int argc, char** argv) {
+	const size_t n_vec = bench::arg(argc, argv, 1, 100000000);
+	const size_t n_map = bench::arg(argc, argv, 2, 20000000);
+	long sum = 0;
+
+	{
+		std::cout << "ft::vector<long>" << std::endl;
+		ft::vector<long> v;
+		v.reserve(n_vec);
+		for (size_t i = 0; i < n_vec; ++i) v.push_back(long(i * 2654435761u));
+		bench::timer t;
+		ft::save(path, v);
+		report_rate("  save", n_vec, n_vec * sizeof(long), t.ms());
+		ft::vector<long> back;
+		t.reset();
+		ft::load(path, back);
+		report_rate("  load", back.size(), n_vec * sizeof(long), t.ms());
+		sum += back[n_vec / 2];
+	}
+	{
+		std::cout << "ft::map<int, int>" << std::endl;
+		ft::vector<ft::pair<int, int> > sorted;
+		sorted.reserve(n_map);
+		for (size_t i = 0; i < n_map; ++i) sorted.push_back(ft::make_pair(int(i * 3), int(i)));
+		ft::map<int, int> m;
+		m.assign_sorted(sorted.begin(), sorted.size());
+
+		bench::timer t;
+		ft::save(path, m);
+		report_rate("  save", m.size(), m.size() * sizeof(ft::pair<int, int>), t.ms());
+		ft::map<int, int>().swap(m);
+
+		t.reset();
+		ft::map<int, int> back;
+		ft::load(path, back);
+		report_rate("  load (linear build)", back.size(), back.size() * sizeof(ft::pair<int, int>), t.ms());
+		sum += back.begin()->second;
+
+		//	the old way : one insert per element
+		t.reset();
+		ft::map<int, int> rebuilt;
+		for (size_t i = 0; i < sorted.size(); ++i) rebuilt.insert(rebuilt.end(), sorted[i]);
+		bench::report("  rebuild by insert (in memory)", rebuilt.size(), t.ms());
+		sum += rebuilt.size();
+	}
+	std::remove(path);
+	bench::do_not_optimize(sum);
+	return 0;
+}
@@ -0,0 +1,71 @@
+#include "bench.hpp"
+#include "../thread_cache_allocator.hpp"
+#include "../map.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+typedef ft::map<int, int>	plain_map;
+typedef ft::map<int, int, std::less<int>, ft::thread_cache_allocator<ft::pair<const int, int> > >	cached_map;
+
+static unsigned long long xorshift(unsigned long long& x) {
+	x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+	return x;
+}
+
+//	every thread builds short lived maps, churning inserts and erases on each
+template<typename Map>
+static double run(int threads, size_t per_thread) {
+	std::vector<std::thread>	pool;
+	std::vector<long>			sums(threads);
+
+	bench::timer t;
+	for (int i = 0; i < threads; ++i)
+		pool.push_back(std::thread([i, per_thread, &sums] {
+			unsigned long long	x = 88172645463325252ULL + i;
+			long				sum = 0;
+			for (size_t done = 0; done < per_thread; ) {
+				Map	m;
+				for (int k = 0; k < 4096; ++k, ++done) {
+					const int	key = int(xorshift(x) % 2048);
+					if (k & 1) m.erase(key);
+					else m[key] = k;
+				}
+				sum += long(m.size());
+			}
+			sums[i] = sum;
+		}));
+	for (size_t i = 0; i < pool.size(); ++i) pool[i].join();
+	const double	ms = t.ms();
+	bench::do_not_optimize(sums);
+	return ms;
+}
+
+int main(int argc, char** argv) {
+	const size_t	per_thread = bench::arg(argc, argv, 1, 2000000);
+	const int		max_threads = int(bench::arg(argc, argv, 2, 32));
+
+	std::cout << "insert / erase churn, " << per_thread << " ops per thread, "
+			  << std::thread::hardware_concurrency() << " hardware threads" << std::endl;
+	//	first touch of the heap (and of the malloc arenas per thread) off the clock
+	run<plain_map>(max_threads, per_thread / 4);
+	run<cached_map>(max_threads, per_thread / 4);
+	for (int threads = 1; threads <= max_threads; threads *= 2) {
+		char	name[64];
+		const size_t	ops = per_thread * threads;
+		double			plain = 1e300;
+		double			cached = 1e300;
+
+		//	alternated, best of three : keeps a noisy machine from favouring either
+		for (int rep = 0; rep < 3; ++rep) {
+			plain = std::min(plain, run<plain_map>(threads, per_thread));
+			cached = std::min(cached, run<cached_map>(threads, per_thread));
+		}
+		std::snprintf(name, sizeof(name), "  %d threads, std::allocator", threads);
+		bench::report(name, ops, plain);
+		std::snprintf(name, sizeof(name), "  %d threads, thread_cache_allocator", threads);
+		bench::report(name, ops, cached);
+	}
+	return 0;
+}
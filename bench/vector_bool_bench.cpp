@@ -0,0 +1,68 @@
+#include "bench.hpp"
+#include "../vector.hpp"
+#include <cstdio>
+
+typedef ft::vector<unsigned char>	byte_flags;
+typedef ft::vector<bool>			bit_flags;
+
+static unsigned long long xorshift(unsigned long long& x) {
+	x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+	return x;
+}
+
+int main(int argc, char** argv) {
+	const size_t	n = bench::arg(argc, argv, 1, 256 * 1024 * 1024);
+	const size_t	sparse = bench::arg(argc, argv, 2, 1000);	//	one flag in sparse is set
+	unsigned long long x = 88172645463325252ULL;
+	size_t			sum = 0;
+
+	byte_flags	bytes(n, 0);
+	byte_flags	bytes2(n, 0);
+	bit_flags	bits(n, false);
+	bit_flags	bits2(n, false);
+	for (size_t i = 0; i < n / sparse; ++i) {
+		const size_t	k = size_t(xorshift(x) % n);
+		bytes[k] = 1;
+		bits[k] = true;
+		const size_t	j = size_t(xorshift(x) % n);
+		bytes2[j] = 1;
+		bits2[j] = true;
+	}
+
+	std::cout << n << " flags, one in " << sparse << " set" << std::endl;
+	std::printf("  memory : byte per flag %zu MB, packed %zu MB\n",
+				bytes.capacity() >> 20, (bits.capacity() / 8) >> 20);
+
+	bench::timer t;
+	for (size_t i = 0; i < n; ++i) sum += bytes[i];
+	bench::report("  count, byte per flag", n, t.ms());
+	t.reset();
+	sum += bits.count();
+	bench::report("  count, packed", n, t.ms());
+
+	t.reset();
+	for (size_t i = 0; i < n; ++i) if (bytes[i]) sum += i;
+	bench::report("  walk set flags, byte per flag", n, t.ms());
+	t.reset();
+	for (size_t i = bits.find_first(); i != bits.npos; i = bits.find_next(i)) sum += i;
+	bench::report("  walk set flags, find_next", n, t.ms());
+
+	t.reset();
+	for (size_t i = 0; i < n; ++i) bytes[i] &= bytes2[i];
+	bench::report("  and, byte per flag", n, t.ms());
+	t.reset();
+	bits &= bits2;
+	bench::report("  and, packed", n, t.ms());
+
+	t.reset();
+	for (size_t i = 0; i < n; ++i) bytes[i] = 1;
+	bench::report("  set all, byte per flag", n, t.ms());
+	t.reset();
+	bits.set(0, n);
+	bench::report("  set all, packed", n, t.ms());
+
+	bench::do_not_optimize(sum);
+	bench::do_not_optimize(bytes[n / 2]);
+	bench::do_not_optimize(bits.count());
+	return 0;
+}
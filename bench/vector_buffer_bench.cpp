@@ -0,0 +1,66 @@
+#include "bench.hpp"
+#include "../vector.hpp"
+#include <cstdio>
+#include <cstring>
+
+//	stands in for read(2) from a socket or a cached file : one copy into the buffer
+struct reader
+{
+	const char*	src;
+
+	size_t operator()(char* dst, size_t n) const {
+		std::memcpy(dst, src, n);
+		return n;
+	}
+};
+
+enum mode { RESIZE, DEFAULT_INIT, APPEND };
+
+//	reps reads of n bytes, into a new vector each time or into one reused buffer
+static double run(mode m, bool fresh, const char* src, size_t n, size_t reps) {
+	ft::vector<char>	kept;
+	size_t				sum = 0;
+	const reader		r = { src };
+	bench::timer		t;
+
+	for (size_t i = 0; i < reps; ++i) {
+		ft::vector<char>	local;
+		ft::vector<char>&	v = fresh ? local : kept;
+
+		v.clear();
+		if (m == APPEND) v.append_uninitialized(n, r);
+		else {
+			if (m == RESIZE) v.resize(n);
+			else v.resize_default_init(n);
+			r(v.data(), n);
+		}
+		sum += size_t(v[n / 2]);
+	}
+	bench::do_not_optimize(sum);
+	return t.ms();
+}
+
+int main(int argc, char** argv) {
+	const size_t	largest = bench::arg(argc, argv, 1, size_t(1) << 30);
+	const size_t	volume = bench::arg(argc, argv, 2, size_t(4) << 30);	//	bytes read per case
+	char* const		src = new char[largest];
+
+	std::memset(src, 'a', largest);
+	for (size_t n = 1024; n <= largest; n *= 32) {
+		const size_t	reps = volume / n ? volume / n : 1;
+		char			name[64];
+
+		for (int fresh = 1; fresh >= 0; --fresh) {
+			std::printf("%zu bytes, %s buffer\n", n, fresh ? "new" : "reused");
+			std::fflush(stdout);
+			std::snprintf(name, sizeof(name), "  resize + read");
+			bench::report(name, reps, run(RESIZE, fresh, src, n, reps));
+			std::snprintf(name, sizeof(name), "  resize_default_init + read");
+			bench::report(name, reps, run(DEFAULT_INIT, fresh, src, n, reps));
+			std::snprintf(name, sizeof(name), "  append_uninitialized(read)");
+			bench::report(name, reps, run(APPEND, fresh, src, n, reps));
+		}
+	}
+	delete[] src;
+	return 0;
+}
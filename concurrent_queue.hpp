@@ -0,0 +1,153 @@
+#ifndef CONCURRENT_QUEUE_HPP
+# define CONCURRENT_QUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <thread>
+
+namespace ft
+{
+
+/*
+ *	Concurrent Queue : bounded multi producer / multi consumer ring.
+ *	Each cell carries a sequence number telling whose turn it is :
+ *	seq == pos		free for the producer that claimed pos
+ *	seq == pos + 1	filled, for the consumer that claimed pos
+ *	Producers and consumers only contend on their own cursor.
+ *	A claimed cell is always handed on : a push whose copy throws publishes an
+ *	empty cell that consumers skip, a pop whose assignment throws drops the
+ *	element. Either way the exception reaches the caller and the ring keeps moving.
+ */
+template<typename T, typename Alloc = std::allocator<T> >
+class concurrent_queue
+{
+public:
+	typedef T				value_type;
+	typedef std::size_t		size_type;
+	typedef Alloc			allocator_type;
+
+private:
+	struct cell
+	{
+		std::atomic<size_type>		seq;
+		bool						live;		//	false : a failed push, nothing to read
+		alignas(T) unsigned char	storage[sizeof(T)];
+
+		T* value() { return reinterpret_cast<T*>(storage); }
+	};
+
+	typedef typename Alloc::template rebind<cell>::other	cell_allocator;
+
+	static const size_type	cache_line = 64;
+
+	cell_allocator	alloc;
+	cell*			buffer;
+	size_type		mask;
+	alignas(cache_line) std::atomic<size_type>	enqueue_pos;
+	alignas(cache_line) std::atomic<size_type>	dequeue_pos;
+	char			pad[cache_line - sizeof(std::atomic<size_type>)];
+
+	concurrent_queue(const concurrent_queue&);
+	concurrent_queue& operator=(const concurrent_queue&);
+
+	//	the cell goes back to the producers, one lap later
+	void release(cell* c, size_type pos) { c->seq.store(pos + mask + 1, std::memory_order_release); }
+
+	cell* claim(std::atomic<size_type>& cursor, size_type turn, size_type& pos) {
+		pos = cursor.load(std::memory_order_relaxed);
+		for (;;) {
+			cell* c = &buffer[pos & mask];
+			const std::ptrdiff_t diff = std::ptrdiff_t(c->seq.load(std::memory_order_acquire))
+				- std::ptrdiff_t(pos + turn);
+			if (diff == 0) {
+				if (cursor.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) return c;
+			}
+			else if (diff < 0) return 0;
+			else pos = cursor.load(std::memory_order_relaxed);
+		}
+	}
+
+public:
+	//	capacity is rounded up to a power of two
+	explicit concurrent_queue(size_type capacity, const allocator_type& a = allocator_type())
+	: alloc(a), buffer(0), mask(0), enqueue_pos(0), dequeue_pos(0) {
+		size_type cap = 2;
+		while (cap < capacity) cap <<= 1;
+		mask = cap - 1;
+		buffer = alloc.allocate(cap);
+		for (size_type i = 0; i < cap; ++i)
+			::new (static_cast<void*>(&buffer[i].seq)) std::atomic<size_type>(i);
+	}
+
+	//	not thread safe : no other thread may use the queue any more
+	~concurrent_queue() {
+		while (!empty()) pop();
+		alloc.deallocate(buffer, mask + 1);
+	}
+
+	bool try_push(const value_type& value) {
+		size_type pos;
+		cell* c = claim(enqueue_pos, 0, pos);
+		if (c == 0) return false;
+		c->live = false;
+		try {
+			::new (static_cast<void*>(c->storage)) T(value);
+			c->live = true;
+		}
+		catch (...) {
+			c->seq.store(pos + 1, std::memory_order_release);
+			throw ;
+		}
+		c->seq.store(pos + 1, std::memory_order_release);
+		return true;
+	}
+
+	//	waits while the queue is full
+	void push(const value_type& value) {
+		while (!try_push(value)) std::this_thread::yield();
+	}
+
+	bool try_pop(value_type& out) {
+		size_type pos;
+		cell* c;
+		while ((c = claim(dequeue_pos, 1, pos)) != 0 && !c->live) release(c, pos);
+		if (c == 0) return false;
+		try {
+			out = *c->value();
+		}
+		catch (...) {
+			c->value()->~T();
+			release(c, pos);
+			throw ;
+		}
+		c->value()->~T();
+		release(c, pos);
+		return true;
+	}
+
+	//	drops the front element, if any
+	void pop() {
+		size_type pos;
+		cell* c;
+		while ((c = claim(dequeue_pos, 1, pos)) != 0 && !c->live) release(c, pos);
+		if (c == 0) return ;
+		c->value()->~T();
+		release(c, pos);
+	}
+
+	//	snapshots : may be stale as soon as they return, and count failed pushes not yet skipped
+	size_type size() const {
+		const size_type deq = dequeue_pos.load(std::memory_order_acquire);
+		const size_type enq = enqueue_pos.load(std::memory_order_acquire);
+		return enq > deq ? enq - deq : 0;
+	}
+	bool empty() const { return size() == 0; }
+	size_type capacity() const { return mask + 1; }
+};
+
+}	//	FT
+
+#endif
@@ -0,0 +1,168 @@
+#ifndef CONCURRENT_STACK_HPP
+# define CONCURRENT_STACK_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+
+#include <stdint.h>
+
+namespace ft
+{
+
+/*
+ *	Tagged Pointer
+ *	pointer and a modification counter in one word, so a single CAS notices
+ *	that the head was popped and pushed back in between (ABA).
+ *	64 bit : 48 bit address, 16 bit tag. 32 bit : 32 / 32.
+ */
+template<typename T>
+struct tagged_ptr
+{
+	static const int		tag_shift = sizeof(void*) == 8 ? 48 : 32;
+	static const uint64_t	ptr_mask = (uint64_t(1) << tag_shift) - 1;
+
+	static uint64_t pack(T* ptr, uint64_t tag) {
+		return (uint64_t(reinterpret_cast<uintptr_t>(ptr)) & ptr_mask) | (tag << tag_shift);
+	}
+	static T* ptr(uint64_t bits) {
+		return reinterpret_cast<T*>(static_cast<uintptr_t>(bits & ptr_mask));
+	}
+	static uint64_t tag(uint64_t bits) { return bits >> tag_shift; }
+};
+
+/*
+ *	Concurrent Stack : lock free Treiber stack.
+ *	Popped nodes are never freed while the stack lives, they go to an internal
+ *	free list (also a tagged Treiber stack) and are reused by later pushes.
+ *	A thread that lost a race may still read next from a recycled node : the
+ *	memory stays valid and the tag makes its CAS fail.
+ */
+template<typename T, typename Alloc = std::allocator<T> >
+class concurrent_stack
+{
+public:
+	typedef T				value_type;
+	typedef std::size_t		size_type;
+	typedef Alloc			allocator_type;
+
+private:
+	struct node
+	{
+		std::atomic<node*>	next;
+		node*				all;		//	every node ever allocated, for the destructor
+		alignas(T) unsigned char	storage[sizeof(T)];
+
+		T* value() { return reinterpret_cast<T*>(storage); }
+	};
+
+	typedef typename Alloc::template rebind<node>::other	node_allocator;
+	typedef tagged_ptr<node>								tagged;
+
+	node_allocator				alloc;
+	std::atomic<uint64_t>		head;
+	std::atomic<uint64_t>		free_head;
+	std::atomic<node*>			all_nodes;
+	std::atomic<size_type>		count;
+
+	concurrent_stack(const concurrent_stack&);
+	concurrent_stack& operator=(const concurrent_stack&);
+
+	static void push_node(std::atomic<uint64_t>& top, node* n) {
+		uint64_t old = top.load(std::memory_order_relaxed);
+		for (;;) {
+			n->next.store(tagged::ptr(old), std::memory_order_relaxed);
+			if (top.compare_exchange_weak(old, tagged::pack(n, tagged::tag(old) + 1),
+					std::memory_order_release, std::memory_order_relaxed))
+				return ;
+		}
+	}
+
+	static node* pop_node(std::atomic<uint64_t>& top) {
+		uint64_t old = top.load(std::memory_order_acquire);
+		for (;;) {
+			node* n = tagged::ptr(old);
+			if (n == 0) return 0;
+			node* next = n->next.load(std::memory_order_relaxed);
+			if (top.compare_exchange_weak(old, tagged::pack(next, tagged::tag(old) + 1),
+					std::memory_order_acquire, std::memory_order_acquire))
+				return n;
+		}
+	}
+
+	node* acquire_node() {
+		node* n = pop_node(free_head);
+		if (n) return n;
+
+		n = alloc.allocate(1);
+		::new (static_cast<void*>(&n->next)) std::atomic<node*>(static_cast<node*>(0));
+		n->all = all_nodes.load(std::memory_order_relaxed);
+		while (!all_nodes.compare_exchange_weak(n->all, n, std::memory_order_relaxed)) ;
+		return n;
+	}
+
+public:
+	explicit concurrent_stack(const allocator_type& a = allocator_type())
+	: alloc(a), head(0), free_head(0), all_nodes(0), count(0) {}
+
+	//	not thread safe : no other thread may use the stack any more
+	~concurrent_stack() {
+		for (node* n = tagged::ptr(head.load()); n; n = n->next.load())
+			n->value()->~T();
+		for (node* n = all_nodes.load(); n; ) {
+			node* next = n->all;
+			alloc.deallocate(n, 1);
+			n = next;
+		}
+	}
+
+	void push(const value_type& value) {
+		node* n = acquire_node();
+		try {
+			::new (static_cast<void*>(n->storage)) T(value);
+		}
+		catch (...) {
+			push_node(free_head, n);
+			throw ;
+		}
+		//	counted before it is published : a pop can not decrement ahead of it
+		count.fetch_add(1, std::memory_order_relaxed);
+		push_node(head, n);
+	}
+
+	bool try_pop(value_type& out) {
+		node* n = pop_node(head);
+		if (n == 0) return false;
+		count.fetch_sub(1, std::memory_order_relaxed);
+		try {
+			out = *n->value();
+		}
+		catch (...) {
+			//	back on top, still counted
+			count.fetch_add(1, std::memory_order_relaxed);
+			push_node(head, n);
+			throw ;
+		}
+		n->value()->~T();
+		push_node(free_head, n);
+		return true;
+	}
+
+	//	drops the top element, if any
+	void pop() {
+		node* n = pop_node(head);
+		if (n == 0) return ;
+		count.fetch_sub(1, std::memory_order_relaxed);
+		n->value()->~T();
+		push_node(free_head, n);
+	}
+
+	//	snapshots : may be stale as soon as they return
+	bool empty() const { return tagged::ptr(head.load(std::memory_order_acquire)) == 0; }
+	size_type size() const { return count.load(std::memory_order_relaxed); }
+};
+
+}	//	FT
+
+#endif
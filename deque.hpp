@@ -0,0 +1,570 @@
+#ifndef DEQUE_HPP
+# define DEQUE_HPP
+
+#include "iter.hpp"
+#include "algorithm.hpp"
+
+#include <memory>
+#include <algorithm>
+#include <stdexcept>
+#include <limits>
+
+namespace ft {
+
+/*
+ *	Deque Iterator
+ *	cur walks one block [first, last), node is the block's slot in the map
+ */
+template <typename T, typename Ref, typename Ptr>
+struct deque_iterator
+{
+	typedef deque_iterator<T, T&, T*>					iterator;
+	typedef deque_iterator<T, const T&, const T*>		const_iterator;
+
+	typedef std::random_access_iterator_tag				iterator_category;
+	typedef T											value_type;
+	typedef Ptr											pointer;
+	typedef Ref											reference;
+	typedef std::ptrdiff_t								difference_type;
+	typedef T**											map_pointer;
+	typedef deque_iterator								self;
+
+	T*				cur;
+	T*				first;
+	T*				last;
+	map_pointer		node;
+
+	//	4 KB blocks, at least 16 elements for big records
+	static difference_type block_size(void) {
+		return sizeof(T) < 256 ? difference_type(4096 / sizeof(T)) : difference_type(16);
+	}
+
+	deque_iterator() : cur(0), first(0), last(0), node(0) {};
+	deque_iterator(T* x, map_pointer y) : cur(x), first(*y), last(*y + block_size()), node(y) {};
+	deque_iterator(const iterator& x) : cur(x.cur), first(x.first), last(x.last), node(x.node) {};
+
+	self& operator=(const iterator& x) {
+		cur = x.cur;
+		first = x.first;
+		last = x.last;
+		node = x.node;
+		return *this;
+	}
+
+	void set_node(map_pointer new_node) {
+		node = new_node;
+		first = *new_node;
+		last = first + block_size();
+	}
+
+	reference operator*(void) const { return *cur; }
+	pointer operator->(void) const { return cur; }
+	reference operator[](difference_type n) const { return *(*this + n); }
+
+	self& operator++(void) {
+		if (++cur == last) {
+			set_node(node + 1);
+			cur = first;
+		}
+		return *this;
+	}
+	self operator++(int) {
+		self tmp(*this);
+		++*this;
+		return tmp;
+	}
+	self& operator--(void) {
+		if (cur == first) {
+			set_node(node - 1);
+			cur = last;
+		}
+		--cur;
+		return *this;
+	}
+	self operator--(int) {
+		self tmp(*this);
+		--*this;
+		return tmp;
+	}
+
+	self& operator+=(difference_type n) {
+		const difference_type offset = n + (cur - first);
+		if (offset >= 0 && offset < block_size())
+			cur += n;
+		else {
+			const difference_type node_offset = offset > 0
+				? offset / block_size()
+				: -((-offset - 1) / block_size()) - 1;
+			set_node(node + node_offset);
+			cur = first + (offset - node_offset * block_size());
+		}
+		return *this;
+	}
+	self& operator-=(difference_type n) { return *this += -n; }
+	self operator+(difference_type n) const {
+		self tmp(*this);
+		return tmp += n;
+	}
+	self operator-(difference_type n) const {
+		self tmp(*this);
+		return tmp -= n;
+	}
+};
+
+	/*
+	 * Deque Iterator relational
+	 */
+	template <typename T, typename RefL, typename PtrL, typename RefR, typename PtrR>
+	bool operator==(const deque_iterator<T, RefL, PtrL>& lhs, const deque_iterator<T, RefR, PtrR>& rhs) {
+		return lhs.cur == rhs.cur;
+	}
+	template <typename T, typename RefL, typename PtrL, typename RefR, typename PtrR>
+	bool operator!=(const deque_iterator<T, RefL, PtrL>& lhs, const deque_iterator<T, RefR, PtrR>& rhs) {
+		return lhs.cur != rhs.cur;
+	}
+	template <typename T, typename RefL, typename PtrL, typename RefR, typename PtrR>
+	bool operator<(const deque_iterator<T, RefL, PtrL>& lhs, const deque_iterator<T, RefR, PtrR>& rhs) {
+		return lhs.node == rhs.node ? lhs.cur < rhs.cur : lhs.node < rhs.node;
+	}
+	template <typename T, typename RefL, typename PtrL, typename RefR, typename PtrR>
+	bool operator>(const deque_iterator<T, RefL, PtrL>& lhs, const deque_iterator<T, RefR, PtrR>& rhs) {
+		return rhs < lhs;
+	}
+	template <typename T, typename RefL, typename PtrL, typename RefR, typename PtrR>
+	bool operator<=(const deque_iterator<T, RefL, PtrL>& lhs, const deque_iterator<T, RefR, PtrR>& rhs) {
+		return !(rhs < lhs);
+	}
+	template <typename T, typename RefL, typename PtrL, typename RefR, typename PtrR>
+	bool operator>=(const deque_iterator<T, RefL, PtrL>& lhs, const deque_iterator<T, RefR, PtrR>& rhs) {
+		return !(lhs < rhs);
+	}
+	template <typename T, typename RefL, typename PtrL, typename RefR, typename PtrR>
+	typename deque_iterator<T, RefL, PtrL>::difference_type
+	operator-(const deque_iterator<T, RefL, PtrL>& lhs, const deque_iterator<T, RefR, PtrR>& rhs) {
+		return deque_iterator<T, RefL, PtrL>::block_size() * (lhs.node - rhs.node - 1)
+			+ (lhs.cur - lhs.first) + (rhs.last - rhs.cur);
+	}
+	template <typename T, typename Ref, typename Ptr>
+	deque_iterator<T, Ref, Ptr> operator+(typename deque_iterator<T, Ref, Ptr>::difference_type n,
+										const deque_iterator<T, Ref, Ptr>& rhs) {
+		return rhs + n;
+	}
+
+/*
+ *	Deque
+ *	elements live in fixed size blocks, the map holds the block pointers.
+ *	Growing at either end only allocates a block or moves block pointers :
+ *	elements are never relocated, references stay valid across push / pop at the ends.
+ */
+template <typename T, typename _Alloc = std::allocator<T> >
+class deque
+{
+public:
+	//	Type
+	typedef T													value_type;
+	typedef _Alloc												allocator_type;
+	typedef typename allocator_type::pointer					pointer;
+	typedef typename allocator_type::const_pointer				const_pointer;
+	typedef value_type&											reference;
+	typedef const value_type&									const_reference;
+	typedef std::size_t											size_type;
+	typedef std::ptrdiff_t										difference_type;
+
+	//	Iterator
+	typedef deque_iterator<T, T&, T*>							iterator;
+	typedef deque_iterator<T, const T&, const T*>				const_iterator;
+	typedef ft::reverse_iterator<iterator>						reverse_iterator;
+	typedef ft::reverse_iterator<const_iterator>				const_reverse_iterator;
+
+private:
+	typedef T**													map_pointer;
+	typedef typename _Alloc::template rebind<T*>::other			map_allocator;
+
+	//	Variable
+	allocator_type	_alloc_;
+	map_allocator	_map_alloc_;
+	map_pointer		_map_;
+	size_type		_map_size_;
+	iterator		_start_;
+	iterator		_finish_;
+
+	static size_type _block(void) { return iterator::block_size(); }
+
+private:	//	Function
+	T*		_allocate_block(void) { return _alloc_.allocate(_block()); }
+	void	_deallocate_block(T* p) { _alloc_.deallocate(p, _block()); }
+
+	void	_init_map(size_type n) {
+		const size_type nodes = n / _block() + 1;
+
+		_map_size_ = std::max(size_type(8), nodes + 2);
+		_map_ = _map_alloc_.allocate(_map_size_);
+
+		map_pointer nstart = _map_ + (_map_size_ - nodes) / 2;
+		map_pointer nfinish = nstart + nodes;
+		map_pointer cur = nstart;
+		try {
+			for (; cur < nfinish; ++cur) *cur = _allocate_block();
+		}
+		catch (...) {
+			for (map_pointer p = nstart; p < cur; ++p) _deallocate_block(*p);
+			_map_alloc_.deallocate(_map_, _map_size_);
+			throw ;
+		}
+		_start_.set_node(nstart);
+		_finish_.set_node(nfinish - 1);
+		_start_.cur = _start_.first;
+		_finish_.cur = _finish_.first + n % _block();
+	}
+
+	void	_destroy(iterator first, iterator last) {
+		for (; first != last; ++first) _alloc_.destroy(first.cur);
+	}
+
+	/*
+	 *	Map growth : recenter the used slots when the map is less than half full,
+	 *	otherwise move them to a bigger map. Only block pointers are copied.
+	 */
+	void	_reallocate_map(size_type nodes_to_add, bool add_at_front) {
+		const size_type old_nodes = _finish_.node - _start_.node + 1;
+		const size_type new_nodes = old_nodes + nodes_to_add;
+		map_pointer new_nstart;
+
+		if (_map_size_ > 2 * new_nodes) {
+			new_nstart = _map_ + (_map_size_ - new_nodes) / 2 + (add_at_front ? nodes_to_add : 0);
+			ft::copy(_start_.node, _finish_.node + 1, new_nstart);
+		} else {
+			const size_type new_map_size = _map_size_ + std::max(_map_size_, nodes_to_add) + 2;
+			map_pointer new_map = _map_alloc_.allocate(new_map_size);
+
+			new_nstart = new_map + (new_map_size - new_nodes) / 2 + (add_at_front ? nodes_to_add : 0);
+			ft::copy(_start_.node, _finish_.node + 1, new_nstart);
+			_map_alloc_.deallocate(_map_, _map_size_);
+			_map_ = new_map;
+			_map_size_ = new_map_size;
+		}
+		_start_.set_node(new_nstart);
+		_finish_.set_node(new_nstart + old_nodes - 1);
+	}
+
+	void	_reserve_map_at_back(size_type nodes_to_add = 1) {
+		if (nodes_to_add + 1 > _map_size_ - (_finish_.node - _map_))
+			_reallocate_map(nodes_to_add, false);
+	}
+	void	_reserve_map_at_front(size_type nodes_to_add = 1) {
+		if (nodes_to_add > size_type(_start_.node - _map_))
+			_reallocate_map(nodes_to_add, true);
+	}
+
+	void	_release(void) {
+		if (_map_ == 0) return ;
+		clear();
+		_deallocate_block(_start_.first);
+		_map_alloc_.deallocate(_map_, _map_size_);
+		_map_ = 0;
+	}
+
+	void	_push_back_aux(const value_type& value) {
+		_reserve_map_at_back();
+		*(_finish_.node + 1) = _allocate_block();
+		try {
+			_alloc_.construct(_finish_.cur, value);
+		}
+		catch (...) {
+			_deallocate_block(*(_finish_.node + 1));
+			throw ;
+		}
+		_finish_.set_node(_finish_.node + 1);
+		_finish_.cur = _finish_.first;
+	}
+
+	void	_push_front_aux(const value_type& value) {
+		_reserve_map_at_front();
+		*(_start_.node - 1) = _allocate_block();
+		try {
+			_alloc_.construct(*(_start_.node - 1) + _block() - 1, value);
+		}
+		catch (...) {
+			_deallocate_block(*(_start_.node - 1));
+			throw ;
+		}
+		_start_.set_node(_start_.node - 1);
+		_start_.cur = _start_.last - 1;
+	}
+
+public:		//	Cannonical
+	explicit deque(const allocator_type& alloc = allocator_type())
+		: _alloc_(alloc), _map_alloc_(alloc), _map_(0), _map_size_(0) {
+			_init_map(0);
+		}
+
+	explicit deque(size_type n,
+				const value_type& value = value_type(),
+				const allocator_type& alloc = allocator_type())
+		: _alloc_(alloc), _map_alloc_(alloc), _map_(0), _map_size_(0) {
+			_init_map(0);
+			try {
+				for (; n; --n) push_back(value);
+			}
+			catch (...) {
+				_release();
+				throw ;
+			}
+		}
+
+	template <typename InputIterator>
+	deque(InputIterator first,
+		InputIterator last,
+		const allocator_type& alloc = allocator_type(),
+		typename enable_if<!ft::is_integral<InputIterator>::value>::type* = 0)
+		: _alloc_(alloc), _map_alloc_(alloc), _map_(0), _map_size_(0) {
+			_init_map(0);
+			try {
+				for (; first != last; ++first) push_back(*first);
+			}
+			catch (...) {
+				_release();
+				throw ;
+			}
+		}
+
+	deque(const deque& d)
+		: _alloc_(d._alloc_), _map_alloc_(d._map_alloc_), _map_(0), _map_size_(0) {
+			_init_map(0);
+			try {
+				for (const_iterator it = d.begin(); it != d.end(); ++it) push_back(*it);
+			}
+			catch (...) {
+				_release();
+				throw ;
+			}
+		}
+
+	~deque(void) { _release(); }
+
+	deque& operator=(const deque& d) {
+		if (this == &d) return *this;
+		assign(d.begin(), d.end());
+		return *this;
+	}
+
+	void assign(size_type count, const value_type& value) {
+		clear();
+		for (; count; --count) push_back(value);
+	}
+
+	template <typename Iter>
+	void assign(Iter first, Iter last, typename enable_if<!ft::is_integral<Iter>::value>::type* = 0) {
+		clear();
+		for (; first != last; ++first) push_back(*first);
+	}
+
+	allocator_type get_allocator(void) const { return _alloc_; }
+
+	//	Size
+	bool empty(void) const { return _start_ == _finish_; }
+	size_type size(void) const { return _finish_ - _start_; }
+	size_type max_size(void) const { return _alloc_.max_size(); }
+
+	void resize(size_type n, value_type value = value_type()) {
+		if (n > max_size()) throw std::length_error("Too much allocation");
+		if (size() > n) erase(begin() + n, end());
+		else insert(end(), n - size(), value);
+	}
+
+	//	keeps the start block, every other block goes back to the allocator
+	void clear(void) {
+		_destroy(_start_, _finish_);
+		for (map_pointer node = _start_.node + 1; node <= _finish_.node; ++node)
+			_deallocate_block(*node);
+		_finish_ = _start_;
+	}
+
+	void swap(deque& d) {
+		if (this == &d) return ;
+		std::swap(_alloc_, d._alloc_);
+		std::swap(_map_alloc_, d._map_alloc_);
+		std::swap(_map_, d._map_);
+		std::swap(_map_size_, d._map_size_);
+		std::swap(_start_, d._start_);
+		std::swap(_finish_, d._finish_);
+	}
+
+	//	Iterator
+	iterator begin(void) { return _start_; }
+	const_iterator begin(void) const { return _start_; }
+	iterator end(void) { return _finish_; }
+	const_iterator end(void) const { return _finish_; }
+	reverse_iterator rbegin(void) { return reverse_iterator(end()); }
+	const_reverse_iterator rbegin(void) const { return const_reverse_iterator(end()); }
+	reverse_iterator rend(void) { return reverse_iterator(begin()); }
+	const_reverse_iterator rend(void) const { return const_reverse_iterator(begin()); }
+
+	//	Elem Access
+	reference operator[](size_type n) { return _start_[difference_type(n)]; }
+	const_reference operator[](size_type n) const { return _start_[difference_type(n)]; }
+	reference at(size_type n) {
+		if (n >= size()) throw std::out_of_range("index out of range");
+		return (*this)[n];
+	}
+	const_reference at(size_type n) const {
+		if (n >= size()) throw std::out_of_range("index out of range");
+		return (*this)[n];
+	}
+	reference front(void) { return *_start_; }
+	const_reference front(void) const { return *_start_; }
+	reference back(void) { return *(_finish_ - 1); }
+	const_reference back(void) const { return *(_finish_ - 1); }
+
+	//	Modifier
+	void push_back(const value_type& value) {
+		if (_finish_.cur != _finish_.last - 1) {
+			_alloc_.construct(_finish_.cur, value);
+			++_finish_.cur;
+		}
+		else _push_back_aux(value);
+	}
+	void push_front(const value_type& value) {
+		if (_start_.cur != _start_.first) {
+			_alloc_.construct(_start_.cur - 1, value);
+			--_start_.cur;
+		}
+		else _push_front_aux(value);
+	}
+	void pop_back(void) {
+		if (_finish_.cur == _finish_.first) {
+			_deallocate_block(_finish_.first);
+			_finish_.set_node(_finish_.node - 1);
+			_finish_.cur = _finish_.last;
+		}
+		--_finish_.cur;
+		_alloc_.destroy(_finish_.cur);
+	}
+	void pop_front(void) {
+		_alloc_.destroy(_start_.cur);
+		if (_start_.cur == _start_.last - 1) {
+			_deallocate_block(_start_.first);
+			_start_.set_node(_start_.node + 1);
+			_start_.cur = _start_.first;
+		}
+		else ++_start_.cur;
+	}
+
+	iterator insert(iterator pos, const value_type& value) {
+		if (pos == begin()) {
+			push_front(value);
+			return begin();
+		}
+		if (pos == end()) {
+			push_back(value);
+			return end() - 1;
+		}
+		const difference_type index = pos - begin();
+		insert(pos, 1, value);
+		return begin() + index;
+	}
+
+	/*
+	 *	Insert : open n slots at the nearer end, shift the elements in between
+	 */
+	void insert(iterator pos, size_type n, const value_type& value) {
+		const size_type index = pos - begin();
+		if (_open(index, n, value)) {
+			iterator it = begin() + index;
+			for (size_type i = 0; i < n; ++i, ++it) *it = value;
+		}
+	}
+
+	template <typename Iter>
+	void insert(iterator pos, Iter first, Iter last, typename enable_if<!ft::is_integral<Iter>::value>::type* = 0) {
+		_insert_range(pos - begin(), first, last, typename iterator_traits<Iter>::iterator_category());
+	}
+
+	iterator erase(iterator pos) { return erase(pos, pos + 1); }
+
+	//	Erase : close the gap from the nearer end
+	iterator erase(iterator first, iterator last) {
+		const difference_type n = last - first;
+		const difference_type index = first - begin();
+		if (n == 0) return first;
+
+		if (index < difference_type(size() - n) / 2) {
+			ft::copy_backward(begin(), first, last);
+			for (difference_type i = 0; i < n; ++i) pop_front();
+		} else {
+			ft::copy(last, end(), first);
+			for (difference_type i = 0; i < n; ++i) pop_back();
+		}
+		return begin() + index;
+	}
+
+private:
+	//	a single pass range is read once, into a buffer that is then inserted
+	template <typename Iter>
+	void _insert_range(size_type index, Iter first, Iter last, std::input_iterator_tag) {
+		deque buf(first, last, _alloc_);
+		_insert_range(index, buf.begin(), buf.end(), std::forward_iterator_tag());
+	}
+
+	template <typename Iter>
+	void _insert_range(size_type index, Iter first, Iter last, std::forward_iterator_tag) {
+		const size_type n = ft::difference(first, last);
+		if (n && _open(index, n, *first))
+			ft::copy(first, last, begin() + index);
+	}
+
+	//	grows by n copies of fill, then moves [index, old size) out of the way
+	bool _open(size_type index, size_type n, const value_type& fill) {
+		if (n == 0) return false;
+		const size_type len = size();
+		if (index < len / 2) {
+			for (size_type i = 0; i < n; ++i) push_front(fill);
+			ft::copy(begin() + n, begin() + n + index, begin());
+		} else {
+			for (size_type i = 0; i < n; ++i) push_back(fill);
+			ft::copy_backward(begin() + index, begin() + len, end());
+		}
+		return true;
+	}
+};
+
+template<typename T, typename _Alloc>
+bool operator==(const ft::deque<T, _Alloc>& lhs, const ft::deque<T, _Alloc>& rhs) {
+	return lhs.size() == rhs.size() && ft::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template<typename T, typename _Alloc>
+bool operator!=(const ft::deque<T, _Alloc>& lhs, const ft::deque<T, _Alloc>& rhs) {
+	return !(lhs == rhs);
+}
+
+template<typename T, typename _Alloc>
+bool operator<(const ft::deque<T, _Alloc>& lhs, const ft::deque<T, _Alloc>& rhs) {
+	return ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template<typename T, typename _Alloc>
+bool operator<=(const ft::deque<T, _Alloc>& lhs, const ft::deque<T, _Alloc>& rhs) {
+	return !(rhs < lhs);
+}
+
+template<typename T, typename _Alloc>
+bool operator>(const ft::deque<T, _Alloc>& lhs, const ft::deque<T, _Alloc>& rhs) {
+	return rhs < lhs;
+}
+
+template<typename T, typename _Alloc>
+bool operator>=(const ft::deque<T, _Alloc>& lhs, const ft::deque<T, _Alloc>& rhs) {
+	return !(lhs < rhs);
+}
+
+}	// FT
+
+namespace std {
+template <typename T, typename Alloc>
+void swap (ft::deque<T,Alloc>& lhs, ft::deque<T,Alloc>& rhs) {
+	lhs.swap(rhs);
+}
+}	//	STD
+
+#endif
@@ -0,0 +1,257 @@
+#ifndef EXECUTION_HPP
+# define EXECUTION_HPP
+
+#include "algorithm.hpp"
+#include "thread_pool.hpp"
+#include "traits.hpp"
+#include "vector.hpp"
+
+#include <algorithm>
+
+namespace ft
+{
+namespace execution
+{
+
+/*
+ *	Execution Policies
+ *	par runs on thread_pool::instance(), par.on(pool) on a caller owned pool
+ */
+struct sequenced_policy {};
+
+struct parallel_policy
+{
+	thread_pool*	pool;
+
+	parallel_policy() : pool(0) {}
+	explicit parallel_policy(thread_pool& p) : pool(&p) {}
+
+	parallel_policy on(thread_pool& p) const { return parallel_policy(p); }
+	thread_pool& get_pool() const { return pool ? *pool : thread_pool::instance(); }
+};
+
+static const sequenced_policy	seq = sequenced_policy();
+static const parallel_policy	par = parallel_policy();
+
+}	//	EXECUTION
+
+template<typename T> struct is_execution_policy : public false_type {};
+template<> struct is_execution_policy<execution::sequenced_policy> : public true_type {};
+template<> struct is_execution_policy<execution::parallel_policy> : public true_type {};
+
+namespace parallel
+{
+
+//	below this many elements a chunk is not worth a task
+static const std::ptrdiff_t grain = 1 << 14;
+
+/*
+ *	Split [0, n) into at most 4 chunks per thread, none smaller than grain
+ */
+inline std::ptrdiff_t chunk_size(std::ptrdiff_t n, unsigned threads) {
+	std::ptrdiff_t chunks = std::max<std::ptrdiff_t>(1, std::min<std::ptrdiff_t>(threads * 4, n / grain));
+	return (n + chunks - 1) / chunks;
+}
+
+/*
+ *	Merge two sorted runs into out. The larger run is split at its middle,
+ *	the other one at the matching bound, and the halves are merged as separate tasks.
+ *	lower_bound / upper_bound keep ties of the first run in front : the merge stays stable.
+ */
+template<typename Src, typename Dst, typename Compare>
+void merge(task_group& group, Src a1, Src a2, Src b1, Src b2, Dst out, Compare comp) {
+	for (;;) {
+		const std::ptrdiff_t na = a2 - a1;
+		const std::ptrdiff_t nb = b2 - b1;
+
+		if (na + nb <= grain) {
+			ft::merge(a1, a2, b1, b2, out, comp);
+			return ;
+		}
+		Src am, bm;
+		if (na >= nb) {
+			am = a1 + na / 2;
+			bm = ft::lower_bound(b1, b2, *am, comp);
+		} else {
+			bm = b1 + nb / 2;
+			am = ft::upper_bound(a1, a2, *bm, comp);
+		}
+		Dst out_mid = out + ((am - a1) + (bm - b1));
+		group.run([=, &group] { parallel::merge(group, am, a2, bm, b2, out_mid, comp); });
+		a2 = am;
+		b2 = bm;
+	}
+}
+
+template<typename Src, typename Dst, typename Compare>
+void merge_pass(task_group& group, Src src, Dst dst, std::ptrdiff_t n, std::ptrdiff_t width, Compare comp) {
+	for (std::ptrdiff_t lo = 0; lo < n; lo += 2 * width) {
+		const std::ptrdiff_t mid = std::min(lo + width, n);
+		const std::ptrdiff_t hi = std::min(lo + 2 * width, n);
+		group.run([=, &group] { parallel::merge(group, src + lo, src + mid, src + mid, src + hi, dst + lo, comp); });
+	}
+	group.wait();
+}
+
+/*
+ *	Chunks are sorted independently, then merged pairwise in parallel passes
+ */
+template<typename RandomIt, typename Compare>
+void merge_sort(thread_pool& pool, RandomIt first, RandomIt last, Compare comp, bool stable) {
+	typedef typename iterator_traits<RandomIt>::value_type	value_type;
+	const std::ptrdiff_t n = last - first;
+
+	if (pool.size() == 1 || n <= 2 * grain) {
+		if (stable) ft::stable_sort(first, last, comp);
+		else ft::sort(first, last, comp);
+		return ;
+	}
+
+	const std::ptrdiff_t chunk = chunk_size(n, pool.size());
+	task_group	group(pool);
+	for (std::ptrdiff_t lo = 0; lo < n; lo += chunk) {
+		RandomIt b = first + lo;
+		RandomIt e = first + std::min(lo + chunk, n);
+		if (stable) group.run([=] { ft::stable_sort(b, e, comp); });
+		else group.run([=] { ft::sort(b, e, comp); });
+	}
+	group.wait();
+	if (chunk >= n) return ;
+
+	temporary_buffer<value_type>	buf(first, last);
+	value_type*						scratch = buf.begin();
+	bool							in_buf = false;
+	for (std::ptrdiff_t width = chunk; width < n; width *= 2, in_buf = !in_buf) {
+		if (in_buf) parallel::merge_pass(group, scratch, first, n, width, comp);
+		else parallel::merge_pass(group, first, scratch, n, width, comp);
+	}
+	if (in_buf) {
+		for (std::ptrdiff_t lo = 0; lo < n; lo += chunk) {
+			const std::ptrdiff_t hi = std::min(lo + chunk, n);
+			group.run([=] { ft::copy(scratch + lo, scratch + hi, first + lo); });
+		}
+		group.wait();
+	}
+}
+
+}	//	PARALLEL
+
+/*
+ *	Policy overloads
+ */
+template<typename Policy, typename RandomIt, typename Compare>
+typename enable_if<is_execution_policy<Policy>::value>::type
+sort(const Policy&, RandomIt first, RandomIt last, Compare comp) {
+	ft::sort(first, last, comp);
+}
+
+template<typename RandomIt, typename Compare>
+void sort(const execution::parallel_policy& policy, RandomIt first, RandomIt last, Compare comp) {
+	parallel::merge_sort(policy.get_pool(), first, last, comp, false);
+}
+
+template<typename Policy, typename RandomIt>
+typename enable_if<is_execution_policy<Policy>::value>::type
+sort(const Policy& policy, RandomIt first, RandomIt last) {
+	ft::sort(policy, first, last, ft::less<typename iterator_traits<RandomIt>::value_type>());
+}
+
+template<typename Policy, typename RandomIt, typename Compare>
+typename enable_if<is_execution_policy<Policy>::value>::type
+stable_sort(const Policy&, RandomIt first, RandomIt last, Compare comp) {
+	ft::stable_sort(first, last, comp);
+}
+
+template<typename RandomIt, typename Compare>
+void stable_sort(const execution::parallel_policy& policy, RandomIt first, RandomIt last, Compare comp) {
+	parallel::merge_sort(policy.get_pool(), first, last, comp, true);
+}
+
+template<typename Policy, typename RandomIt>
+typename enable_if<is_execution_policy<Policy>::value>::type
+stable_sort(const Policy& policy, RandomIt first, RandomIt last) {
+	ft::stable_sort(policy, first, last, ft::less<typename iterator_traits<RandomIt>::value_type>());
+}
+
+template<typename RandomIt, typename UnaryFunc>
+void for_each(const execution::sequenced_policy&, RandomIt first, RandomIt last, UnaryFunc f) {
+	ft::for_each(first, last, f);
+}
+
+template<typename RandomIt, typename UnaryFunc>
+void for_each(const execution::parallel_policy& policy, RandomIt first, RandomIt last, UnaryFunc f) {
+	thread_pool&			pool = policy.get_pool();
+	const std::ptrdiff_t	n = last - first;
+	const std::ptrdiff_t	chunk = parallel::chunk_size(n, pool.size());
+	task_group				group(pool);
+
+	for (std::ptrdiff_t lo = 0; lo < n; lo += chunk) {
+		RandomIt b = first + lo;
+		RandomIt e = first + std::min(lo + chunk, n);
+		group.run([=] { ft::for_each(b, e, f); });
+	}
+	group.wait();
+}
+
+template<typename RandomIt, typename OutputIt, typename UnaryOp>
+OutputIt transform(const execution::sequenced_policy&, RandomIt first, RandomIt last, OutputIt d_first, UnaryOp op) {
+	return ft::transform(first, last, d_first, op);
+}
+
+template<typename RandomIt, typename OutputIt, typename UnaryOp>
+OutputIt transform(const execution::parallel_policy& policy, RandomIt first, RandomIt last, OutputIt d_first, UnaryOp op) {
+	thread_pool&			pool = policy.get_pool();
+	const std::ptrdiff_t	n = last - first;
+	const std::ptrdiff_t	chunk = parallel::chunk_size(n, pool.size());
+	task_group				group(pool);
+
+	for (std::ptrdiff_t lo = 0; lo < n; lo += chunk) {
+		RandomIt b = first + lo;
+		RandomIt e = first + std::min(lo + chunk, n);
+		OutputIt d = d_first + lo;
+		group.run([=] { ft::transform(b, e, d, op); });
+	}
+	group.wait();
+	return d_first + n;
+}
+
+template<typename RandomIt, typename T, typename BinaryOp>
+T reduce(const execution::sequenced_policy&, RandomIt first, RandomIt last, T init, BinaryOp op) {
+	return ft::reduce(first, last, init, op);
+}
+
+//	op must be associative and commutative : chunks are folded separately, then together
+template<typename RandomIt, typename T, typename BinaryOp>
+T reduce(const execution::parallel_policy& policy, RandomIt first, RandomIt last, T init, BinaryOp op) {
+	thread_pool&			pool = policy.get_pool();
+	const std::ptrdiff_t	n = last - first;
+	const std::ptrdiff_t	chunk = parallel::chunk_size(n, pool.size());
+	if (n <= chunk) return ft::reduce(first, last, init, op);
+
+	const std::ptrdiff_t	chunks = (n + chunk - 1) / chunk;
+	ft::vector<T>			partial(chunks, init);
+	task_group				group(pool);
+
+	for (std::ptrdiff_t c = 0; c < chunks; ++c) {
+		RandomIt b = first + c * chunk;
+		RandomIt e = first + std::min((c + 1) * chunk, n);
+		T* out = &partial[c];
+		group.run([=] {
+			T acc = *b;
+			for (RandomIt it = b + 1; it != e; ++it) acc = op(acc, *it);
+			*out = acc;
+		});
+	}
+	group.wait();
+	return ft::accumulate(partial.begin(), partial.end(), init, op);
+}
+
+template<typename Policy, typename RandomIt, typename T>
+typename enable_if<is_execution_policy<Policy>::value, T>::type
+reduce(const Policy& policy, RandomIt first, RandomIt last, T init) {
+	return ft::reduce(policy, first, last, init, std::plus<T>());
+}
+
+}	//	FT
+
+#endif
@@ -0,0 +1,356 @@
+#ifndef EXTERNAL_SORT_HPP
+# define EXTERNAL_SORT_HPP
+
+#include "algorithm.hpp"
+#include "traits.hpp"
+#include "vector.hpp"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+
+#include <stdlib.h>
+#include <unistd.h>
+
+namespace ft
+{
+
+namespace external
+{
+
+/*
+ *	Temporary file : unlinked as soon as it is created, so it disappears with
+ *	its handle, even when the process dies.
+ */
+class temp_file
+{
+	std::FILE*	f;
+
+	temp_file(const temp_file&);
+	temp_file& operator=(const temp_file&);
+
+	static std::runtime_error error(const char* what) {
+		return std::runtime_error(std::string("external_sort : ") + what + " : " + std::strerror(errno));
+	}
+
+public:
+	explicit temp_file(const std::string& dir) : f(0) {
+		std::string	path = dir + "/ft_sort_XXXXXX";
+		const int	fd = ::mkstemp(&path[0]);
+		if (fd < 0) throw error("cannot create a temporary file");
+		::unlink(path.c_str());
+		f = ::fdopen(fd, "w+b");
+		if (f == 0) {
+			::close(fd);
+			throw error("fdopen");
+		}
+	}
+	~temp_file() { std::fclose(f); }
+
+	void write(const void* data, size_t n) {
+		if (n && std::fwrite(data, 1, n, f) != n) throw error("write failed");
+	}
+	void read(void* data, size_t n) {
+		if (n && std::fread(data, 1, n, f) != n) throw error("read failed");
+	}
+	void rewind() {
+		if (std::fflush(f) != 0) throw error("flush failed");
+		std::rewind(f);
+	}
+};
+
+struct run
+{
+	temp_file*	file;
+	size_t		count;
+};
+
+/*
+ *	Sorted records, from memory or streamed from a run file one buffer at a time
+ */
+template<typename T>
+struct source
+{
+	temp_file*		file;
+	size_t			left;		//	records still in the file
+	ft::vector<T>	buf;
+	const T*		cur;
+	const T*		last;
+
+	source() : file(0), left(0), cur(0), last(0) {}
+
+	bool empty() const { return cur == last; }
+	const T& front() const { return *cur; }
+	void pop() {
+		if (++cur == last && left) refill();
+	}
+
+	void open(const run& r, size_t buffer) {
+		file = r.file;
+		left = r.count;
+		buf.resize_default_init(buffer);
+		file->rewind();
+		refill();
+	}
+
+	void refill() {
+		const size_t	n = left < buf.size() ? left : buf.size();
+		file->read(buf.data(), n * sizeof(T));
+		left -= n;
+		cur = buf.data();
+		last = cur + n;
+	}
+};
+
+/*
+ *	Loser Tree : k way merge with log2(k) comparisons per record.
+ *	Leaf j is node k + j, node i > 0 keeps the loser of the match played there,
+ *	node 0 the overall winner. An empty source loses every match.
+ */
+template<typename T, typename Comp>
+class loser_tree
+{
+	ft::vector<source<T> >	src;
+	size_t					k;
+	ft::vector<size_t>		tree;
+	Comp					comp;
+
+	loser_tree(const loser_tree&);
+	loser_tree& operator=(const loser_tree&);
+
+	bool beats(size_t a, size_t b) const {
+		if (src[a].empty()) return false;
+		if (src[b].empty()) return true;
+		return !comp(src[b].front(), src[a].front());
+	}
+
+	size_t play(size_t node) {
+		if (node >= k) return node - k;
+		const size_t	l = play(2 * node);
+		const size_t	r = play(2 * node + 1);
+		if (beats(l, r)) {
+			tree[node] = r;
+			return l;
+		}
+		tree[node] = l;
+		return r;
+	}
+
+public:
+	explicit loser_tree(const Comp& c) : k(0), comp(c) {}
+
+	//	n empty sources : fill them in, then start()
+	source<T>* reset(size_t n) {
+		src.clear();
+		src.resize(n);
+		k = n;
+		return src.data();
+	}
+	void start() {
+		tree.assign(k, 0);
+		tree[0] = play(1);
+	}
+
+	bool empty() const { return src[tree[0]].empty(); }
+	const T& front() const { return src[tree[0]].front(); }
+
+	void pop() {
+		size_t	w = tree[0];
+
+		src[w].pop();
+		for (size_t node = (w + k) / 2; node; node /= 2) {
+			if (beats(tree[node], w)) {
+				const size_t	tmp = tree[node];
+				tree[node] = w;
+				w = tmp;
+			}
+		}
+		tree[0] = w;
+	}
+};
+
+}	//	EXTERNAL
+
+/*
+ *	External Sorter : sorts more records than fit in memory.
+ *	push() fills a run of memory_bytes, sorts it and spills it to a temporary file.
+ *	begin() then merges every run in one pass (several when there are more runs
+ *	than memory_bytes / min_block buffers) and streams the result as an input range.
+ *	When everything fit in one run nothing touches the disk.
+ *
+ *	Records are written raw : T must be trivially copyable.
+ *	Sorted unique keys feed a map / set in linear time :
+ *		m.assign_sorted(sorter.begin(), sorter.size());
+ */
+template<typename T, typename Comp = ft::less<T> >
+class external_sorter
+{
+public:
+	typedef T				value_type;
+	typedef std::size_t		size_type;
+	typedef Comp			value_compare;
+
+	//	smallest read buffer per run worth a seek
+	static const size_type	min_block = 1 << 16;
+
+	class iterator
+	{
+		external_sorter*	s;
+
+	public:
+		typedef std::input_iterator_tag		iterator_category;
+		typedef T							value_type;
+		typedef std::ptrdiff_t				difference_type;
+		typedef const T*					pointer;
+		typedef const T&					reference;
+
+		explicit iterator(external_sorter* sorter = 0) : s(sorter) {}
+
+		reference operator*() const { return s->merge.front(); }
+		pointer operator->() const { return &s->merge.front(); }
+		iterator& operator++() {
+			s->merge.pop();
+			return *this;
+		}
+		void operator++(int) { s->merge.pop(); }
+
+		bool done() const { return s == 0 || s->merge.empty(); }
+		bool operator==(const iterator& rhs) const { return done() == rhs.done(); }
+		bool operator!=(const iterator& rhs) const { return done() != rhs.done(); }
+	};
+
+private:
+	Comp									comp;
+	std::string								dir;
+	size_type								budget;
+	size_type								capacity;	//	records per run
+	size_type								total;
+	ft::vector<T>							pending;
+	ft::vector<external::run>				runs;
+	external::loser_tree<T, Comp>			merge;
+
+	external_sorter(const external_sorter&);
+	external_sorter& operator=(const external_sorter&);
+
+	static void check_type() {
+		static_assert(is_bitwise_copyable<T>::value, "external_sorter needs trivially copyable records");
+	}
+
+	void spill() {
+		ft::sort(pending.begin(), pending.end(), comp);
+		external::run	r;
+		r.file = new external::temp_file(dir);
+		r.count = pending.size();
+		try {
+			r.file->write(pending.data(), pending.size() * sizeof(T));
+			runs.push_back(r);
+		}
+		catch (...) {
+			delete r.file;
+			throw ;
+		}
+		pending.clear();
+	}
+
+	//	the memory left to k sources, one more buffer when writing the output
+	size_type per_source(size_type k) const {
+		const size_type	n = budget / k / sizeof(T);
+		return n ? n : 1;
+	}
+
+	size_type fan_in() const {
+		const size_type	k = budget / min_block;
+		return k > 2 ? k : 2;
+	}
+
+	void open_runs(size_type first, size_type k, size_type buffer) {
+		external::source<T>*	src = merge.reset(k);
+		for (size_type i = 0; i < k; ++i) src[i].open(runs[first + i], buffer);
+		merge.start();
+	}
+
+	//	merges runs [0, k) into a new run at the back
+	void merge_pass(size_type k) {
+		const size_type	buffer = per_source(k + 1);
+		external::run	r;
+
+		open_runs(0, k, buffer);
+		r.file = new external::temp_file(dir);
+		r.count = 0;
+		try {
+			ft::vector<T>	out;
+			out.reserve(buffer);
+			for (; !merge.empty(); merge.pop()) {
+				out.push_back(merge.front());
+				if (out.size() == buffer) {
+					r.file->write(out.data(), out.size() * sizeof(T));
+					r.count += out.size();
+					out.clear();
+				}
+			}
+			r.file->write(out.data(), out.size() * sizeof(T));
+			r.count += out.size();
+			merge.reset(0);
+			runs.push_back(r);
+		}
+		catch (...) {
+			delete r.file;
+			throw ;
+		}
+		for (size_type i = 0; i < k; ++i) delete runs[i].file;
+		runs.erase(runs.begin(), runs.begin() + k);
+	}
+
+public:
+	//	tmp_dir holds the runs : it needs room for every record pushed, twice with several passes
+	explicit external_sorter(size_type memory_bytes, const char* tmp_dir = "/tmp", const Comp& c = Comp())
+	: comp(c), dir(tmp_dir), budget(memory_bytes), capacity(memory_bytes / sizeof(T)), total(0), merge(c) {
+		check_type();
+		if (capacity == 0) capacity = 1;
+	}
+
+	~external_sorter() {
+		for (size_type i = 0; i < runs.size(); ++i) delete runs[i].file;
+	}
+
+	//	before begin() only
+	void push(const value_type& v) {
+		if (pending.size() == capacity) spill();
+		if (pending.capacity() == 0) pending.reserve(capacity);
+		pending.push_back(v);
+		++total;
+	}
+
+	template<typename Iter>
+	void push(Iter first, Iter last) {
+		for (; first != last; ++first) push(*first);
+	}
+
+	size_type size() const { return total; }
+	size_type spilled_runs() const { return runs.size(); }
+
+	//	sorts what is left and starts the merge : once, the range is read a single time
+	iterator begin() {
+		if (runs.empty()) {
+			ft::sort(pending.begin(), pending.end(), comp);
+			external::source<T>*	src = merge.reset(1);
+			src->cur = pending.data();
+			src->last = pending.data() + pending.size();
+			merge.start();
+			return iterator(this);
+		}
+		if (!pending.empty()) spill();
+		ft::vector<T>().swap(pending);
+		while (runs.size() > fan_in()) merge_pass(fan_in());
+		open_runs(0, runs.size(), per_source(runs.size()));
+		return iterator(this);
+	}
+	iterator end() { return iterator(); }
+};
+
+}	//	FT
+
+#endif
@@ -0,0 +1,232 @@
+#ifndef FROZEN_MAP_HPP
+# define FROZEN_MAP_HPP
+
+#if __cplusplus < 201402L
+# error "frozen_map.hpp sorts in constexpr functions : it needs C++14"
+#endif
+
+#include "pair.hpp"
+#include "iter.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+
+namespace ft
+{
+
+/*
+ *	C string order usable in constant expressions, for const char* keys
+ */
+struct cstr_less
+{
+	constexpr bool operator()(const char* lhs, const char* rhs) const {
+		while (*lhs && *lhs == *rhs) {
+			++lhs;
+			++rhs;
+		}
+		return static_cast<unsigned char>(*lhs) < static_cast<unsigned char>(*rhs);
+	}
+};
+
+namespace detail
+{
+
+/*
+ *	Sorted Table : N values in a flat array, heap sorted by key when constructed.
+ *	A repeated key throws, which fails the build in a constant expression.
+ *	N is at least 1 : there is no zero length array to hold an empty table.
+ */
+template<typename V, std::size_t N, typename KeyOf, typename Comp>
+class sorted_table
+{
+	static_assert(N > 0, "frozen tables hold at least one entry");
+
+	constexpr bool less(std::size_t a, std::size_t b) const { return comp(KeyOf()(items[a]), KeyOf()(items[b])); }
+
+	constexpr void exchange(std::size_t a, std::size_t b) {
+		const V	tmp = items[a];
+		items[a] = items[b];
+		items[b] = tmp;
+	}
+
+	constexpr void sift_down(std::size_t root, std::size_t n) {
+		for (std::size_t child = 2 * root + 1; child < n; root = child, child = 2 * root + 1) {
+			if (child + 1 < n && less(child, child + 1)) ++child;
+			if (!less(root, child)) return ;
+			exchange(root, child);
+		}
+	}
+
+protected:
+	V		items[N];
+	Comp	comp;
+
+	//	branch free : the loop runs log2(N) times whatever the key
+	template<typename K>
+	constexpr const V* lower(const K& k) const {
+		const V*	first = items;
+		std::size_t	len = N;
+
+		while (len > 1) {
+			const std::size_t	half = len / 2;
+			first = comp(KeyOf()(first[half]), k) ? first + half : first;
+			len -= half;
+		}
+		return first + comp(KeyOf()(*first), k);
+	}
+
+public:
+	constexpr sorted_table(const V (&init)[N], const Comp& c) : items(), comp(c) {
+		for (std::size_t i = 0; i < N; ++i) items[i] = init[i];
+		for (std::size_t i = N / 2; i-- > 0; ) sift_down(i, N);
+		for (std::size_t n = N; n-- > 1; ) {
+			exchange(0, n);
+			sift_down(0, n);
+		}
+		for (std::size_t i = 1; i < N; ++i)
+			if (!less(i - 1, i)) throw std::invalid_argument("frozen : repeated key");
+	}
+};
+
+template<typename P>
+struct frozen_first
+{
+	constexpr const typename P::first_type& operator()(const P& p) const { return p.first; }
+};
+
+template<typename K>
+struct frozen_identity
+{
+	constexpr const K& operator()(const K& k) const { return k; }
+};
+
+}	//	DETAIL
+
+/*
+ *	Frozen Map : an immutable map of N entries, sorted into a flat array at
+ *	construction, constexpr when the keys and values are literal types.
+ *	Declared constexpr (or static const with constant entries) it costs
+ *	nothing at startup, and a lookup is a binary search over contiguous
+ *	memory. find / count / at / bounds read like ft::map's const ones.
+ *	Keys must be unique and N at least 1. Build it with make_frozen_map to have N counted.
+ */
+template<typename K, typename V, std::size_t N, typename Comp = std::less<K> >
+class frozen_map
+: private detail::sorted_table<pair<K, V>, N, detail::frozen_first<pair<K, V> >, Comp>
+{
+	typedef detail::sorted_table<pair<K, V>, N, detail::frozen_first<pair<K, V> >, Comp>	base;
+
+public:
+	typedef K										key_type;
+	typedef V										mapped_type;
+	typedef pair<K, V>								value_type;
+	typedef Comp									key_compare;
+	typedef std::size_t								size_type;
+	typedef std::ptrdiff_t							difference_type;
+	typedef const value_type&						const_reference;
+	typedef const value_type*						const_iterator;
+	typedef const_iterator							iterator;
+	typedef ft::reverse_iterator<const_iterator>	const_reverse_iterator;
+	typedef const_reverse_iterator					reverse_iterator;
+
+	constexpr frozen_map(const value_type (&init)[N], const Comp& comp = Comp()) : base(init, comp) {}
+
+	constexpr const_iterator begin() const { return this->items; }
+	constexpr const_iterator end() const { return this->items + N; }
+	const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+	const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+	constexpr bool empty() const { return false; }
+	constexpr size_type size() const { return N; }
+	constexpr size_type max_size() const { return N; }
+	constexpr key_compare key_comp() const { return this->comp; }
+
+	constexpr const_iterator lower_bound(const key_type& k) const { return this->lower(k); }
+	constexpr const_iterator upper_bound(const key_type& k) const {
+		const_iterator	it = this->lower(k);
+		return it != end() && !this->comp(k, it->first) ? it + 1 : it;
+	}
+	constexpr pair<const_iterator, const_iterator> equal_range(const key_type& k) const {
+		return pair<const_iterator, const_iterator>(lower_bound(k), upper_bound(k));
+	}
+
+	constexpr const_iterator find(const key_type& k) const {
+		const_iterator	it = this->lower(k);
+		return it != end() && !this->comp(k, it->first) ? it : end();
+	}
+	constexpr size_type count(const key_type& k) const { return find(k) != end(); }
+	constexpr bool contains(const key_type& k) const { return find(k) != end(); }
+
+	constexpr const mapped_type& at(const key_type& k) const {
+		const_iterator	it = find(k);
+		if (it == end()) throw std::out_of_range("Range Exception");
+		return it->second;
+	}
+};
+
+/*
+ *	Frozen Set : the same over keys alone
+ */
+template<typename K, std::size_t N, typename Comp = std::less<K> >
+class frozen_set
+: private detail::sorted_table<K, N, detail::frozen_identity<K>, Comp>
+{
+	typedef detail::sorted_table<K, N, detail::frozen_identity<K>, Comp>	base;
+
+public:
+	typedef K										key_type;
+	typedef K										value_type;
+	typedef Comp									key_compare;
+	typedef Comp									value_compare;
+	typedef std::size_t								size_type;
+	typedef std::ptrdiff_t							difference_type;
+	typedef const value_type&						const_reference;
+	typedef const value_type*						const_iterator;
+	typedef const_iterator							iterator;
+	typedef ft::reverse_iterator<const_iterator>	const_reverse_iterator;
+	typedef const_reverse_iterator					reverse_iterator;
+
+	constexpr frozen_set(const value_type (&init)[N], const Comp& comp = Comp()) : base(init, comp) {}
+
+	constexpr const_iterator begin() const { return this->items; }
+	constexpr const_iterator end() const { return this->items + N; }
+	const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+	const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+	constexpr bool empty() const { return false; }
+	constexpr size_type size() const { return N; }
+	constexpr size_type max_size() const { return N; }
+	constexpr key_compare key_comp() const { return this->comp; }
+
+	constexpr const_iterator lower_bound(const key_type& k) const { return this->lower(k); }
+	constexpr const_iterator upper_bound(const key_type& k) const {
+		const_iterator	it = this->lower(k);
+		return it != end() && !this->comp(k, *it) ? it + 1 : it;
+	}
+	constexpr pair<const_iterator, const_iterator> equal_range(const key_type& k) const {
+		return pair<const_iterator, const_iterator>(lower_bound(k), upper_bound(k));
+	}
+
+	constexpr const_iterator find(const key_type& k) const {
+		const_iterator	it = this->lower(k);
+		return it != end() && !this->comp(k, *it) ? it : end();
+	}
+	constexpr size_type count(const key_type& k) const { return find(k) != end(); }
+	constexpr bool contains(const key_type& k) const { return find(k) != end(); }
+};
+
+//	ft::make_frozen_map<const char*, int, ft::cstr_less>({ { "add", 1 }, { "sub", 2 } })
+template<typename K, typename V, typename Comp = std::less<K>, std::size_t N>
+constexpr frozen_map<K, V, N, Comp> make_frozen_map(const pair<K, V> (&init)[N], const Comp& comp = Comp()) {
+	return frozen_map<K, V, N, Comp>(init, comp);
+}
+
+template<typename K, typename Comp = std::less<K>, std::size_t N>
+constexpr frozen_set<K, N, Comp> make_frozen_set(const K (&init)[N], const Comp& comp = Comp()) {
+	return frozen_set<K, N, Comp>(init, comp);
+}
+
+}	//	FT
+
+#endif
@@ -0,0 +1,569 @@
+#ifndef INDEX_TREE_HPP
+# define INDEX_TREE_HPP
+
+#include "rbtree.hpp"
+#include "traits.hpp"
+#include "vector.hpp"
+
+#include <memory>
+#include <new>
+#include <stdexcept>
+
+#include <stdint.h>
+
+namespace ft
+{
+
+/*
+ *	Index Node : links are 32 bit slot numbers into the tree's pool.
+ *	Slot 0 is the header. The color lives in bit 31 of parent, so a pool holds
+ *	at most 2^31 - 1 slots. A free slot has a nil parent and chains through left.
+ */
+template<typename V>
+struct index_node
+{
+	static const uint32_t	nil = 0x7fffffffu;
+	static const uint32_t	color_bit = 0x80000000u;
+
+	uint32_t	parent_color;
+	uint32_t	left;
+	uint32_t	right;
+	alignas(V) unsigned char	storage[sizeof(V)];
+
+	V& value() { return *reinterpret_cast<V*>(storage); }
+	const V& value() const { return *reinterpret_cast<const V*>(storage); }
+	uint32_t parent() const { return parent_color & ~color_bit; }
+};
+
+/*
+ *	Index Handle : what the tree algorithms see as a node pointer.
+ *	Only valid while the pool does not move, i.e. inside one operation.
+ */
+template<typename Node>
+struct index_handle
+{
+	Node*		base;
+	uint32_t	index;
+
+	index_handle() : base(0), index(Node::nil) {}
+	index_handle(int) : base(0), index(Node::nil) {}	//	the algorithms' null
+	index_handle(Node* b, uint32_t i) : base(b), index(i) {}
+
+	Node* operator->() const { return base + index; }
+	explicit operator bool() const { return index != Node::nil; }
+
+	friend bool operator==(const index_handle& lhs, const index_handle& rhs) { return lhs.index == rhs.index; }
+	friend bool operator!=(const index_handle& lhs, const index_handle& rhs) { return lhs.index != rhs.index; }
+};
+
+template<typename Node>
+struct index_node_traits
+{
+	typedef Node					node;
+	typedef index_handle<Node>		node_ptr;
+	typedef index_handle<Node>		const_node_ptr;
+
+	static const bool	threaded = false;
+	static const bool	augmented = false;
+
+	static void update(node_ptr) {}
+
+	static node_ptr get_parent(node_ptr n) { return node_ptr(n.base, n->parent()); }
+	static void set_parent(node_ptr n, node_ptr p) {
+		n->parent_color = p.index | (n->parent_color & Node::color_bit);
+	}
+	static eColor get_color(node_ptr n) { return n->parent_color & Node::color_bit ? BLACK : RED; }
+	static void set_color(node_ptr n, eColor c) {
+		n->parent_color = n->parent() | (c == BLACK ? Node::color_bit : 0);
+	}
+
+	static node_ptr get_left(node_ptr n) { return node_ptr(n.base, n->left); }
+	static void set_left(node_ptr n, node_ptr l) { n->left = l.index; }
+	static node_ptr get_left_thread(node_ptr) { return node_ptr(); }
+	static void set_left_thread(node_ptr n, node_ptr) { n->left = Node::nil; }
+
+	static node_ptr get_right(node_ptr n) { return node_ptr(n.base, n->right); }
+	static void set_right(node_ptr n, node_ptr r) { n->right = r.index; }
+	static node_ptr get_right_thread(node_ptr) { return node_ptr(); }
+	static void set_right_thread(node_ptr n, node_ptr) { n->right = Node::nil; }
+};
+
+/*
+ *	Index Iterator : pool and slot, so it survives the pool growing under it
+ */
+template<typename V, typename Pool, typename Ref, typename Ptr>
+struct index_iterator
+{
+	typedef V								value_type;
+	typedef Ptr								pointer;
+	typedef	Ref								reference;
+	typedef std::bidirectional_iterator_tag	iterator_category;
+	typedef ptrdiff_t						difference_type;
+
+	typedef index_iterator<V, Pool, V&, V*>	iterator;
+	typedef index_iterator					self;
+	typedef index_node<V>					node;
+	typedef rb_algorithms<index_node_traits<node> >	algorithms;
+
+	Pool*		pool;
+	uint32_t	index;
+
+	index_iterator() : pool(0), index(node::nil) {}
+	index_iterator(const Pool* p, uint32_t i) : pool(const_cast<Pool*>(p)), index(i) {}
+	//	mutable to const only ; a template, so copying keeps the implicit members
+	template<typename R, typename P>
+	index_iterator(const index_iterator<V, Pool, R, P>& it, typename enable_if<is_same<R, V&>::value>::type* = 0)
+	: pool(it.pool), index(it.index) {}
+
+	reference operator*() const { return (*pool)[index].value(); }
+	pointer operator->() const { return &(*pool)[index].value(); }
+
+	self& operator++() {
+		index = algorithms::increment(handle()).index;
+		return *this;
+	}
+	self operator++(int) {
+		self tmp = *this;
+		++*this;
+		return tmp;
+	}
+	self& operator--() {
+		index = algorithms::decrement(handle()).index;
+		return *this;
+	}
+	self operator--(int) {
+		self tmp = *this;
+		--*this;
+		return tmp;
+	}
+
+	bool operator==(const self& rhs) const { return index == rhs.index; }
+	bool operator!=(const self& rhs) const { return index != rhs.index; }
+
+private:
+	typename algorithms::node_ptr handle() const {
+		return typename algorithms::node_ptr(pool->data(), index);
+	}
+};
+
+template<typename V, typename Pool>
+bool operator==(const index_iterator<V, Pool, V&, V*>& lhs, const index_iterator<V, Pool, const V&, const V*>& rhs)
+{ return lhs.index == rhs.index; }
+template<typename V, typename Pool>
+bool operator!=(const index_iterator<V, Pool, V&, V*>& lhs, const index_iterator<V, Pool, const V&, const V*>& rhs)
+{ return lhs.index != rhs.index; }
+
+/*
+ *	Index Red Black Tree : the RbTree interface over a pool of index_node in an ft::vector.
+ *	Half the link size of the pointer tree, erased slots are recycled through a free list,
+ *	and for bitwise copyable values a whole tree copy is one buffer copy.
+ *	Iterators hold the pool : valid across inserts, not across swap.
+ */
+template<typename K, typename V, typename KV, typename Comp, typename Alloc = std::allocator<V> >
+class IndexRbTree
+{
+public:
+	typedef K					key_type;
+	typedef V					value_type;
+	typedef value_type*			pointer;
+	typedef const value_type*	const_pointer;
+	typedef value_type&			reference;
+	typedef const value_type&	const_reference;
+	typedef std::size_t			size_type;
+	typedef std::ptrdiff_t		difference_type;
+	typedef Alloc				allocator_type;
+	typedef void				aggregate_type;		//	no augmentation
+
+protected:
+	typedef index_node<V>											node_type;
+	typedef typename Alloc::template rebind<node_type>::other		node_allocator;
+	typedef ft::vector<node_type, node_allocator>					pool_type;
+	typedef index_node_traits<node_type>							node_traits;
+	typedef rb_algorithms<node_traits>								algorithms;
+	typedef typename node_traits::node_ptr							handle;
+
+	static const uint32_t	nil = node_type::nil;
+	static const bool		bitwise = is_bitwise_copyable<V>::value;
+
+public:
+	typedef index_iterator<V, pool_type, V&, V*>							iterator;
+	typedef index_iterator<V, pool_type, const V&, const V*>				const_iterator;
+	typedef ft::reverse_iterator<iterator>									reverse_iterator;
+	typedef ft::reverse_iterator<const_iterator>							const_reverse_iterator;
+
+protected:
+	Comp		comp;
+	pool_type	pool;
+	uint32_t	free_head;
+	size_type	count;
+
+	handle h(uint32_t i) { return handle(pool.data(), i); }
+	node_type& header() { return pool[0]; }
+	const node_type& header() const { return pool[0]; }
+	uint32_t root() const { return header().parent(); }
+	const K& key(uint32_t i) const { return KV()(pool[i].value()); }
+	bool live(uint32_t i) const { return i != 0 && pool[i].parent() != nil; }
+
+	void init()
+	{
+		node_type	head;
+		head.parent_color = nil;		//	red, no root
+		head.left = head.right = 0;
+		pool.push_back(head);
+		free_head = nil;
+		count = 0;
+	}
+
+	//	copy constructs every live value of src into the same slot of dst
+	static void copy_values(const pool_type& src, pool_type& dst)
+	{
+		uint32_t	i = 1;
+		try {
+			for (; i < src.size(); ++i)
+				if (src[i].parent() != nil) ::new (static_cast<void*>(dst[i].storage)) V(src[i].value());
+		}
+		catch (...) {
+			while (--i > 0)
+				if (src[i].parent() != nil) dst[i].value().~V();
+			throw ;
+		}
+	}
+
+	void destroy_values()
+	{
+		if (bitwise) return ;
+		for (uint32_t i = 1; i < pool.size(); ++i)
+			if (live(i)) pool[i].value().~V();
+	}
+
+	//	pool growth : slots move bytewise, values that need it are rebuilt in place
+	void grow()
+	{
+		if (pool.size() >= nil) throw std::length_error("IndexRbTree : too many nodes");
+		if (bitwise)
+		{
+			pool.reserve(pool.size() * 2);
+			return ;
+		}
+		pool_type	next(pool.get_allocator());
+		next.reserve(pool.size() * 2);
+		for (size_type i = 0; i < pool.size(); ++i) next.push_back(pool[i]);
+		copy_values(pool, next);
+		destroy_values();
+		pool.swap(next);
+	}
+
+	uint32_t acquire(const value_type& v)
+	{
+		uint32_t	i = free_head;
+
+		if (i == nil)
+		{
+			if (pool.size() == pool.capacity()) grow();
+			pool.push_back(node_type());
+			i = uint32_t(pool.size() - 1);
+		}
+		try {
+			::new (static_cast<void*>(pool[i].storage)) V(v);
+		}
+		catch (...) {
+			if (i != free_head) pool.pop_back();
+			throw ;
+		}
+		if (i == free_head) free_head = pool[i].left;
+		return i;
+	}
+
+	void release(uint32_t i)
+	{
+		pool[i].value().~V();
+		pool[i].parent_color = nil;
+		pool[i].left = free_head;
+		free_head = i;
+	}
+
+	iterator insert_at(uint32_t parent, bool insert_left, const value_type& v)
+	{
+		const uint32_t	i = acquire(v);
+
+		algorithms::insert_rebalance(insert_left, h(i), h(parent), h(0));
+		++count;
+		return iterator(&pool, i);
+	}
+
+	uint32_t increment(uint32_t i) { return algorithms::increment(h(i)).index; }
+	uint32_t decrement(uint32_t i) { return algorithms::decrement(h(i)).index; }
+
+	uint32_t lower(const key_type& k) const
+	{
+		uint32_t	x = root();
+		uint32_t	y = 0;
+
+		while (x != nil)
+		{
+			if (!comp(key(x), k))
+			{
+				y = x;
+				x = pool[x].left;
+			}
+			else x = pool[x].right;
+		}
+		return y;
+	}
+
+	template<typename KeyIter, typename OutIter, typename Iterator>
+	OutIter mbatch(KeyIter first, KeyIter last, OutIter out, bool exact, Iterator*) const
+	{
+		uint32_t			x[batch_group];
+		uint32_t			y[batch_group];
+		const key_type*		k[batch_group];
+
+		while (first != last)
+		{
+			size_type	n = 0;
+			for (; n < batch_group && first != last; ++n, ++first)
+			{
+				k[n] = &*first;
+				x[n] = root();
+				y[n] = 0;
+			}
+			for (bool active = true; active; )
+			{
+				active = false;
+				for (size_type i = 0; i < n; ++i)
+				{
+					if (x[i] == nil) continue;
+					if (!comp(key(x[i]), *k[i]))
+					{
+						y[i] = x[i];
+						x[i] = pool[x[i]].left;
+					}
+					else x[i] = pool[x[i]].right;
+					if (x[i] != nil)
+					{
+						prefetch_node(&pool[x[i]]);
+						active = true;
+					}
+				}
+			}
+			for (size_type i = 0; i < n; ++i, ++out)
+			{
+				if (exact && y[i] != 0 && comp(*k[i], key(y[i]))) y[i] = 0;
+				*out = Iterator(&pool, y[i]);
+			}
+		}
+		return out;
+	}
+
+	uint32_t upper(const key_type& k) const
+	{
+		uint32_t	x = root();
+		uint32_t	y = 0;
+
+		while (x != nil)
+		{
+			if (comp(k, key(x)))
+			{
+				y = x;
+				x = pool[x].left;
+			}
+			else x = pool[x].right;
+		}
+		return y;
+	}
+
+public:
+	IndexRbTree() : comp(), pool() { init(); }
+	IndexRbTree(const Comp& c) : comp(c), pool() { init(); }
+	IndexRbTree(const Comp& c, const allocator_type& alloc) : comp(c), pool(node_allocator(alloc)) { init(); }
+	IndexRbTree(const IndexRbTree& rhs)
+	: comp(rhs.comp), pool(rhs.pool), free_head(rhs.free_head), count(rhs.count)
+	{
+		if (!bitwise) copy_values(rhs.pool, pool);
+	}
+	~IndexRbTree() { destroy_values(); }
+
+	IndexRbTree& operator=(const IndexRbTree& rhs)
+	{
+		if (this == &rhs) return *this;
+		IndexRbTree	tmp(rhs);
+		swap(tmp);
+		return *this;
+	}
+
+	//	Access
+	Comp key_comp() const { return comp; }
+	allocator_type get_alloc() const { return allocator_type(pool.get_allocator()); }
+
+	iterator begin() { return iterator(&pool, header().left); }
+	const_iterator begin() const { return const_iterator(&pool, header().left); }
+	iterator end() { return iterator(&pool, 0); }
+	const_iterator end() const { return const_iterator(&pool, 0); }
+	reverse_iterator rbegin() { return reverse_iterator(end()); }
+	const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+	reverse_iterator rend() { return reverse_iterator(begin()); }
+	const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+	bool empty() const { return count == 0; }
+	size_type size() const { return count; }
+	size_type max_size() const { return nil - 1; }
+	//	slots in use or free, header included
+	size_type pool_size() const { return pool.size(); }
+
+	void swap(IndexRbTree& other)
+	{
+		pool.swap(other.pool);
+		std::swap(free_head, other.free_head);
+		std::swap(count, other.count);
+		std::swap(comp, other.comp);
+	}
+
+	/**
+	 * @brief Insert Erase Implementation
+	 */
+
+	ft::pair<iterator, bool> insert_unique(const value_type& v)
+	{
+		const K&	k = KV()(v);
+		uint32_t	x = root();
+		uint32_t	y = 0;
+		bool		less = true;
+
+		while (x != nil)
+		{
+			y = x;
+			less = comp(k, key(x));
+			x = less ? pool[x].left : pool[x].right;
+		}
+		uint32_t	j = y;
+		if (less)
+		{
+			if (j == header().left) return ft::pair<iterator, bool>(insert_at(y, true, v), true);
+			j = decrement(j);
+		}
+		if (comp(key(j), k)) return ft::pair<iterator, bool>(insert_at(y, y == 0 || less, v), true);
+		return ft::pair<iterator, bool>(iterator(&pool, j), false);
+	}
+
+	iterator insert_unique(const_iterator pos, const value_type& v)
+	{
+		const K&		k = KV()(v);
+		const uint32_t	p = pos.index;
+
+		if (p == 0)
+		{
+			if (count && comp(key(header().right), k)) return insert_at(header().right, false, v);
+		}
+		else if (comp(k, key(p)))
+		{
+			if (p == header().left) return insert_at(p, true, v);
+			const uint32_t	before = decrement(p);
+			if (comp(key(before), k))
+				return pool[before].right == nil ? insert_at(before, false, v) : insert_at(p, true, v);
+		}
+		else if (comp(key(p), k))
+		{
+			if (p == header().right) return insert_at(p, false, v);
+			const uint32_t	after = increment(p);
+			if (comp(k, key(after)))
+				return pool[p].right == nil ? insert_at(p, false, v) : insert_at(after, true, v);
+		}
+		else return iterator(&pool, p);
+		return insert_unique(v).first;
+	}
+
+	template<typename Iter>
+	void insert_unique(Iter first, Iter last)
+	{
+		for (; first != last; ++first) insert_unique(end(), *first);
+	}
+
+	void erase(const_iterator pos)
+	{
+		release(algorithms::rebalance_erase(h(pos.index), h(0)).index);
+		--count;
+	}
+
+	size_type erase(const key_type& k)
+	{
+		const_iterator	first(&pool, lower(k));
+		const_iterator	last(&pool, upper(k));
+		const size_type	before = size();
+		erase(first, last);
+		return before - size();
+	}
+
+	void erase(const_iterator first, const_iterator last)
+	{
+		if (first == begin() && last == end()) clear();
+		else
+			while (first != last) erase(first++);
+	}
+
+	void clear()
+	{
+		destroy_values();
+		pool.clear();
+		init();
+	}
+
+	iterator find(const key_type& k)
+	{
+		const uint32_t	y = lower(k);
+		return y == 0 || comp(k, key(y)) ? end() : iterator(&pool, y);
+	}
+	const_iterator find(const key_type& k) const
+	{
+		const uint32_t	y = lower(k);
+		return y == 0 || comp(k, key(y)) ? end() : const_iterator(&pool, y);
+	}
+
+	iterator lower_bound(const key_type& k) { return iterator(&pool, lower(k)); }
+	const_iterator lower_bound(const key_type& k) const { return const_iterator(&pool, lower(k)); }
+	iterator upper_bound(const key_type& k) { return iterator(&pool, upper(k)); }
+	const_iterator upper_bound(const key_type& k) const { return const_iterator(&pool, upper(k)); }
+
+	//	same contract as RbTree : batch_group searches in lock step, prefetching
+	static const size_type	batch_group = 32;
+
+	template<typename KeyIter, typename OutIter>
+	OutIter lower_bound_batch(KeyIter first, KeyIter last, OutIter out)
+	{ return mbatch(first, last, out, false, static_cast<iterator*>(0)); }
+	template<typename KeyIter, typename OutIter>
+	OutIter lower_bound_batch(KeyIter first, KeyIter last, OutIter out) const
+	{ return mbatch(first, last, out, false, static_cast<const_iterator*>(0)); }
+	template<typename KeyIter, typename OutIter>
+	OutIter find_batch(KeyIter first, KeyIter last, OutIter out)
+	{ return mbatch(first, last, out, true, static_cast<iterator*>(0)); }
+	template<typename KeyIter, typename OutIter>
+	OutIter find_batch(KeyIter first, KeyIter last, OutIter out) const
+	{ return mbatch(first, last, out, true, static_cast<const_iterator*>(0)); }
+
+	pair<iterator, iterator> equal_range(const key_type& k)
+	{ return pair<iterator, iterator>(lower_bound(k), upper_bound(k)); }
+	pair<const_iterator, const_iterator> equal_range(const key_type& k) const
+	{ return pair<const_iterator, const_iterator>(lower_bound(k), upper_bound(k)); }
+};
+
+template <typename K, typename V, typename KV, typename Comp, typename Alloc>
+bool operator==(const IndexRbTree<K, V, KV, Comp, Alloc>& lhs,
+				const IndexRbTree<K, V, KV, Comp, Alloc>& rhs)
+{ return lhs.size() == rhs.size() && ft::equal(lhs.begin(), lhs.end(), rhs.begin()); }
+
+template <typename K, typename V, typename KV, typename Comp, typename Alloc>
+bool operator<(const IndexRbTree<K, V, KV, Comp, Alloc>& lhs,
+				const IndexRbTree<K, V, KV, Comp, Alloc>& rhs)
+{ return ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()); }
+
+/*
+ *	Tree policy for map / set : ft::map<K, T, Comp, Alloc, ft::index_tree>
+ */
+struct index_tree
+{
+	template<typename K, typename V, typename KV, typename Comp, typename Alloc>
+	struct rebind { typedef IndexRbTree<K, V, KV, Comp, Alloc> other; };
+};
+
+}	//	FT
+
+#endif
@@ -0,0 +1,206 @@
+#ifndef INTERVAL_MAP_HPP
+# define INTERVAL_MAP_HPP
+
+#include "rbtree.hpp"
+
+#include <functional>
+#include <memory>
+
+namespace ft
+{
+
+/*
+ *	Interval : half open [lo, hi), empty when hi <= lo
+ */
+template<typename K>
+struct interval
+{
+	typedef K	value_type;
+
+	K	lo;
+	K	hi;
+
+	interval() : lo(), hi() {}
+	interval(const K& l, const K& h) : lo(l), hi(h) {}
+};
+
+template<typename K>
+bool operator==(const interval<K>& lhs, const interval<K>& rhs) { return lhs.lo == rhs.lo && lhs.hi == rhs.hi; }
+template<typename K>
+bool operator!=(const interval<K>& lhs, const interval<K>& rhs) { return !(lhs == rhs); }
+
+//	by start, then end
+template<typename K, typename Comp>
+struct interval_less
+{
+	Comp	comp;
+
+	interval_less(const Comp& c = Comp()) : comp(c) {}
+	bool operator()(const interval<K>& a, const interval<K>& b) const {
+		return comp(a.lo, b.lo) || (!comp(b.lo, a.lo) && comp(a.hi, b.hi));
+	}
+};
+
+//	only ever folded over non empty subtrees : the identity is never read
+template<typename K, typename Comp>
+struct max_end_monoid
+{
+	typedef K	value_type;
+	K identity() const { return K(); }
+	K operator()(const K& a, const K& b) const { return Comp()(a, b) ? b : a; }
+};
+
+template<typename V>
+struct interval_end
+{
+	const typename V::first_type::value_type& operator()(const V& v) const { return v.first.hi; }
+};
+
+/*
+ *	Interval Tree : RbTree ordered by start, each node keeping the greatest end
+ *	of its subtree. A search skips every subtree ending at or before the query,
+ *	and everything right of the first start past it.
+ */
+template<typename K, typename T, typename Comp, typename Alloc>
+class interval_tree
+: public RbTree<interval<K>, pair<const interval<K>, T>, Select1st<pair<const interval<K>, T> >,
+				interval_less<K, Comp>, Alloc,
+				augment_policy<max_end_monoid<K, Comp>, interval_end<pair<const interval<K>, T> > > >
+{
+	typedef RbTree<interval<K>, pair<const interval<K>, T>, Select1st<pair<const interval<K>, T> >,
+				   interval_less<K, Comp>, Alloc,
+				   augment_policy<max_end_monoid<K, Comp>, interval_end<pair<const interval<K>, T> > > >	base;
+	typedef typename base::const_node_ptr		const_node_ptr;
+	typedef typename base::node_traits			node_traits;
+
+	const Comp& comp() const { return this->impl.keyCompare.comp; }
+
+	static const K& max_end(const_node_ptr x) { return static_cast<typename base::const_link_type>(x)->aggregate; }
+
+	//	closed : the query is the point lo == hi, matched by lo <= start
+	template<typename OutIter, typename Iterator>
+	void visit(const_node_ptr x, const K& lo, const K& hi, bool closed, OutIter& out, Iterator*) const
+	{
+		while (x && comp()(lo, max_end(x)))
+		{
+			visit(node_traits::get_left(x), lo, hi, closed, out, static_cast<Iterator*>(0));
+
+			const interval<K>&	i = base::getKey(x);
+			if (closed ? comp()(hi, i.lo) : !comp()(i.lo, hi)) return ;
+			if (comp()(lo, i.hi) && comp()(i.lo, i.hi))
+			{
+				*out = Iterator(static_cast<typename base::link_type>(const_cast<typename base::node_ptr>(x)));
+				++out;
+			}
+			x = node_traits::get_right(x);
+		}
+	}
+
+public:
+	typedef typename base::iterator			iterator;
+	typedef typename base::const_iterator	const_iterator;
+
+	interval_tree(const Comp& comp, const Alloc& alloc) : base(interval_less<K, Comp>(comp), alloc) {}
+
+	template<typename OutIter, typename Iterator>
+	OutIter overlapping(const K& lo, const K& hi, bool closed, OutIter out, Iterator*) const
+	{
+		if (closed || comp()(lo, hi)) visit(this->root(), lo, hi, closed, out, static_cast<Iterator*>(0));
+		return out;
+	}
+};
+
+/*
+ *	Interval Map : values keyed by half open intervals, which may overlap or repeat.
+ *	Iterates by start, then end. Overlap queries write an iterator per match, in
+ *	that order, visiting O(log n + k log(n / k)) nodes for k matches.
+ *	Comp must be default constructible : the subtree maxima are kept with Comp().
+ */
+template<typename K, typename T, typename Comp = std::less<K>,
+		typename Alloc = std::allocator<pair<const interval<K>, T> > >
+class interval_map
+{
+public:
+	typedef K										point_type;
+	typedef interval<K>								key_type;
+	typedef T										mapped_type;
+	typedef pair<const interval<K>, T>				value_type;
+	typedef Comp									point_compare;
+	typedef Alloc									allocator_type;
+
+private:
+	typedef typename Alloc::template rebind<value_type>::other		pair_alloc_type;
+	typedef interval_tree<K, T, Comp, pair_alloc_type>				rep_type;
+	rep_type	rep;
+
+public:
+	typedef typename rep_type::iterator					iterator;
+	typedef typename rep_type::const_iterator			const_iterator;
+	typedef typename rep_type::reverse_iterator			reverse_iterator;
+	typedef typename rep_type::const_reverse_iterator	const_reverse_iterator;
+	typedef typename rep_type::size_type				size_type;
+	typedef typename rep_type::difference_type			difference_type;
+
+	explicit interval_map(const Comp& comp = Comp(), const allocator_type& alloc = allocator_type())
+	: rep(comp, alloc) {}
+	template<typename Iter>
+	interval_map(Iter first, Iter last, const Comp& comp = Comp(), const allocator_type& alloc = allocator_type())
+	: rep(comp, alloc) { insert(first, last); }
+
+	allocator_type get_allocator() const { return rep.get_alloc(); }
+
+	iterator begin() { return rep.begin(); }
+	const_iterator begin() const { return rep.begin(); }
+	iterator end() { return rep.end(); }
+	const_iterator end() const { return rep.end(); }
+	reverse_iterator rbegin() { return rep.rbegin(); }
+	const_reverse_iterator rbegin() const { return rep.rbegin(); }
+	reverse_iterator rend() { return rep.rend(); }
+	const_reverse_iterator rend() const { return rep.rend(); }
+
+	bool empty() const { return rep.empty(); }
+	size_type size() const { return rep.size(); }
+	size_type max_size() const { return rep.max_size(); }
+
+	iterator insert(const value_type& v) { return rep.insert_equal(v); }
+	iterator insert(const K& lo, const K& hi, const T& v) { return rep.insert_equal(value_type(key_type(lo, hi), v)); }
+	template<typename Iter>
+	void insert(Iter first, Iter last) { for (; first != last; ++first) rep.insert_equal(*first); }
+
+	void erase(iterator pos) { rep.erase(pos); }
+	size_type erase(const key_type& k) { return rep.erase(k); }
+	void erase(iterator first, iterator last) { rep.erase(first, last); }
+
+	void swap(interval_map& rhs) { rep.swap(rhs.rep); }
+	void clear() { rep.clear(); }
+	//	n values from first sorted by start then end, O(n) instead of n inserts
+	template<typename Iter>
+	void assign_sorted(Iter first, size_type n) { rep.assign_sorted(first, n); }
+
+	iterator find(const key_type& k) { return rep.find(k); }
+	const_iterator find(const key_type& k) const { return rep.find(k); }
+	size_type count(const key_type& k) const { return rep.count(k); }
+
+	//	the intervals containing p : lo <= p < hi, so never an empty one
+	template<typename OutIter>
+	OutIter overlapping(const K& p, OutIter out)
+	{ return rep.overlapping(p, p, true, out, static_cast<iterator*>(0)); }
+	template<typename OutIter>
+	OutIter overlapping(const K& p, OutIter out) const
+	{ return rep.overlapping(p, p, true, out, static_cast<const_iterator*>(0)); }
+
+	//	the intervals sharing a point with [lo, hi) : none when either is empty
+	template<typename OutIter>
+	OutIter overlapping(const K& lo, const K& hi, OutIter out)
+	{ return rep.overlapping(lo, hi, false, out, static_cast<iterator*>(0)); }
+	template<typename OutIter>
+	OutIter overlapping(const K& lo, const K& hi, OutIter out) const
+	{ return rep.overlapping(lo, hi, false, out, static_cast<const_iterator*>(0)); }
+};
+
+template<typename K, typename T, typename Comp, typename Alloc>
+void swap(interval_map<K, T, Comp, Alloc>& lhs, interval_map<K, T, Comp, Alloc>& rhs) { lhs.swap(rhs); }
+
+}	//	FT
+
+#endif
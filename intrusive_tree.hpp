@@ -0,0 +1,247 @@
+#ifndef INTRUSIVE_TREE_HPP
+# define INTRUSIVE_TREE_HPP
+
+#include "rbtree.hpp"
+
+#include <cstddef>
+#include <functional>
+
+namespace ft
+{
+
+/*
+ *	Intrusive Iterator : walks the hooks, dereferences to the objects holding them
+ */
+template<typename T, tree_node T::* Hook>
+struct intrusive_iterator
+{
+	typedef T								value_type;
+	typedef T*								pointer;
+	typedef T&								reference;
+	typedef std::bidirectional_iterator_tag	iterator_category;
+	typedef ptrdiff_t						difference_type;
+	typedef intrusive_iterator				self;
+
+	tree_node*	node;
+
+	//	byte offset of the hook inside T
+	static std::ptrdiff_t hook_offset() {
+		alignas(T) static const unsigned char	probe[sizeof(T)] = {};
+		const T* const						owner = reinterpret_cast<const T*>(probe);
+		return reinterpret_cast<const char*>(&(owner->*Hook)) - reinterpret_cast<const char*>(owner);
+	}
+	static T* owner(tree_node* hook) { return reinterpret_cast<T*>(reinterpret_cast<char*>(hook) - hook_offset()); }
+
+	intrusive_iterator() : node(0) {}
+	explicit intrusive_iterator(tree_node* n) : node(n) {}
+
+	reference operator*() const { return *owner(node); }
+	pointer operator->() const { return owner(node); }
+
+	self& operator++() {
+		node = tree_increment(node);
+		return *this;
+	}
+	self operator++(int) {
+		self tmp = *this;
+		node = tree_increment(node);
+		return tmp;
+	}
+	self& operator--() {
+		node = tree_decrement(node);
+		return *this;
+	}
+	self operator--(int) {
+		self tmp = *this;
+		node = tree_decrement(node);
+		return tmp;
+	}
+
+	bool operator==(const self& rhs) const { return node == rhs.node; }
+	bool operator!=(const self& rhs) const { return node != rhs.node; }
+};
+
+/*
+ *	Intrusive Tree : indexes objects the caller owns, through the tree_node
+ *	member Hook they embed, so it never allocates. KeyOf()(obj) is the key.
+ *	An object sits in at most one tree per hook and must stay put while linked,
+ *	and its key must not change : erase, update, insert again.
+ *	Dropping the tree (or clear()) only forgets the objects, it never touches them.
+ */
+template<typename T, typename K, typename KeyOf, tree_node T::* Hook, typename Comp = std::less<K> >
+class intrusive_tree
+{
+public:
+	typedef T										value_type;
+	typedef K										key_type;
+	typedef Comp									key_compare;
+	typedef std::size_t								size_type;
+	typedef intrusive_iterator<T, Hook>				iterator;
+	typedef ft::reverse_iterator<iterator>			reverse_iterator;
+
+private:
+	typedef tree_node_traits	node_traits;
+
+	Comp		comp;
+	tree_node	header;
+	size_type	items;
+
+	intrusive_tree(const intrusive_tree&);
+	intrusive_tree& operator=(const intrusive_tree&);
+
+	static tree_node* hook(T& obj) { return &(obj.*Hook); }
+	static const K& key(tree_node* x) { return KeyOf()(*iterator::owner(x)); }
+
+	tree_node* root() const { return node_traits::get_parent(&header); }
+
+	void reset() {
+		node_traits::set_color(&header, RED);
+		node_traits::set_parent(&header, 0);
+		header.left = header.right = &header;
+		items = 0;
+	}
+
+	iterator link(tree_node* parent, bool left, T& obj) {
+		tree_node* const	z = hook(obj);
+
+		insert_rebalance(left || parent == &header, z, parent, header);
+		++items;
+		return iterator(z);
+	}
+
+	//	points root and extreme threads back at this header, after the nodes changed hands
+	void link_header() {
+		if (root() == 0) {
+			header.left = header.right = &header;
+			return ;
+		}
+		node_traits::set_parent(root(), &header);
+		node_traits::set_left_thread(header.left, &header);
+		node_traits::set_right_thread(header.right, &header);
+	}
+
+public:
+	explicit intrusive_tree(const Comp& c = Comp()) : comp(c), header() { reset(); }
+
+	iterator begin() const { return iterator(header.left); }
+	iterator end() const { return iterator(const_cast<tree_node*>(&header)); }
+	reverse_iterator rbegin() const { return reverse_iterator(end()); }
+	reverse_iterator rend() const { return reverse_iterator(begin()); }
+
+	bool empty() const { return items == 0; }
+	size_type size() const { return items; }
+	key_compare key_comp() const { return comp; }
+
+	//	obj must be linked in this tree
+	static iterator iterator_to(T& obj) { return iterator(hook(obj)); }
+
+	//	links obj unless an object with its key is there : that one is returned
+	pair<iterator, bool> insert(T& obj) {
+		const K&	k = KeyOf()(obj);
+		tree_node*	x = root();
+		tree_node*	y = &header;
+		bool		less = true;
+
+		while (x) {
+			y = x;
+			less = comp(k, key(x));
+			x = less ? node_traits::get_left(x) : node_traits::get_right(x);
+		}
+		iterator	it(y);
+		if (less) {
+			if (it == begin()) return pair<iterator, bool>(link(y, true, obj), true);
+			--it;
+		}
+		if (comp(key(it.node), k)) return pair<iterator, bool>(link(y, less, obj), true);
+		return pair<iterator, bool>(it, false);
+	}
+
+	//	links obj after every object with an equal key
+	iterator insert_equal(T& obj) {
+		const K&	k = KeyOf()(obj);
+		tree_node*	x = root();
+		tree_node*	y = &header;
+		bool		less = true;
+
+		while (x) {
+			y = x;
+			less = comp(k, key(x));
+			x = less ? node_traits::get_left(x) : node_traits::get_right(x);
+		}
+		return link(y, less, obj);
+	}
+
+	void erase(iterator pos) {
+		rebalance_erase(pos.node, header);
+		--items;
+	}
+	void erase(T& obj) { erase(iterator_to(obj)); }
+	size_type erase(const K& k) {
+		iterator	first = lower_bound(k);
+		iterator	last = upper_bound(k);
+		size_type	n = 0;
+
+		while (first != last) {
+			erase(first++);
+			++n;
+		}
+		return n;
+	}
+
+	void clear() { reset(); }
+
+	void swap(intrusive_tree& other) {
+		tree_node* const	r = root();
+		node_traits::set_parent(&header, other.root());
+		node_traits::set_parent(&other.header, r);
+		std::swap(header.left, other.header.left);
+		std::swap(header.right, other.header.right);
+		link_header();
+		other.link_header();
+		std::swap(items, other.items);
+		std::swap(comp, other.comp);
+	}
+
+	iterator lower_bound(const K& k) const {
+		tree_node*	x = root();
+		tree_node*	y = const_cast<tree_node*>(&header);
+
+		while (x) {
+			if (!comp(key(x), k)) {
+				y = x;
+				x = node_traits::get_left(x);
+			}
+			else x = node_traits::get_right(x);
+		}
+		return iterator(y);
+	}
+
+	iterator upper_bound(const K& k) const {
+		tree_node*	x = root();
+		tree_node*	y = const_cast<tree_node*>(&header);
+
+		while (x) {
+			if (comp(k, key(x))) {
+				y = x;
+				x = node_traits::get_left(x);
+			}
+			else x = node_traits::get_right(x);
+		}
+		return iterator(y);
+	}
+
+	iterator find(const K& k) const {
+		const iterator	it = lower_bound(k);
+		return it == end() || comp(k, key(it.node)) ? end() : it;
+	}
+
+	size_type count(const K& k) const {
+		size_type	n = 0;
+		for (iterator it = lower_bound(k), last = upper_bound(k); it != last; ++it) ++n;
+		return n;
+	}
+};
+
+}	//	FT
+
+#endif
@@ -113,6 +113,28 @@ protected:
 		return lhs.base() - rhs.base();
 	}
 
+/*
+ *	Contiguous Iterator
+ *	pointer, random_access_iterator : elements are laid out back to back,
+ *	so the range can be handed to mem* functions through address()
+ */
+template <typename Iter>
+struct contiguous_iterator : public false_type {};
+
+template <typename T>
+struct contiguous_iterator<T*> : public true_type
+{
+	typedef typename remove_cv<T>::type	value_type;
+	static T* address(T* it) { return it; }
+};
+
+template <typename T>
+struct contiguous_iterator<random_access_iterator<T> > : public true_type
+{
+	typedef typename remove_cv<T>::type	value_type;
+	static T* address(const random_access_iterator<T>& it) { return it.base(); }
+};
+
 /*
  * 	Reverse Iterator
  */
@@ -0,0 +1,342 @@
+#ifndef LRU_CACHE_HPP
+# define LRU_CACHE_HPP
+
+#include "rbtree.hpp"
+
+#include <functional>
+#include <memory>
+#include <new>
+#include <stdexcept>
+
+#include <stdint.h>
+
+namespace ft
+{
+
+/*
+ *	Recency Links : an intrusive circular list around a sentinel,
+ *	most recent entry at sentinel.next, least recent at sentinel.prev
+ */
+struct lru_links
+{
+	lru_links*	prev;
+	lru_links*	next;
+
+	lru_links() : prev(this), next(this) {}
+
+	void unlink() {
+		prev->next = next;
+		next->prev = prev;
+	}
+	void link_after(lru_links* pos) {
+		prev = pos;
+		next = pos->next;
+		pos->next->prev = this;
+		pos->next = this;
+	}
+	//	to the front of the list whose sentinel is head
+	void touch(lru_links* head) {
+		if (head->next == this) return ;
+		unlink();
+		link_after(head);
+	}
+};
+
+/*
+ *	LRU Cache : at most capacity entries, the least recently used one evicted
+ *	to make room. Entries are hashed into a bucket array sized for the capacity
+ *	once, so it never rehashes. One allocation per entry : the node carries the
+ *	bucket chain, the recency links and the value.
+ *	get() and put() make an entry the most recent, peek() and contains() do not.
+ *	The eviction callback sees each entry pushed out by put(), before it is destroyed.
+ */
+template<typename K, typename V, typename Hash = std::hash<K>, typename Equal = std::equal_to<K>,
+		typename Alloc = std::allocator<pair<const K, V> > >
+class lru_cache
+{
+public:
+	typedef K										key_type;
+	typedef V										mapped_type;
+	typedef pair<const K, V>						value_type;
+	typedef std::size_t								size_type;
+	typedef Hash									hasher;
+	typedef Equal									key_equal;
+	typedef Alloc									allocator_type;
+	typedef std::function<void(const K&, V&)>		eviction_callback;
+
+private:
+	struct node : public lru_links
+	{
+		node*		chain;
+		value_type	value;
+
+		node(const value_type& v) : chain(0), value(v) {}
+	};
+
+	typedef typename Alloc::template rebind<node>::other	node_allocator;
+	typedef typename Alloc::template rebind<node*>::other	bucket_allocator;
+
+	node_allocator		alloc;
+	node**				buckets;
+	unsigned			shift;		//	bucket index : the top bits of the mixed hash
+	size_type			bucket_count;
+	lru_links			recency;
+	size_type			count;
+	size_type			cap;
+	Hash				hash;
+	Equal				equal;
+	eviction_callback	evicted;
+
+	lru_cache(const lru_cache&);
+	lru_cache& operator=(const lru_cache&);
+
+	static node* entry(lru_links* l) { return static_cast<node*>(l); }
+
+	node** bucket(const K& k) const {
+		const uint64_t	h = uint64_t(hash(k)) * 0x9e3779b97f4a7c15ULL;
+		return buckets + (shift < 64 ? size_type(h >> shift) : 0);
+	}
+
+	//	the link pointing at k's node, or at the null ending its chain
+	node** locate(const K& k) const {
+		node**	link = bucket(k);
+		while (*link && !equal((*link)->value.first, k)) link = &(*link)->chain;
+		return link;
+	}
+
+	void destroy(node* n) {
+		alloc.destroy(n);
+		alloc.deallocate(n, 1);
+	}
+
+	void evict_oldest() {
+		node* const	n = entry(recency.prev);
+		node**		link = locate(n->value.first);
+
+		*link = n->chain;
+		n->unlink();
+		--count;
+		if (evicted) {
+			try {
+				evicted(n->value.first, n->value.second);
+			}
+			catch (...) {
+				destroy(n);
+				throw ;
+			}
+		}
+		destroy(n);
+	}
+
+public:
+	explicit lru_cache(size_type capacity, const eviction_callback& on_evict = eviction_callback(),
+					   const Hash& h = Hash(), const Equal& eq = Equal(), const allocator_type& a = allocator_type())
+	: alloc(a), buckets(0), shift(64), bucket_count(1), count(0), cap(capacity), hash(h), equal(eq), evicted(on_evict)
+	{
+		if (capacity == 0) throw std::invalid_argument("lru_cache : zero capacity");
+		while (bucket_count < capacity) {
+			bucket_count <<= 1;
+			--shift;
+		}
+		buckets = bucket_allocator(alloc).allocate(bucket_count);
+		for (size_type i = 0; i < bucket_count; ++i) buckets[i] = 0;
+	}
+
+	~lru_cache() {
+		clear();
+		bucket_allocator(alloc).deallocate(buckets, bucket_count);
+	}
+
+	size_type size() const { return count; }
+	size_type capacity() const { return cap; }
+	bool empty() const { return count == 0; }
+
+	void set_eviction_callback(const eviction_callback& on_evict) { evicted = on_evict; }
+
+	//	the value of k made most recent, null on a miss
+	V* get(const K& k) {
+		node* const	n = *locate(k);
+		if (n == 0) return 0;
+		n->touch(&recency);
+		return &n->value.second;
+	}
+
+	const V* peek(const K& k) const {
+		node* const	n = *locate(k);
+		return n ? &n->value.second : 0;
+	}
+	bool contains(const K& k) const { return *locate(k) != 0; }
+
+	//	inserts or overwrites k, most recent either way : true when it was not cached
+	bool put(const K& k, const V& v) {
+		node**	link = locate(k);
+
+		if (*link) {
+			(*link)->value.second = v;
+			(*link)->touch(&recency);
+			return false;
+		}
+		node* const	n = alloc.allocate(1);
+		try {
+			alloc.construct(n, value_type(k, v));
+		}
+		catch (...) {
+			alloc.deallocate(n, 1);
+			throw ;
+		}
+		*link = n;
+		n->link_after(&recency);
+		if (++count > cap) evict_oldest();
+		return true;
+	}
+
+	bool erase(const K& k) {
+		node**		link = locate(k);
+		node* const	n = *link;
+
+		if (n == 0) return false;
+		*link = n->chain;
+		n->unlink();
+		--count;
+		destroy(n);
+		return true;
+	}
+
+	//	drops every entry without calling the eviction callback
+	void clear() {
+		for (lru_links* l = recency.next; l != &recency; ) {
+			node* const	n = entry(l);
+			l = l->next;
+			destroy(n);
+		}
+		recency.prev = recency.next = &recency;
+		for (size_type i = 0; i < bucket_count; ++i) buckets[i] = 0;
+		count = 0;
+	}
+};
+
+template<typename V>
+struct recency_node : public rb_node<V>, public lru_links {};
+
+//	Node policy of RbTree : recency links inside the tree node
+struct recency_policy : public plain_node_policy
+{
+	template<typename V> struct node { typedef recency_node<V> type; };
+};
+
+/*
+ *	Ordered LRU Cache : the same contract over an RbTree whose nodes carry the
+ *	recency links, so the entries can also be walked in key order.
+ *	Walking and bounds do not count as uses.
+ */
+template<typename K, typename V, typename Comp = std::less<K>, typename Alloc = std::allocator<pair<const K, V> > >
+class ordered_lru_cache
+{
+public:
+	typedef K										key_type;
+	typedef V										mapped_type;
+	typedef pair<const K, V>						value_type;
+	typedef Comp									key_compare;
+	typedef Alloc									allocator_type;
+	typedef std::function<void(const K&, V&)>		eviction_callback;
+
+private:
+	typedef typename Alloc::template rebind<value_type>::other		pair_alloc_type;
+	typedef RbTree<K, value_type, Select1st<value_type>, Comp, pair_alloc_type, recency_policy>	rep_type;
+	typedef typename rep_type::link_type							link_type;
+
+	rep_type			rep;
+	lru_links			recency;
+	typename rep_type::size_type	cap;
+	eviction_callback	evicted;
+
+	ordered_lru_cache(const ordered_lru_cache&);
+	ordered_lru_cache& operator=(const ordered_lru_cache&);
+
+	static link_type entry(lru_links* l) { return static_cast<link_type>(l); }
+	static link_type entry(typename rep_type::iterator it) { return static_cast<link_type>(it.node); }
+
+	void evict_oldest() {
+		const link_type	n = entry(recency.prev);
+
+		n->unlink();
+		if (evicted) {
+			try {
+				evicted(n->value.first, n->value.second);
+			}
+			catch (...) {
+				rep.erase(typename rep_type::iterator(n));
+				throw ;
+			}
+		}
+		rep.erase(typename rep_type::iterator(n));
+	}
+
+public:
+	typedef typename rep_type::const_iterator		const_iterator;
+	typedef typename rep_type::size_type			size_type;
+
+	explicit ordered_lru_cache(size_type capacity, const eviction_callback& on_evict = eviction_callback(),
+							   const Comp& comp = Comp(), const allocator_type& alloc = allocator_type())
+	: rep(comp, alloc), cap(capacity), evicted(on_evict)
+	{
+		if (capacity == 0) throw std::invalid_argument("ordered_lru_cache : zero capacity");
+	}
+
+	size_type size() const { return rep.size(); }
+	size_type capacity() const { return cap; }
+	bool empty() const { return rep.empty(); }
+
+	void set_eviction_callback(const eviction_callback& on_evict) { evicted = on_evict; }
+
+	V* get(const K& k) {
+		typename rep_type::iterator	it = rep.find(k);
+		if (it == rep.end()) return 0;
+		entry(it)->touch(&recency);
+		return &it->second;
+	}
+
+	const V* peek(const K& k) const {
+		const_iterator	it = rep.find(k);
+		return it == rep.end() ? 0 : &it->second;
+	}
+	bool contains(const K& k) const { return rep.find(k) != rep.end(); }
+
+	bool put(const K& k, const V& v) {
+		pair<typename rep_type::iterator, bool>	r = rep.insert_unique(value_type(k, v));
+		const link_type	n = entry(r.first);
+
+		if (!r.second) {
+			n->value.second = v;
+			n->touch(&recency);
+			return false;
+		}
+		n->link_after(&recency);
+		if (rep.size() > cap) evict_oldest();
+		return true;
+	}
+
+	bool erase(const K& k) {
+		typename rep_type::iterator	it = rep.find(k);
+
+		if (it == rep.end()) return false;
+		entry(it)->unlink();
+		rep.erase(it);
+		return true;
+	}
+
+	void clear() {
+		rep.clear();
+		recency.prev = recency.next = &recency;
+	}
+
+	//	key order
+	const_iterator begin() const { return rep.begin(); }
+	const_iterator end() const { return rep.end(); }
+	const_iterator lower_bound(const K& k) const { return rep.lower_bound(k); }
+	const_iterator upper_bound(const K& k) const { return rep.upper_bound(k); }
+};
+
+}	//	FT
+
+#endif
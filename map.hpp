@@ -5,7 +5,8 @@
 
 namespace ft
 {
-template<typename K, typename T, typename Comp = std::less<K>, typename _Alloc = std::allocator<pair<const K, T> > >
+template<typename K, typename T, typename Comp = std::less<K>, typename _Alloc = std::allocator<pair<const K, T> >,
+		typename Tree = pointer_tree>
 class map
 {
 private:
@@ -23,7 +24,7 @@ private:
 public:
 	class value_compare : public std::binary_function<value_type, value_type, bool>
 	{
-		friend class map<K, T, Comp, _Alloc>;
+		friend class map<K, T, Comp, _Alloc, Tree>;
 
 	protected:
 		Comp	comp;
@@ -34,24 +35,30 @@ public:
 
 private:
 	typedef typename _Alloc::template rebind<value_type>::other									pair_alloc_type;
-	typedef RbTree<key_type, value_type, Select1st<value_type>, key_compare, pair_alloc_type>	rep_type;
+	typedef typename Tree::template rebind<key_type, value_type, Select1st<value_type>,
+											key_compare, pair_alloc_type>::other		rep_type;
 
 	rep_type	rep;
 
+	//	subtree aggregates cache the mapped values : those change through update() only
+	static const bool	augmented = !is_same<typename rep_type::aggregate_type, void>::value;
+
 public:
 	typedef typename pair_alloc_type::pointer			pointer;
 	typedef typename pair_alloc_type::const_pointer		const_pointer;
 	typedef typename pair_alloc_type::reference			reference;
 	typedef typename pair_alloc_type::const_reference	const_reference;
-	typedef typename rep_type::iterator					iterator;
+	typedef typename conditional<augmented, typename rep_type::const_iterator,
+								typename rep_type::iterator>::type			iterator;
 	typedef typename rep_type::const_iterator			const_iterator;
 	typedef typename rep_type::size_type				size_type;
 	typedef typename rep_type::difference_type			difference_type;
-	typedef typename rep_type::reverse_iterator			reverse_iterator;
+	typedef ft::reverse_iterator<iterator>				reverse_iterator;
 	typedef typename rep_type::const_reverse_iterator	const_reverse_iterator;
 
 	map() : rep(Comp(), allocator_type()) {}
 	explicit map(const Comp& comp, const allocator_type& alloc = allocator_type()) : rep(comp, alloc) {}
+	explicit map(const allocator_type& alloc) : rep(Comp(), alloc) {}
 	map(const map& ref) : rep(ref.rep) {}
 	template <typename Iter>
 	map(Iter first, Iter last) : rep(Comp(), allocator_type()) { rep.insert_unique(first, last); }
@@ -67,9 +74,9 @@ public:
 	const_iterator begin() const { return rep.begin(); }
 	iterator end() { return rep.end(); }
 	const_iterator end() const { return rep.end(); }
-	reverse_iterator rbegin() { return rep.rbegin(); }
+	reverse_iterator rbegin() { return reverse_iterator(end()); }
 	const_reverse_iterator rbegin() const { return rep.rbegin(); }
-	reverse_iterator rend() { return rep.rend(); }
+	reverse_iterator rend() { return reverse_iterator(begin()); }
 	const_reverse_iterator rend() const { return rep.rend(); }
 
 	bool empty() const { return rep.empty(); }
@@ -78,6 +85,7 @@ public:
 
 	mapped_type& operator[](const key_type& key)
 	{
+		static_assert(!augmented, "augmented_tree map : write mapped values with update()");
 		iterator	it = lower_bound(key);
 
 		if (it == end() || key_comp()(key, it->first))
@@ -86,6 +94,7 @@ public:
 	}
 	mapped_type& at(const key_type& key)
 	{
+		static_assert(!augmented, "augmented_tree map : write mapped values with update()");
 		iterator	it = lower_bound(key);
 
 		if (it == end() || key_comp()(key, it->first))
@@ -112,6 +121,9 @@ public:
 
 	void swap(map& rhs) { rep.swap(rhs.rep); }
 	void clear() { rep.clear(); }
+	//	n strictly increasing values from first, O(n) instead of n inserts
+	template<typename Iter>
+	void assign_sorted(Iter first, size_type n) { rep.assign_sorted(first, n); }
 
 	key_compare key_comp() const { return rep.key_comp(); }
 	value_compare value_comp() const { return value_compare(rep.key_comp()); }
@@ -125,43 +137,76 @@ public:
 	iterator upper_bound(const key_type& key) { return rep.upper_bound(key); }
 	const_iterator upper_bound(const key_type& key) const { return rep.upper_bound(key); }
 
+	//	one iterator per key of the forward range [first, last), the searches interleaved
+	template<typename KeyIter, typename OutIter>
+	OutIter find_batch(KeyIter first, KeyIter last, OutIter out) { return rep.find_batch(first, last, out); }
+	template<typename KeyIter, typename OutIter>
+	OutIter find_batch(KeyIter first, KeyIter last, OutIter out) const { return rep.find_batch(first, last, out); }
+	template<typename KeyIter, typename OutIter>
+	OutIter lower_bound_batch(KeyIter first, KeyIter last, OutIter out) { return rep.lower_bound_batch(first, last, out); }
+	template<typename KeyIter, typename OutIter>
+	OutIter lower_bound_batch(KeyIter first, KeyIter last, OutIter out) const
+	{ return rep.lower_bound_batch(first, last, out); }
+
+	/*
+	 *	augmented_tree only : the monoid over the mapped values of keys in [lo, hi), in O(log n).
+	 *	Iterators are read only and operator[] / at() do not compile on such a map :
+	 *	update() writes a mapped value and refreshes the aggregates above it.
+	 */
+	typename rep_type::aggregate_type aggregate(const key_type& lo, const key_type& hi) const
+	{ return rep.aggregate(lo, hi); }
+	typename rep_type::aggregate_type aggregate() const { return rep.aggregate(); }
+
+	//	key's mapped value set to value, inserted if missing
+	iterator update(const key_type& key, const mapped_type& value)
+	{
+		static_assert(augmented, "update() is for augmented_tree maps, use operator[]");
+		typename rep_type::iterator	it = rep.lower_bound(key);
+
+		if (it == rep.end() || key_comp()(key, it->first))
+			return rep.insert_unique(it, value_type(key, value));
+		it->second = value;
+		rep.refresh(it);
+		return it;
+	}
+
 	pair<iterator, iterator> equal_range(const key_type& key) { return rep.equal_range(key); }
 	pair<const_iterator, const_iterator> equal_range(const key_type& key) const { return rep.equal_range(key); }
 
-	template<typename FK, typename FT, typename FComp, typename FAlloc>
-	friend bool operator==(const map<FK, FT, FComp, FAlloc>&, const map<FK, FT, FComp, FAlloc>&);
-	template<typename FK, typename FT, typename FComp, typename FAlloc>
-	friend bool operator<(const map<FK, FT, FComp, FAlloc>&, const map<FK, FT, FComp, FAlloc>&);
+	template<typename FK, typename FT, typename FComp, typename FAlloc, typename FTree>
+	friend bool operator==(const map<FK, FT, FComp, FAlloc, FTree>&, const map<FK, FT, FComp, FAlloc, FTree>&);
+	template<typename FK, typename FT, typename FComp, typename FAlloc, typename FTree>
+	friend bool operator<(const map<FK, FT, FComp, FAlloc, FTree>&, const map<FK, FT, FComp, FAlloc, FTree>&);
 };
 
 //	global rel operator
 
-template<typename FK, typename FT, typename FComp, typename FAlloc>
-bool operator==(const map<FK, FT, FComp, FAlloc>& lhs, const map<FK, FT, FComp, FAlloc>& rhs)
+template<typename FK, typename FT, typename FComp, typename FAlloc, typename FTree>
+bool operator==(const map<FK, FT, FComp, FAlloc, FTree>& lhs, const map<FK, FT, FComp, FAlloc, FTree>& rhs)
 { return lhs.rep == rhs.rep; }
 
-template<typename FK, typename FT, typename FComp, typename FAlloc>
-bool operator<(const map<FK, FT, FComp, FAlloc>& lhs, const map<FK, FT, FComp, FAlloc>& rhs)
+template<typename FK, typename FT, typename FComp, typename FAlloc, typename FTree>
+bool operator<(const map<FK, FT, FComp, FAlloc, FTree>& lhs, const map<FK, FT, FComp, FAlloc, FTree>& rhs)
 { return lhs.rep < rhs.rep; }
 
-template<typename FK, typename FT, typename FComp, typename FAlloc>
-bool operator!=(const map<FK, FT, FComp, FAlloc>& lhs, const map<FK, FT, FComp, FAlloc>& rhs)
+template<typename FK, typename FT, typename FComp, typename FAlloc, typename FTree>
+bool operator!=(const map<FK, FT, FComp, FAlloc, FTree>& lhs, const map<FK, FT, FComp, FAlloc, FTree>& rhs)
 { return !(lhs == rhs); }
 
-template<typename FK, typename FT, typename FComp, typename FAlloc>
-bool operator<=(const map<FK, FT, FComp, FAlloc>& lhs, const map<FK, FT, FComp, FAlloc>& rhs)
+template<typename FK, typename FT, typename FComp, typename FAlloc, typename FTree>
+bool operator<=(const map<FK, FT, FComp, FAlloc, FTree>& lhs, const map<FK, FT, FComp, FAlloc, FTree>& rhs)
 { return !(rhs < lhs); }
 
-template<typename FK, typename FT, typename FComp, typename FAlloc>
-bool operator>(const map<FK, FT, FComp, FAlloc>& lhs, const map<FK, FT, FComp, FAlloc>& rhs)
+template<typename FK, typename FT, typename FComp, typename FAlloc, typename FTree>
+bool operator>(const map<FK, FT, FComp, FAlloc, FTree>& lhs, const map<FK, FT, FComp, FAlloc, FTree>& rhs)
 { return !(lhs <= rhs); }
 
-template<typename FK, typename FT, typename FComp, typename FAlloc>
-bool operator>=(const map<FK, FT, FComp, FAlloc>& lhs, const map<FK, FT, FComp, FAlloc>& rhs)
+template<typename FK, typename FT, typename FComp, typename FAlloc, typename FTree>
+bool operator>=(const map<FK, FT, FComp, FAlloc, FTree>& lhs, const map<FK, FT, FComp, FAlloc, FTree>& rhs)
 { return !(lhs < rhs); }
 
-template<typename FK, typename FT, typename FComp, typename FAlloc>
-void swap(const map<FK, FT, FComp, FAlloc>& lhs, const map<FK, FT, FComp, FAlloc>& rhs)
+template<typename FK, typename FT, typename FComp, typename FAlloc, typename FTree>
+void swap(const map<FK, FT, FComp, FAlloc, FTree>& lhs, const map<FK, FT, FComp, FAlloc, FTree>& rhs)
 { lhs.swap(rhs); }
 
 }	//	FT
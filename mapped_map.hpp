@@ -0,0 +1,490 @@
+#ifndef MAPPED_MAP_HPP
+# define MAPPED_MAP_HPP
+
+#include "pair.hpp"
+#include "rbtree.hpp"
+#include "traits.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <functional>
+#include <new>
+#include <stdexcept>
+#include <string>
+
+#include <fcntl.h>
+#include <stdint.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ft
+{
+
+/*
+ *	Mapped Links : each link is the distance in bytes from the field itself to the
+ *	target, so a tree stays valid wherever the file is mapped. 0 is null (a field never
+ *	points at itself). Nodes are 8 byte aligned : bit 0 of parent holds the color.
+ */
+struct mapped_links
+{
+	int64_t		parent_color;
+	int64_t		left;
+	int64_t		right;
+};
+
+template<typename V>
+struct mapped_node : public mapped_links
+{
+	V			value;
+};
+
+struct mapped_node_traits
+{
+	typedef mapped_links		node;
+	typedef mapped_links*		node_ptr;
+	typedef const mapped_links*	const_node_ptr;
+
+	static const bool	threaded = false;
+	static const bool	augmented = false;
+
+	static void update(node_ptr) {}
+
+	static node_ptr resolve(const int64_t& field, int64_t offset) {
+		return offset ? reinterpret_cast<node_ptr>(reinterpret_cast<intptr_t>(&field) + offset) : 0;
+	}
+	static int64_t offset(const int64_t& field, const_node_ptr target) {
+		return target ? reinterpret_cast<intptr_t>(target) - reinterpret_cast<intptr_t>(&field) : 0;
+	}
+
+	static node_ptr get_parent(const_node_ptr n) { return resolve(n->parent_color, n->parent_color & ~int64_t(1)); }
+	static void set_parent(node_ptr n, node_ptr p) {
+		n->parent_color = offset(n->parent_color, p) | (n->parent_color & 1);
+	}
+	static eColor get_color(const_node_ptr n) { return eColor(n->parent_color & 1); }
+	static void set_color(node_ptr n, eColor c) { n->parent_color = (n->parent_color & ~int64_t(1)) | c; }
+
+	static node_ptr get_left(const_node_ptr n) { return resolve(n->left, n->left); }
+	static void set_left(node_ptr n, node_ptr l) { n->left = offset(n->left, l); }
+	static node_ptr get_left_thread(const_node_ptr) { return 0; }
+	static void set_left_thread(node_ptr n, node_ptr) { n->left = 0; }
+
+	static node_ptr get_right(const_node_ptr n) { return resolve(n->right, n->right); }
+	static void set_right(node_ptr n, node_ptr r) { n->right = offset(n->right, r); }
+	static node_ptr get_right_thread(const_node_ptr) { return 0; }
+	static void set_right_thread(node_ptr n, node_ptr) { n->right = 0; }
+};
+
+typedef rb_algorithms<mapped_node_traits>	mapped_algorithms;
+
+template<typename V, typename Ref, typename Ptr>
+struct mapped_iterator
+{
+	typedef V								value_type;
+	typedef Ptr								pointer;
+	typedef	Ref								reference;
+	typedef std::bidirectional_iterator_tag	iterator_category;
+	typedef ptrdiff_t						difference_type;
+
+	typedef mapped_iterator<V, V&, V*>		iterator;
+	typedef mapped_iterator					self;
+
+	mapped_links*	node;
+
+	mapped_iterator() : node(0) {}
+	explicit mapped_iterator(mapped_links* n) : node(n) {}
+	mapped_iterator(const iterator& it) : node(it.node) {}
+
+	reference operator*() const { return static_cast<mapped_node<V>*>(node)->value; }
+	pointer operator->() const { return &static_cast<mapped_node<V>*>(node)->value; }
+
+	self& operator++() {
+		node = mapped_algorithms::increment(node);
+		return *this;
+	}
+	self operator++(int) {
+		self tmp = *this;
+		node = mapped_algorithms::increment(node);
+		return tmp;
+	}
+	self& operator--() {
+		node = mapped_algorithms::decrement(node);
+		return *this;
+	}
+	self operator--(int) {
+		self tmp = *this;
+		node = mapped_algorithms::decrement(node);
+		return tmp;
+	}
+
+	bool operator==(const self& rhs) const { return node == rhs.node; }
+	bool operator!=(const self& rhs) const { return node != rhs.node; }
+};
+
+template<typename V>
+bool operator==(const mapped_iterator<V, V&, V*>& lhs, const mapped_iterator<V, const V&, const V*>& rhs)
+{ return lhs.node == rhs.node; }
+template<typename V>
+bool operator!=(const mapped_iterator<V, V&, V*>& lhs, const mapped_iterator<V, const V&, const V*>& rhs)
+{ return lhs.node != rhs.node; }
+
+/*
+ *	Mapped File : a shared mapping of a whole window, the file grows inside it.
+ *	The window is reserved once, so growing never moves the mapping.
+ */
+class mapped_file
+{
+	int			fd;
+	char*		base;
+	size_t		window;
+	size_t		length;
+
+	mapped_file(const mapped_file&);
+	mapped_file& operator=(const mapped_file&);
+
+	static std::runtime_error error(const std::string& what) {
+		return std::runtime_error("mapped_map : " + what + " : " + std::strerror(errno));
+	}
+
+public:
+	mapped_file(const char* path, size_t max_bytes) : fd(-1), base(0), window(max_bytes), length(0) {
+		fd = ::open(path, O_RDWR | O_CREAT, 0644);
+		if (fd < 0) throw error(std::string("cannot open ") + path);
+		struct stat	st;
+		if (::fstat(fd, &st) != 0) {
+			::close(fd);
+			throw error("fstat");
+		}
+		length = size_t(st.st_size);
+		if (window < length) window = length;
+		void*	p = ::mmap(0, window, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+		if (p == MAP_FAILED) {
+			::close(fd);
+			throw error("mmap");
+		}
+		base = static_cast<char*>(p);
+	}
+
+	~mapped_file() {
+		::munmap(base, window);
+		::close(fd);
+	}
+
+	char* data() const { return base; }
+	size_t size() const { return length; }
+	size_t capacity() const { return window; }
+
+	void resize(size_t bytes) {
+		if (bytes > window) throw std::length_error("mapped_map : file would outgrow its mapping");
+		if (::ftruncate(fd, off_t(bytes)) != 0) throw error("ftruncate");
+		length = bytes;
+	}
+
+	void sync(size_t offset, size_t bytes) {
+		const size_t	page = size_t(::sysconf(_SC_PAGESIZE));
+		const size_t	start = offset / page * page;
+		if (::msync(base + start, offset + bytes - start, MS_SYNC) != 0) throw error("msync");
+	}
+};
+
+/*
+ *	Mapped Map : an ordered map living in a file, reopened without any load step.
+ *	K and T must be trivially copyable, Comp stateless.
+ *	Changes reach the file through the shared mapping; sync() (and the destructor)
+ *	is the durability point. A file that was being modified when its process died
+ *	is refused on open, since its tree may be half updated.
+ *	Anything that hands out writable access (operator[], a mutable iterator) counts
+ *	as a change : read through a const mapped_map to leave the file clean.
+ */
+template<typename K, typename T, typename Comp = std::less<K> >
+class mapped_map
+{
+public:
+	typedef K												key_type;
+	typedef T												mapped_type;
+	typedef pair<const K, T>								value_type;
+	typedef Comp											key_compare;
+	typedef std::size_t										size_type;
+	typedef std::ptrdiff_t									difference_type;
+	typedef mapped_iterator<value_type, value_type&, value_type*>				iterator;
+	typedef mapped_iterator<value_type, const value_type&, const value_type*>	const_iterator;
+	typedef ft::reverse_iterator<iterator>					reverse_iterator;
+	typedef ft::reverse_iterator<const_iterator>			const_reverse_iterator;
+
+	static const size_t		default_max_bytes = size_t(1) << 36;
+
+private:
+	typedef mapped_node<value_type>		node_type;
+	typedef mapped_links*				node_ptr;
+	typedef mapped_node_traits			traits;
+
+	enum { CLEAN = 0, DIRTY = 1 };
+
+	struct superblock
+	{
+		char			magic[8];
+		uint32_t		version;
+		uint32_t		state;
+		uint64_t		key_size;
+		uint64_t		mapped_size;
+		uint64_t		node_size;
+		uint64_t		used;			//	bytes handed out, from the file start
+		uint64_t		free_head;		//	offset of the first free node, 0 : none
+		uint64_t		count;
+		mapped_links	header;
+	};
+
+	static const size_t		node_size = (sizeof(node_type) + 7) / 8 * 8;
+	static const size_t		first_node = (sizeof(superblock) + 63) / 64 * 64;
+	static const size_t		initial_bytes = 1 << 20;
+
+	mapped_file		file;
+	Comp			comp;
+
+	mapped_map(const mapped_map&);
+	mapped_map& operator=(const mapped_map&);
+
+	superblock* sb() const { return reinterpret_cast<superblock*>(file.data()); }
+	node_ptr header() const { return &sb()->header; }
+	node_ptr root() const { return traits::get_parent(header()); }
+	static const K& key(const mapped_links* n) { return static_cast<const node_type*>(n)->value.first; }
+
+	static void check_types() {
+		static_assert(is_bitwise_copyable<K>::value && is_bitwise_copyable<T>::value,
+			"mapped_map needs trivially copyable keys and values");
+	}
+
+	//	max_bytes must at least hold the superblock, checked before the file is created
+	static size_t checked(size_t max_bytes) {
+		if (max_bytes < first_node) throw std::length_error("mapped_map : max_bytes too small for a file");
+		return max_bytes;
+	}
+
+	void format() {
+		file.resize(initial_bytes < file.capacity() ? initial_bytes : file.capacity());
+		superblock*	s = sb();
+		std::memcpy(s->magic, "FTMAPPED", 8);
+		s->version = 1;
+		s->state = CLEAN;
+		s->key_size = sizeof(K);
+		s->mapped_size = sizeof(T);
+		s->node_size = node_size;
+		s->used = first_node;
+		s->free_head = 0;
+		s->count = 0;
+		reset_header();
+	}
+
+	void reset_header() {
+		node_ptr	h = header();
+		h->parent_color = 0;
+		traits::set_color(h, RED);
+		traits::set_left(h, h);
+		traits::set_right(h, h);
+	}
+
+	void validate() const {
+		const superblock*	s = sb();
+		if (file.size() < first_node || std::memcmp(s->magic, "FTMAPPED", 8) != 0 || s->version != 1)
+			throw std::runtime_error("mapped_map : not a mapped_map file");
+		if (s->key_size != sizeof(K) || s->mapped_size != sizeof(T) || s->node_size != node_size)
+			throw std::runtime_error("mapped_map : key or value type mismatch");
+		if (s->state != CLEAN)
+			throw std::runtime_error("mapped_map : file was not closed or synced after its last change");
+		if (s->used > file.size())
+			throw std::runtime_error("mapped_map : truncated file");
+	}
+
+	//	the DIRTY mark is on disk before the first node of a change can be written back
+	void touch() {
+		if (sb()->state == DIRTY) return ;
+		sb()->state = DIRTY;
+		file.sync(0, sizeof(superblock));
+	}
+
+	node_type* allocate() {
+		superblock*	s = sb();
+		char*		p;
+
+		if (s->free_head) {
+			p = file.data() + s->free_head;
+			std::memcpy(&s->free_head, p, sizeof(uint64_t));
+		}
+		else {
+			if (s->used + node_size > file.size()) grow(s->used + node_size);
+			p = file.data() + s->used;
+			s->used += node_size;
+		}
+		return reinterpret_cast<node_type*>(p);
+	}
+
+	//	doubles the file, capped by the window : only a node past the window throws
+	void grow(size_t need) {
+		if (need > file.capacity()) throw std::length_error("mapped_map : file would outgrow its mapping");
+		size_t	bytes = file.size() * 2;
+		if (bytes < need) bytes = need;
+		file.resize(bytes < file.capacity() ? bytes : file.capacity());
+	}
+
+	void deallocate(node_ptr n) {
+		superblock*		s = sb();
+		const uint64_t	next = s->free_head;
+		std::memcpy(n, &next, sizeof(uint64_t));
+		s->free_head = uint64_t(reinterpret_cast<char*>(n) - file.data());
+	}
+
+	node_ptr lower(const key_type& k) const {
+		node_ptr	x = root();
+		node_ptr	y = header();
+
+		while (x) {
+			if (!comp(key(x), k)) {
+				y = x;
+				x = traits::get_left(x);
+			}
+			else x = traits::get_right(x);
+		}
+		return y;
+	}
+
+	node_ptr upper(const key_type& k) const {
+		node_ptr	x = root();
+		node_ptr	y = header();
+
+		while (x) {
+			if (comp(k, key(x))) {
+				y = x;
+				x = traits::get_left(x);
+			}
+			else x = traits::get_right(x);
+		}
+		return y;
+	}
+
+public:
+	//	opens path, or creates it. max_bytes bounds the file : it is the mapping reserved up front.
+	explicit mapped_map(const char* path, size_t max_bytes = default_max_bytes)
+	: file(path, checked(max_bytes)), comp() {
+		check_types();
+		if (file.size() == 0) format();
+		else validate();
+	}
+
+	~mapped_map() {
+		try {
+			sync();
+		}
+		catch (...) {}
+	}
+
+	//	durability point : everything before it is on disk once it returns
+	void sync() {
+		if (sb()->state == CLEAN) return ;
+		file.sync(0, sb()->used);
+		sb()->state = CLEAN;
+		file.sync(0, sizeof(superblock));
+	}
+
+	iterator begin() {
+		touch();
+		return iterator(traits::get_left(header()));
+	}
+	const_iterator begin() const { return const_iterator(traits::get_left(header())); }
+	iterator end() {
+		touch();
+		return iterator(header());
+	}
+	const_iterator end() const { return const_iterator(header()); }
+	reverse_iterator rbegin() { return reverse_iterator(end()); }
+	const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+	reverse_iterator rend() { return reverse_iterator(begin()); }
+	const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+	bool empty() const { return sb()->count == 0; }
+	size_type size() const { return sb()->count; }
+	key_compare key_comp() const { return comp; }
+
+	pair<iterator, bool> insert(const value_type& v) {
+		touch();
+		node_ptr	x = root();
+		node_ptr	y = header();
+		bool		less = true;
+
+		while (x) {
+			y = x;
+			less = comp(v.first, key(x));
+			x = less ? traits::get_left(x) : traits::get_right(x);
+		}
+		iterator	j(y);
+		if (less) {
+			if (j == begin()) return pair<iterator, bool>(insert_at(y, v), true);
+			--j;
+		}
+		if (comp(key(j.node), v.first)) return pair<iterator, bool>(insert_at(y, v), true);
+		return pair<iterator, bool>(j, false);
+	}
+
+	mapped_type& operator[](const key_type& k) {
+		return insert(value_type(k, mapped_type())).first->second;
+	}
+
+	void erase(iterator pos) {
+		touch();
+		deallocate(mapped_algorithms::rebalance_erase(pos.node, header()));
+		--sb()->count;
+	}
+
+	size_type erase(const key_type& k) {
+		iterator	it = find(k);
+		if (it == end()) return 0;
+		erase(it);
+		return 1;
+	}
+
+	void clear() {
+		touch();
+		superblock*	s = sb();
+		s->used = first_node;
+		s->free_head = 0;
+		s->count = 0;
+		reset_header();
+	}
+
+	iterator find(const key_type& k) {
+		touch();
+		node_ptr	y = lower(k);
+		return y == header() || comp(k, key(y)) ? end() : iterator(y);
+	}
+	const_iterator find(const key_type& k) const {
+		node_ptr	y = lower(k);
+		return y == header() || comp(k, key(y)) ? end() : const_iterator(y);
+	}
+	size_type count(const key_type& k) const { return find(k) == end() ? 0 : 1; }
+
+	iterator lower_bound(const key_type& k) {
+		touch();
+		return iterator(lower(k));
+	}
+	const_iterator lower_bound(const key_type& k) const { return const_iterator(lower(k)); }
+	iterator upper_bound(const key_type& k) {
+		touch();
+		return iterator(upper(k));
+	}
+	const_iterator upper_bound(const key_type& k) const { return const_iterator(upper(k)); }
+
+private:
+	iterator insert_at(node_ptr parent, const value_type& v) {
+		const bool	insert_left = parent == header() || comp(v.first, key(parent));
+
+		node_type*	z = allocate();
+		::new (static_cast<void*>(&z->value)) value_type(v);
+		z->parent_color = z->left = z->right = 0;
+		mapped_algorithms::insert_rebalance(insert_left, z, parent, header());
+		++sb()->count;
+		return iterator(z);
+	}
+};
+
+}	//	FT
+
+#endif
@@ -0,0 +1,426 @@
+#ifndef MEMORY_RESOURCE_HPP
+# define MEMORY_RESOURCE_HPP
+
+#include "map.hpp"
+#include "set.hpp"
+#include "stack.hpp"
+#include "vector.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+
+#include <stdint.h>
+#include <stdlib.h>
+
+namespace ft
+{
+
+namespace pmr
+{
+
+/*
+ *	Memory Resource : where a polymorphic_allocator gets its bytes.
+ *	deallocate() takes back the size and alignment given to allocate().
+ */
+class memory_resource
+{
+public:
+	enum { max_align = alignof(std::max_align_t) };
+
+	virtual ~memory_resource() {}
+
+	void* allocate(std::size_t bytes, std::size_t align = max_align) { return do_allocate(bytes, align); }
+	void deallocate(void* p, std::size_t bytes, std::size_t align = max_align) { do_deallocate(p, bytes, align); }
+	bool is_equal(const memory_resource& other) const { return do_is_equal(other); }
+
+private:
+	virtual void* do_allocate(std::size_t bytes, std::size_t align) = 0;
+	virtual void do_deallocate(void* p, std::size_t bytes, std::size_t align) = 0;
+	virtual bool do_is_equal(const memory_resource& other) const { return this == &other; }
+};
+
+inline bool operator==(const memory_resource& a, const memory_resource& b) { return &a == &b || a.is_equal(b); }
+inline bool operator!=(const memory_resource& a, const memory_resource& b) { return !(a == b); }
+
+//	operator new / delete, posix_memalign past the fundamental alignment
+class new_delete_memory_resource : public memory_resource
+{
+	void* do_allocate(std::size_t bytes, std::size_t align) {
+		if (align <= max_align) return ::operator new(bytes);
+		void*	p = 0;
+		if (::posix_memalign(&p, align, bytes) != 0) throw std::bad_alloc();
+		return p;
+	}
+	void do_deallocate(void* p, std::size_t, std::size_t align) {
+		if (align <= max_align) ::operator delete(p);
+		else ::free(p);
+	}
+	bool do_is_equal(const memory_resource& other) const {
+		return dynamic_cast<const new_delete_memory_resource*>(&other) != 0;
+	}
+};
+
+inline memory_resource* new_delete_resource() {
+	static new_delete_memory_resource	instance;
+	return &instance;
+}
+
+namespace detail
+{
+inline std::atomic<memory_resource*>& default_resource() {
+	static std::atomic<memory_resource*>	res(new_delete_resource());
+	return res;
+}
+}	//	DETAIL
+
+//	what a default constructed polymorphic_allocator uses : null restores new_delete_resource()
+inline memory_resource* get_default_resource() { return detail::default_resource().load(); }
+inline memory_resource* set_default_resource(memory_resource* r) {
+	return detail::default_resource().exchange(r ? r : new_delete_resource());
+}
+
+inline std::size_t align_up(std::size_t n, std::size_t align) { return (n + align - 1) & ~(align - 1); }
+
+/*
+ *	Monotonic Buffer : bump allocation, deallocate() does nothing and release()
+ *	(or the destructor) frees everything at once. Starts in the caller's buffer
+ *	when given one, then takes chunks from upstream, each twice the last.
+ */
+class monotonic_buffer_resource : public memory_resource
+{
+	struct chunk
+	{
+		chunk*		next;
+		std::size_t	size;
+		std::size_t	align;
+	};
+
+	memory_resource*	upstream;
+	void*				initial;
+	std::size_t			initial_size;
+	char*				cur;
+	std::size_t			left;
+	std::size_t			first_size;
+	std::size_t			next_size;
+	chunk*				chunks;
+
+	monotonic_buffer_resource(const monotonic_buffer_resource&);
+	monotonic_buffer_resource& operator=(const monotonic_buffer_resource&);
+
+	void grow(std::size_t bytes, std::size_t align) {
+		std::size_t	size = next_size;
+		const std::size_t	need = align_up(sizeof(chunk), align) + bytes;
+		if (size < need) size = align_up(need, max_align);
+		const std::size_t	chunk_align = align > std::size_t(max_align) ? align : std::size_t(max_align);
+		chunk* const	c = static_cast<chunk*>(upstream->allocate(size, chunk_align));
+		c->next = chunks;
+		c->size = size;
+		c->align = chunk_align;
+		chunks = c;
+		cur = reinterpret_cast<char*>(c + 1);
+		left = size - sizeof(chunk);
+		next_size = size * 2;
+	}
+
+	void* do_allocate(std::size_t bytes, std::size_t align) {
+		std::size_t	pad = (align - reinterpret_cast<uintptr_t>(cur) % align) % align;
+		if (cur == 0 || pad + bytes > left) {
+			grow(bytes, align);
+			pad = (align - reinterpret_cast<uintptr_t>(cur) % align) % align;
+		}
+		char* const	p = cur + pad;
+		cur = p + bytes;
+		left -= pad + bytes;
+		return p;
+	}
+	void do_deallocate(void*, std::size_t, std::size_t) {}
+
+public:
+	explicit monotonic_buffer_resource(memory_resource* up = get_default_resource())
+	: upstream(up), initial(0), initial_size(0), cur(0), left(0), first_size(1024), next_size(1024), chunks(0) {}
+	explicit monotonic_buffer_resource(std::size_t first_chunk, memory_resource* up = get_default_resource())
+	: upstream(up), initial(0), initial_size(0), cur(0), left(0), first_size(first_chunk ? first_chunk : 1024),
+	  next_size(first_size), chunks(0) {}
+	monotonic_buffer_resource(void* buffer, std::size_t size, memory_resource* up = get_default_resource())
+	: upstream(up), initial(buffer), initial_size(size), cur(static_cast<char*>(buffer)), left(size),
+	  first_size(size ? size * 2 : 1024), next_size(first_size), chunks(0) {}
+
+	~monotonic_buffer_resource() { release(); }
+
+	//	frees every chunk and starts over from the initial buffer and chunk size
+	void release() {
+		while (chunks) {
+			chunk* const	c = chunks;
+			chunks = c->next;
+			upstream->deallocate(c, c->size, c->align);
+		}
+		cur = static_cast<char*>(initial);
+		left = initial_size;
+		next_size = first_size;
+	}
+
+	memory_resource* upstream_resource() const { return upstream; }
+};
+
+struct pool_options
+{
+	std::size_t	max_blocks_per_chunk;
+	std::size_t	largest_required_pool_block;
+
+	pool_options(std::size_t blocks = 1024, std::size_t largest = 4096)
+	: max_blocks_per_chunk(blocks), largest_required_pool_block(largest) {}
+};
+
+/*
+ *	Pool : one free list per power of two block size up to the largest pooled
+ *	block, refilled with chunks from upstream that grow up to max_blocks_per_chunk.
+ *	Larger requests go to upstream directly. release() returns everything.
+ *	Not thread safe, see synchronized_pool_resource.
+ */
+class unsynchronized_pool_resource : public memory_resource
+{
+	enum { min_block = 8, max_pools = 24 };
+
+	struct free_block { free_block* next; };
+
+	//	at the end of each pool chunk
+	struct chunk
+	{
+		chunk*		next;
+		void*		base;
+		std::size_t	bytes;
+	};
+
+	struct pool
+	{
+		free_block*	free;
+		chunk*		chunks;
+		std::size_t	next_blocks;
+	};
+
+	//	in front of every oversized block, so release() can find them
+	struct big_block
+	{
+		big_block*	prev;
+		big_block*	next;
+		std::size_t	bytes;
+		std::size_t	align;
+	};
+
+	memory_resource*	upstream;
+	pool_options		opts;
+	pool				pools[max_pools];
+	std::size_t			pool_count;
+	big_block			big;
+
+	unsynchronized_pool_resource(const unsynchronized_pool_resource&);
+	unsynchronized_pool_resource& operator=(const unsynchronized_pool_resource&);
+
+	static std::size_t block_size(std::size_t i) { return std::size_t(min_block) << i; }
+
+	std::size_t pool_index(std::size_t bytes, std::size_t align) const {
+		std::size_t	n = bytes > align ? bytes : align;
+		std::size_t	i = 0;
+		while (block_size(i) < n) ++i;
+		return i;
+	}
+
+	static std::size_t chunk_align(std::size_t block) { return block > std::size_t(max_align) ? block : std::size_t(max_align); }
+
+	void refill(std::size_t i) {
+		pool&				p = pools[i];
+		const std::size_t	block = block_size(i);
+		const std::size_t	n = p.next_blocks;
+		const std::size_t	bytes = align_up(n * block, alignof(chunk)) + sizeof(chunk);
+		char* const			base = static_cast<char*>(upstream->allocate(bytes, chunk_align(block)));
+		chunk* const		c = reinterpret_cast<chunk*>(base + bytes - sizeof(chunk));
+
+		c->next = p.chunks;
+		c->base = base;
+		c->bytes = bytes;
+		p.chunks = c;
+		for (std::size_t k = n; k--; ) {
+			free_block* const	b = reinterpret_cast<free_block*>(base + k * block);
+			b->next = p.free;
+			p.free = b;
+		}
+		if (p.next_blocks < opts.max_blocks_per_chunk) p.next_blocks *= 2;
+		if (p.next_blocks > opts.max_blocks_per_chunk) p.next_blocks = opts.max_blocks_per_chunk;
+	}
+
+	static std::size_t big_align(std::size_t align) { return align > std::size_t(max_align) ? align : std::size_t(max_align); }
+	static std::size_t big_header(std::size_t align) { return align_up(sizeof(big_block), big_align(align)); }
+
+	void free_big(big_block* h) {
+		h->prev->next = h->next;
+		h->next->prev = h->prev;
+		upstream->deallocate(reinterpret_cast<char*>(h + 1) - big_header(h->align), h->bytes, big_align(h->align));
+	}
+
+	void* do_allocate(std::size_t bytes, std::size_t align) {
+		const std::size_t	i = pool_index(bytes, align);
+
+		if (i < pool_count) {
+			pool&	p = pools[i];
+			if (p.free == 0) refill(i);
+			free_block* const	b = p.free;
+			p.free = b->next;
+			return b;
+		}
+		const std::size_t	header = big_header(align);
+		char* const			base = static_cast<char*>(upstream->allocate(header + bytes, big_align(align)));
+		big_block* const	h = reinterpret_cast<big_block*>(base + header - sizeof(big_block));
+		h->bytes = header + bytes;
+		h->align = align;
+		h->prev = &big;
+		h->next = big.next;
+		big.next->prev = h;
+		big.next = h;
+		return base + header;
+	}
+
+	void do_deallocate(void* ptr, std::size_t bytes, std::size_t align) {
+		if (ptr == 0) return ;
+		const std::size_t	i = pool_index(bytes, align);
+
+		if (i < pool_count) {
+			free_block* const	b = static_cast<free_block*>(ptr);
+			b->next = pools[i].free;
+			pools[i].free = b;
+			return ;
+		}
+		free_big(reinterpret_cast<big_block*>(static_cast<char*>(ptr) - sizeof(big_block)));
+	}
+
+public:
+	explicit unsynchronized_pool_resource(const pool_options& o = pool_options(),
+										  memory_resource* up = get_default_resource())
+	: upstream(up), opts(o), pool_count(0)
+	{
+		if (opts.max_blocks_per_chunk == 0) opts.max_blocks_per_chunk = 1;
+		while (pool_count < max_pools && block_size(pool_count) <= opts.largest_required_pool_block) ++pool_count;
+		for (std::size_t i = 0; i < max_pools; ++i) {
+			pools[i].free = 0;
+			pools[i].chunks = 0;
+			pools[i].next_blocks = 16 < opts.max_blocks_per_chunk ? 16 : opts.max_blocks_per_chunk;
+		}
+		big.prev = big.next = &big;
+	}
+	explicit unsynchronized_pool_resource(memory_resource* up)
+	: unsynchronized_pool_resource(pool_options(), up) {}
+
+	~unsynchronized_pool_resource() { release(); }
+
+	//	returns every block to upstream, allocated or not
+	void release() {
+		for (std::size_t i = 0; i < pool_count; ++i) {
+			for (chunk* c = pools[i].chunks; c; ) {
+				chunk* const	next = c->next;
+				upstream->deallocate(c->base, c->bytes, chunk_align(block_size(i)));
+				c = next;
+			}
+			pools[i].free = 0;
+			pools[i].chunks = 0;
+		}
+		while (big.next != &big) free_big(big.next);
+	}
+
+	pool_options options() const { return opts; }
+	memory_resource* upstream_resource() const { return upstream; }
+};
+
+//	the pool behind a mutex
+class synchronized_pool_resource : public memory_resource
+{
+	std::mutex						lock;
+	unsynchronized_pool_resource	pool;
+
+	void* do_allocate(std::size_t bytes, std::size_t align) {
+		std::lock_guard<std::mutex>	guard(lock);
+		return pool.allocate(bytes, align);
+	}
+	void do_deallocate(void* p, std::size_t bytes, std::size_t align) {
+		std::lock_guard<std::mutex>	guard(lock);
+		pool.deallocate(p, bytes, align);
+	}
+
+public:
+	explicit synchronized_pool_resource(const pool_options& o = pool_options(),
+										memory_resource* up = get_default_resource())
+	: pool(o, up) {}
+	explicit synchronized_pool_resource(memory_resource* up) : pool(pool_options(), up) {}
+
+	void release() {
+		std::lock_guard<std::mutex>	guard(lock);
+		pool.release();
+	}
+
+	pool_options options() const { return pool.options(); }
+	memory_resource* upstream_resource() const { return pool.upstream_resource(); }
+};
+
+/*
+ *	Polymorphic Allocator : an allocator type that is the same for every resource.
+ *	Rebinding keeps the resource, so a map's nodes or a vector's buffer come from
+ *	the resource the container was given. Copies share it too : swap only
+ *	containers on the same resource.
+ */
+template<typename T>
+class polymorphic_allocator
+{
+	memory_resource*	res;
+
+public:
+	typedef T					value_type;
+	typedef T*					pointer;
+	typedef const T*			const_pointer;
+	typedef T&					reference;
+	typedef const T&			const_reference;
+	typedef std::size_t			size_type;
+	typedef std::ptrdiff_t		difference_type;
+
+	template<typename U> struct rebind { typedef polymorphic_allocator<U> other; };
+
+	polymorphic_allocator() : res(get_default_resource()) {}
+	polymorphic_allocator(memory_resource* r) : res(r ? r : get_default_resource()) {}
+	template<typename U>
+	polymorphic_allocator(const polymorphic_allocator<U>& other) : res(other.resource()) {}
+
+	T* allocate(size_type n) { return static_cast<T*>(res->allocate(n * sizeof(T), alignof(T))); }
+	void deallocate(T* p, size_type n) { res->deallocate(p, n * sizeof(T), alignof(T)); }
+
+	template<typename U, typename... Args>
+	void construct(U* p, Args&&... args) { ::new(static_cast<void*>(p)) U(std::forward<Args>(args)...); }
+	template<typename U>
+	void destroy(U* p) { p->~U(); }
+
+	size_type max_size() const { return size_type(-1) / sizeof(T); }
+	memory_resource* resource() const { return res; }
+};
+
+template<typename T, typename U>
+bool operator==(const polymorphic_allocator<T>& a, const polymorphic_allocator<U>& b) {
+	return *a.resource() == *b.resource();
+}
+template<typename T, typename U>
+bool operator!=(const polymorphic_allocator<T>& a, const polymorphic_allocator<U>& b) { return !(a == b); }
+
+template<typename T>
+using vector = ft::vector<T, polymorphic_allocator<T> >;
+template<typename K, typename T, typename Comp = std::less<K>, typename Tree = pointer_tree>
+using map = ft::map<K, T, Comp, polymorphic_allocator<pair<const K, T> >, Tree>;
+template<typename K, typename Comp = ft::less<K>, typename Tree = pointer_tree>
+using set = ft::set<K, Comp, polymorphic_allocator<K>, Tree>;
+template<typename T>
+using stack = ft::stack<T, pmr::vector<T> >;
+
+}	//	PMR
+
+}	//	FT
+
+#endif
@@ -1,6 +1,13 @@
 #ifndef PAIR_HPP
 # define PAIR_HPP
 
+//	literal pairs from C++11 on, for tables built at compile time (frozen_map.hpp)
+#if __cplusplus >= 201103L
+# define FT_CONSTEXPR constexpr
+#else
+# define FT_CONSTEXPR
+#endif
+
 namespace ft
 {
 
@@ -13,18 +20,16 @@ struct pair
 	first_type first;
 	second_type second;
 
-	pair() : first(), second() {}
+	FT_CONSTEXPR pair() : first(), second() {}
 
-	pair(const first_type & value1, const second_type & value2)
+	FT_CONSTEXPR pair(const first_type & value1, const second_type & value2)
 			: first(value1), second(value2) {};
 
-	pair(const pair & rhs) : first(rhs.first), second(rhs.second) {};
+	FT_CONSTEXPR pair(const pair & rhs) : first(rhs.first), second(rhs.second) {};
 
 	template<typename Other1, typename Other2>
-	pair(const pair<Other1, Other2> & rhs)
+	FT_CONSTEXPR pair(const pair<Other1, Other2> & rhs)
 			: first(rhs.first), second(rhs.second) {};
-
-	~pair() {};
 };
 
 template<typename T, typename U>
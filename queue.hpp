@@ -0,0 +1,246 @@
+#ifndef QUEUE_HPP
+# define QUEUE_HPP
+
+#include "algorithm.hpp"
+#include "deque.hpp"
+#include "vector.hpp"
+
+#include <cstdlib>
+#include <new>
+
+namespace ft
+{
+template<typename T, typename Container = ft::deque<T> >
+class queue
+{
+public:
+	typedef Container									container_type;
+	typedef typename container_type::value_type			value_type;
+	typedef typename container_type::size_type			size_type;
+	typedef typename container_type::reference			reference;
+	typedef typename container_type::const_reference	const_reference;
+
+	explicit queue(const container_type& container = container_type()) : con(container) {};
+	queue(const queue& rhs) : con(rhs.con) {};
+	~queue(void) {};
+
+	queue& operator=(const queue& rhs) {
+		if (this == &rhs) return *this;
+		con = rhs.con;
+		return *this;
+	}
+
+	reference front(void) { return con.front(); }
+	const_reference front(void) const { return con.front(); }
+	reference back(void) { return con.back(); }
+	const_reference back(void) const { return con.back(); }
+	void push(const value_type& value) { con.push_back(value); }
+	void pop(void) { con.pop_front(); }
+
+	bool empty(void) const { return con.empty(); }
+	size_type size(void) const { return con.size(); }
+	void swap(queue& rhs) { con.swap(rhs.con); }
+protected:
+	container_type	con;
+
+friend bool operator==(const queue& lhs, const queue& rhs) { return lhs.con == rhs.con; }
+friend bool operator!=(const queue& lhs, const queue& rhs) { return lhs.con != rhs.con; }
+friend bool operator<(const queue& lhs, const queue& rhs) { return lhs.con < rhs.con; }
+friend bool operator<=(const queue& lhs, const queue& rhs) { return lhs.con <= rhs.con; }
+friend bool operator>(const queue& lhs, const queue& rhs) { return lhs.con > rhs.con; }
+friend bool operator>=(const queue& lhs, const queue& rhs) { return lhs.con >= rhs.con; }
+};
+
+/*
+ *	Cache Aligned Allocator : every buffer starts on a 64 byte line
+ */
+template<typename T>
+class cache_aligned_allocator
+{
+public:
+	typedef T					value_type;
+	typedef T*					pointer;
+	typedef const T*			const_pointer;
+	typedef T&					reference;
+	typedef const T&			const_reference;
+	typedef std::size_t			size_type;
+	typedef std::ptrdiff_t		difference_type;
+
+	enum { line = 64 };
+
+	template<typename U> struct rebind { typedef cache_aligned_allocator<U> other; };
+
+	cache_aligned_allocator() {}
+	template<typename U>
+	cache_aligned_allocator(const cache_aligned_allocator<U>&) {}
+
+	T* allocate(size_type n) {
+		void*	p = 0;
+		if (::posix_memalign(&p, line, n * sizeof(T)) != 0) throw std::bad_alloc();
+		return static_cast<T*>(p);
+	}
+	void deallocate(T* p, size_type) { std::free(p); }
+
+	template<typename U>
+	void construct(U* p) { ::new(static_cast<void*>(p)) U(); }
+	template<typename U, typename V>
+	void construct(U* p, const V& v) { ::new(static_cast<void*>(p)) U(v); }
+	template<typename U>
+	void destroy(U* p) { p->~U(); }
+
+	size_type max_size() const { return size_type(-1) / sizeof(T); }
+};
+
+template<typename T, typename U>
+bool operator==(const cache_aligned_allocator<T>&, const cache_aligned_allocator<U>&) { return true; }
+template<typename T, typename U>
+bool operator!=(const cache_aligned_allocator<T>&, const cache_aligned_allocator<U>&) { return false; }
+
+/*
+ *	Priority Queue : D-ary max heap on Compare.
+ *	Element i is stored at con[i + D - 1] and its children at con[D * (i + 1) + D - 1 ...],
+ *	so every group of D siblings starts at a multiple of D in the buffer. The default
+ *	buffer is line aligned, so a sift-down step reads a group that does not straddle
+ *	a cache line when D * sizeof(T) divides 64 ; a container with a weaker allocator
+ *	only keeps the groups aligned to D * sizeof(T) as far as its allocator does.
+ *	The D - 1 leading slots are padding, filled with copies of the first pushed value.
+ */
+template<typename T, typename Container = ft::vector<T, cache_aligned_allocator<T> >,
+		typename Compare = ft::less<typename Container::value_type>, std::size_t D = 4>
+class priority_queue
+{
+public:
+	typedef Container									container_type;
+	typedef Compare										value_compare;
+	typedef typename container_type::value_type			value_type;
+	typedef typename container_type::size_type			size_type;
+	typedef typename container_type::reference			reference;
+	typedef typename container_type::const_reference	const_reference;
+
+	static const std::size_t	arity = D;
+
+private:
+	static const size_type		pad = D - 1;
+
+	size_type	_slot(size_type i) const { return i + pad; }
+
+	void	_pad(const value_type& value) {
+		if (con.empty()) con.insert(con.end(), pad, value);
+	}
+
+	void	_sift_up(size_type hole) {
+		value_type	value = con[_slot(hole)];
+		while (hole > 0) {
+			const size_type parent = (hole - 1) / D;
+			if (!comp(con[_slot(parent)], value)) break;
+			con[_slot(hole)] = con[_slot(parent)];
+			hole = parent;
+		}
+		con[_slot(hole)] = value;
+	}
+
+	void	_sift_down(size_type hole, const value_type& value) {
+		const size_type len = size();
+		for (;;) {
+			const size_type first = D * hole + 1;
+			if (first >= len) break;
+			const size_type last = std::min(first + D, len);
+			size_type best = first;
+			for (size_type child = first + 1; child < last; ++child)
+				if (comp(con[_slot(best)], con[_slot(child)])) best = child;
+			if (!comp(value, con[_slot(best)])) break;
+			con[_slot(hole)] = con[_slot(best)];
+			hole = best;
+		}
+		con[_slot(hole)] = value;
+	}
+
+	//	Floyd : sift down every internal node, bottom up, O(n)
+	void	_heapify(void) {
+		const size_type len = size();
+		if (len < 2) return ;
+		for (size_type i = (len - 2) / D + 1; i > 0; --i) {
+			value_type value = con[_slot(i - 1)];
+			_sift_down(i - 1, value);
+		}
+	}
+
+public:
+	explicit priority_queue(const Compare& compare = Compare(), const Container& container = Container())
+	: comp(compare), con() {
+		push_range(container.begin(), container.end());
+	}
+
+	template<typename InputIt>
+	priority_queue(InputIt first, InputIt last, const Compare& compare = Compare(), const Container& container = Container())
+	: comp(compare), con() {
+		push_range(container.begin(), container.end());
+		push_range(first, last);
+	}
+
+	priority_queue(const priority_queue& rhs) : comp(rhs.comp), con(rhs.con) {};
+	~priority_queue(void) {};
+
+	priority_queue& operator=(const priority_queue& rhs) {
+		if (this == &rhs) return *this;
+		comp = rhs.comp;
+		con = rhs.con;
+		return *this;
+	}
+
+	const_reference top(void) const { return con[pad]; }
+	bool empty(void) const { return con.size() <= pad; }
+	size_type size(void) const { return empty() ? 0 : con.size() - pad; }
+
+	void push(const value_type& value) {
+		_pad(value);
+		con.push_back(value);
+		_sift_up(size() - 1);
+	}
+
+	void pop(void) {
+		if (size() > 1) {
+			value_type value = con.back();
+			con.pop_back();
+			_sift_down(0, value);
+		}
+		else con.pop_back();
+	}
+
+	//	replace the top : one sift-down instead of pop's sift-down plus push's sift-up
+	void pop_push(const value_type& value) {
+		if (empty()) {
+			push(value);
+			return ;
+		}
+		_sift_down(0, value);
+	}
+
+	/*
+	 *	Bulk insert : a big batch is cheaper to heapify at once than to sift up one by one
+	 */
+	template<typename InputIt>
+	void push_range(InputIt first, InputIt last) {
+		if (first == last) return ;
+		_pad(*first);
+		const size_type before = size();
+		for (; first != last; ++first) con.push_back(*first);
+		const size_type added = size() - before;
+
+		if (added > before / 2) _heapify();
+		else for (size_type i = before; i < size(); ++i) _sift_up(i);
+	}
+
+	void swap(priority_queue& rhs) {
+		std::swap(comp, rhs.comp);
+		con.swap(rhs.con);
+	}
+
+protected:
+	Compare			comp;
+	container_type	con;
+};
+
+}	//	FT
+
+#endif
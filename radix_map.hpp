@@ -0,0 +1,979 @@
+#ifndef RADIX_MAP_HPP
+# define RADIX_MAP_HPP
+
+#include "algorithm.hpp"
+#include "iter.hpp"
+#include "pair.hpp"
+#include "simd.hpp"
+#include "traits.hpp"
+
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include <stdint.h>
+
+namespace ft
+{
+
+/*
+ *	Radix Key : the bytes of a key, in the order of the key itself.
+ *	Integers are spelled big endian, signed ones with the sign bit flipped.
+ *	A string is its own bytes (compared as unsigned char, like std::string) :
+ *	a key may be a prefix of another one.
+ */
+template<typename K, bool = is_integral<K>::value>
+class radix_key_bytes;
+
+template<typename K>
+class radix_key_bytes<K, true>
+{
+	unsigned char	buf[sizeof(K)];
+
+public:
+	explicit radix_key_bytes(K k) {
+		unsigned long long	u = static_cast<unsigned long long>(k);
+		if (K(-1) < K(0)) u ^= 1ULL << (sizeof(K) * 8 - 1);
+		for (std::size_t i = 0; i < sizeof(K); ++i) buf[i] = static_cast<unsigned char>(u >> (8 * (sizeof(K) - 1 - i)));
+	}
+	const unsigned char* data() const { return buf; }
+	std::size_t size() const { return sizeof(K); }
+};
+
+template<>
+class radix_key_bytes<std::string, false>
+{
+	const unsigned char*	p;
+	std::size_t				n;
+
+public:
+	explicit radix_key_bytes(const std::string& k) : p(reinterpret_cast<const unsigned char*>(k.data())), n(k.size()) {}
+	const unsigned char* data() const { return p; }
+	std::size_t size() const { return n; }
+};
+
+namespace art
+{
+
+enum node_kind { NODE4, NODE16, NODE48, NODE256 };
+
+//	prefix bytes kept in a node, the rest of a longer prefix is read from any leaf below
+static const uint32_t	max_prefix = 8;
+
+/*
+ *	Leaves form a list in key order, closed by the map's head : iteration never
+ *	goes back into the tree.
+ */
+struct list_node
+{
+	list_node*	prev;
+	list_node*	next;
+};
+
+template<typename V>
+struct leaf : public list_node
+{
+	V	value;
+};
+
+/*
+ *	Inner nodes. A child is an inner node, or a leaf with bit 0 set.
+ *	terminal is the leaf of the key ending right after the prefix : it sorts first.
+ *	Node4 / Node16 keep their keys sorted, Node48 maps a byte to slot + 1.
+ */
+struct inner
+{
+	uint8_t			kind;
+	uint16_t		count;
+	uint32_t		prefix_len;
+	unsigned char	prefix[max_prefix];
+	list_node*		terminal;
+};
+
+struct node4 : public inner
+{
+	unsigned char	keys[4];
+	void*			child[4];
+};
+
+struct node16 : public inner
+{
+	unsigned char	keys[16];
+	void*			child[16];
+};
+
+struct node48 : public inner
+{
+	unsigned char	index[256];
+	void*			child[48];
+};
+
+struct node256 : public inner
+{
+	void*			child[256];
+};
+
+inline bool is_leaf(const void* p) { return reinterpret_cast<uintptr_t>(p) & 1; }
+inline list_node* as_leaf(const void* p) { return reinterpret_cast<list_node*>(reinterpret_cast<uintptr_t>(p) & ~uintptr_t(1)); }
+inline void* tag_leaf(list_node* l) { return reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(l) | 1); }
+inline inner* as_inner(void* p) { return static_cast<inner*>(p); }
+
+inline unsigned live_mask(unsigned count) { return (1u << count) - 1; }
+
+inline void** find_child(inner* n, unsigned char b)
+{
+	switch (n->kind) {
+		case NODE4: {
+			node4*	x = static_cast<node4*>(n);
+			for (unsigned i = 0; i < n->count; ++i) if (x->keys[i] == b) return &x->child[i];
+			return 0;
+		}
+		case NODE16: {
+			node16*			x = static_cast<node16*>(n);
+			const unsigned	mask = simd::match_bytes16(x->keys, b) & live_mask(n->count);
+			return mask ? &x->child[__builtin_ctz(mask)] : 0;
+		}
+		case NODE48: {
+			node48*	x = static_cast<node48*>(n);
+			return x->index[b] ? &x->child[x->index[b] - 1] : 0;
+		}
+		default: {
+			node256*	x = static_cast<node256*>(n);
+			return x->child[b] ? &x->child[b] : 0;
+		}
+	}
+}
+
+//	first child on a byte greater than b, -1 for the first child
+inline void* next_child(inner* n, int b)
+{
+	switch (n->kind) {
+		case NODE4: {
+			node4*	x = static_cast<node4*>(n);
+			for (unsigned i = 0; i < n->count; ++i) if (int(x->keys[i]) > b) return x->child[i];
+			return 0;
+		}
+		case NODE16: {
+			node16*	x = static_cast<node16*>(n);
+			if (b < 0) return n->count ? x->child[0] : 0;
+			const unsigned	mask = simd::greater_bytes16(x->keys, static_cast<unsigned char>(b)) & live_mask(n->count);
+			return mask ? x->child[__builtin_ctz(mask)] : 0;
+		}
+		case NODE48: {
+			node48*	x = static_cast<node48*>(n);
+			for (int c = b + 1; c < 256; ++c) if (x->index[c]) return x->child[x->index[c] - 1];
+			return 0;
+		}
+		default: {
+			node256*	x = static_cast<node256*>(n);
+			for (int c = b + 1; c < 256; ++c) if (x->child[c]) return x->child[c];
+			return 0;
+		}
+	}
+}
+
+inline void* last_child(inner* n)
+{
+	switch (n->kind) {
+		case NODE4: return n->count ? static_cast<node4*>(n)->child[n->count - 1] : 0;
+		case NODE16: return n->count ? static_cast<node16*>(n)->child[n->count - 1] : 0;
+		case NODE48: {
+			node48*	x = static_cast<node48*>(n);
+			for (int c = 255; c >= 0; --c) if (x->index[c]) return x->child[x->index[c] - 1];
+			return 0;
+		}
+		default: {
+			node256*	x = static_cast<node256*>(n);
+			for (int c = 255; c >= 0; --c) if (x->child[c]) return x->child[c];
+			return 0;
+		}
+	}
+}
+
+inline list_node* minimum(void* p)
+{
+	while (!is_leaf(p)) {
+		inner*	n = as_inner(p);
+		if (n->terminal) return n->terminal;
+		p = next_child(n, -1);
+	}
+	return as_leaf(p);
+}
+
+inline list_node* maximum(void* p)
+{
+	while (!is_leaf(p)) {
+		inner*	n = as_inner(p);
+		void*	c = last_child(n);
+		if (c == 0) return n->terminal;
+		p = c;
+	}
+	return as_leaf(p);
+}
+
+inline void link_before(list_node* pos, list_node* l)
+{
+	l->prev = pos->prev;
+	l->next = pos;
+	pos->prev->next = l;
+	pos->prev = l;
+}
+
+inline void link_after(list_node* pos, list_node* l) { link_before(pos->next, l); }
+
+inline void unlink(list_node* l)
+{
+	l->prev->next = l->next;
+	l->next->prev = l->prev;
+}
+
+}	//	ART
+
+template<typename V, typename Ref, typename Ptr>
+struct radix_iterator
+{
+	typedef V								value_type;
+	typedef Ptr								pointer;
+	typedef	Ref								reference;
+	typedef std::bidirectional_iterator_tag	iterator_category;
+	typedef ptrdiff_t						difference_type;
+
+	typedef radix_iterator<V, V&, V*>		iterator;
+	typedef radix_iterator					self;
+
+	art::list_node*		node;
+
+	radix_iterator() : node(0) {}
+	explicit radix_iterator(const art::list_node* n) : node(const_cast<art::list_node*>(n)) {}
+	radix_iterator(const iterator& it) : node(it.node) {}
+
+	reference operator*() const { return static_cast<art::leaf<V>*>(node)->value; }
+	pointer operator->() const { return &static_cast<art::leaf<V>*>(node)->value; }
+
+	self& operator++() {
+		node = node->next;
+		return *this;
+	}
+	self operator++(int) {
+		self tmp = *this;
+		node = node->next;
+		return tmp;
+	}
+	self& operator--() {
+		node = node->prev;
+		return *this;
+	}
+	self operator--(int) {
+		self tmp = *this;
+		node = node->prev;
+		return tmp;
+	}
+
+	bool operator==(const self& rhs) const { return node == rhs.node; }
+	bool operator!=(const self& rhs) const { return node != rhs.node; }
+};
+
+template<typename V>
+bool operator==(const radix_iterator<V, V&, V*>& lhs, const radix_iterator<V, const V&, const V*>& rhs)
+{ return lhs.node == rhs.node; }
+template<typename V>
+bool operator!=(const radix_iterator<V, V&, V*>& lhs, const radix_iterator<V, const V&, const V*>& rhs)
+{ return lhs.node != rhs.node; }
+
+/*
+ *	Radix Map : adaptive radix tree (Node4 / 16 / 48 / 256, path compression)
+ *	for integer and std::string keys, with the interface of ft::map.
+ *	A lookup costs one byte per level instead of a key comparison per level.
+ *	Ordered by key bytes : numeric order for integers, std::string order for strings.
+ */
+template<typename K, typename T, typename Alloc = std::allocator<pair<const K, T> > >
+class radix_map
+{
+public:
+	typedef K											key_type;
+	typedef T											mapped_type;
+	typedef pair<const K, T>							value_type;
+	typedef std::less<K>								key_compare;
+	typedef Alloc										allocator_type;
+	typedef value_type&									reference;
+	typedef const value_type&							const_reference;
+	typedef value_type*									pointer;
+	typedef const value_type*							const_pointer;
+	typedef std::size_t									size_type;
+	typedef std::ptrdiff_t								difference_type;
+	typedef radix_iterator<value_type, value_type&, value_type*>				iterator;
+	typedef radix_iterator<value_type, const value_type&, const value_type*>	const_iterator;
+	typedef ft::reverse_iterator<iterator>				reverse_iterator;
+	typedef ft::reverse_iterator<const_iterator>		const_reverse_iterator;
+
+private:
+	typedef art::leaf<value_type>		leaf_type;
+	typedef art::list_node				list_node;
+	typedef art::inner					inner;
+	typedef radix_key_bytes<K>			key_bytes;
+
+	list_node		head;
+	void*			root;
+	size_type		items;
+	allocator_type	alloc;
+
+	static const K& key_of(const list_node* l) { return static_cast<const leaf_type*>(l)->value.first; }
+
+	static int compare(const key_bytes& a, const unsigned char* b, std::size_t blen) {
+		const std::size_t	n = a.size() < blen ? a.size() : blen;
+		const int			c = n ? std::memcmp(a.data(), b, n) : 0;
+		if (c) return c;
+		return a.size() < blen ? -1 : a.size() > blen;
+	}
+
+	/*
+	 *	Allocation
+	 */
+	template<typename N>
+	N* new_node(art::node_kind kind) {
+		typename Alloc::template rebind<N>::other	a(alloc);
+		N*	n = a.allocate(1);
+		std::memset(static_cast<void*>(n), 0, sizeof(N));
+		n->kind = kind;
+		return n;
+	}
+
+	template<typename N>
+	void put_node(inner* n) {
+		typename Alloc::template rebind<N>::other	a(alloc);
+		a.deallocate(static_cast<N*>(n), 1);
+	}
+
+	void free_node(inner* n) {
+		switch (n->kind) {
+			case art::NODE4: put_node<art::node4>(n); break;
+			case art::NODE16: put_node<art::node16>(n); break;
+			case art::NODE48: put_node<art::node48>(n); break;
+			default: put_node<art::node256>(n);
+		}
+	}
+
+	leaf_type* create_leaf(const value_type& v) {
+		typename Alloc::template rebind<leaf_type>::other	a(alloc);
+		leaf_type*	l = a.allocate(1);
+		try {
+			alloc.construct(&l->value, v);
+		}
+		catch (...) {
+			a.deallocate(l, 1);
+			throw ;
+		}
+		return l;
+	}
+
+	void destroy_leaf(list_node* l) {
+		typename Alloc::template rebind<leaf_type>::other	a(alloc);
+		alloc.destroy(&static_cast<leaf_type*>(l)->value);
+		a.deallocate(static_cast<leaf_type*>(l), 1);
+	}
+
+	void destroy(void* p) {
+		if (art::is_leaf(p)) return destroy_leaf(art::as_leaf(p));
+		inner*	n = art::as_inner(p);
+		if (n->terminal) destroy_leaf(n->terminal);
+		switch (n->kind) {
+			case art::NODE4:
+				for (unsigned i = 0; i < n->count; ++i) destroy(static_cast<art::node4*>(n)->child[i]);
+				break;
+			case art::NODE16:
+				for (unsigned i = 0; i < n->count; ++i) destroy(static_cast<art::node16*>(n)->child[i]);
+				break;
+			case art::NODE48:
+				for (unsigned i = 0; i < 48; ++i)
+					if (static_cast<art::node48*>(n)->child[i]) destroy(static_cast<art::node48*>(n)->child[i]);
+				break;
+			default:
+				for (unsigned i = 0; i < 256; ++i)
+					if (static_cast<art::node256*>(n)->child[i]) destroy(static_cast<art::node256*>(n)->child[i]);
+		}
+		free_node(n);
+	}
+
+	/*
+	 *	Prefixes : bytes past max_prefix come from the smallest leaf below n
+	 */
+	static unsigned char prefix_byte(inner* n, std::size_t depth, std::size_t i) {
+		if (i < art::max_prefix) return n->prefix[i];
+		return key_bytes(key_of(art::minimum(n))).data()[depth + i];
+	}
+
+	//	length of the common part of n's prefix and key[depth ...]
+	static std::size_t prefix_mismatch(inner* n, const unsigned char* key, std::size_t len, std::size_t depth) {
+		const std::size_t	stored = n->prefix_len < art::max_prefix ? n->prefix_len : art::max_prefix;
+		std::size_t			i = 0;
+
+		for (; i < stored; ++i)
+			if (depth + i >= len || key[depth + i] != n->prefix[i]) return i;
+		if (n->prefix_len > art::max_prefix) {
+			const key_bytes	lk(key_of(art::minimum(n)));
+			for (; i < n->prefix_len; ++i)
+				if (depth + i >= len || key[depth + i] != lk.data()[depth + i]) return i;
+		}
+		return i;
+	}
+
+	static void set_prefix(inner* n, const unsigned char* bytes, std::size_t len) {
+		n->prefix_len = uint32_t(len);
+		std::memcpy(n->prefix, bytes, len < art::max_prefix ? len : art::max_prefix);
+	}
+
+	static void copy_header(inner* to, const inner* from) {
+		to->count = from->count;
+		to->prefix_len = from->prefix_len;
+		std::memcpy(to->prefix, from->prefix, art::max_prefix);
+		to->terminal = from->terminal;
+	}
+
+	/*
+	 *	Children : add grows a full node, remove shrinks a sparse one. ref is n's slot.
+	 */
+	void add_child(void** ref, inner* n, unsigned char b, void* c) {
+		switch (n->kind) {
+			case art::NODE4: {
+				art::node4*	x = static_cast<art::node4*>(n);
+				if (n->count == 4) {
+					art::node16*	y = new_node<art::node16>(art::NODE16);
+					copy_header(y, x);
+					std::memcpy(y->keys, x->keys, 4);
+					std::memcpy(y->child, x->child, 4 * sizeof(void*));
+					*ref = y;
+					free_node(x);
+					return add_child(ref, y, b, c);
+				}
+				unsigned	pos = 0;
+				while (pos < n->count && x->keys[pos] < b) ++pos;
+				std::memmove(x->keys + pos + 1, x->keys + pos, n->count - pos);
+				std::memmove(x->child + pos + 1, x->child + pos, (n->count - pos) * sizeof(void*));
+				x->keys[pos] = b;
+				x->child[pos] = c;
+				++n->count;
+				return ;
+			}
+			case art::NODE16: {
+				art::node16*	x = static_cast<art::node16*>(n);
+				if (n->count == 16) {
+					art::node48*	y = new_node<art::node48>(art::NODE48);
+					copy_header(y, x);
+					for (unsigned i = 0; i < 16; ++i) {
+						y->index[x->keys[i]] = static_cast<unsigned char>(i + 1);
+						y->child[i] = x->child[i];
+					}
+					*ref = y;
+					free_node(x);
+					return add_child(ref, y, b, c);
+				}
+				const unsigned	greater = simd::greater_bytes16(x->keys, b) & art::live_mask(n->count);
+				const unsigned	pos = greater ? __builtin_ctz(greater) : n->count;
+				std::memmove(x->keys + pos + 1, x->keys + pos, n->count - pos);
+				std::memmove(x->child + pos + 1, x->child + pos, (n->count - pos) * sizeof(void*));
+				x->keys[pos] = b;
+				x->child[pos] = c;
+				++n->count;
+				return ;
+			}
+			case art::NODE48: {
+				art::node48*	x = static_cast<art::node48*>(n);
+				if (n->count == 48) {
+					art::node256*	y = new_node<art::node256>(art::NODE256);
+					copy_header(y, x);
+					for (int i = 0; i < 256; ++i) if (x->index[i]) y->child[i] = x->child[x->index[i] - 1];
+					*ref = y;
+					free_node(x);
+					return add_child(ref, y, b, c);
+				}
+				unsigned	slot = 0;
+				while (x->child[slot]) ++slot;
+				x->child[slot] = c;
+				x->index[b] = static_cast<unsigned char>(slot + 1);
+				++n->count;
+				return ;
+			}
+			default:
+				static_cast<art::node256*>(n)->child[b] = c;
+				++n->count;
+		}
+	}
+
+	void remove_child(void** ref, inner* n, unsigned char b) {
+		switch (n->kind) {
+			case art::NODE4: {
+				art::node4*	x = static_cast<art::node4*>(n);
+				unsigned	pos = 0;
+				while (x->keys[pos] != b) ++pos;
+				std::memmove(x->keys + pos, x->keys + pos + 1, n->count - pos - 1);
+				std::memmove(x->child + pos, x->child + pos + 1, (n->count - pos - 1) * sizeof(void*));
+				--n->count;
+				return ;
+			}
+			case art::NODE16: {
+				art::node16*	x = static_cast<art::node16*>(n);
+				const unsigned	pos = __builtin_ctz(simd::match_bytes16(x->keys, b) & art::live_mask(n->count));
+				std::memmove(x->keys + pos, x->keys + pos + 1, n->count - pos - 1);
+				std::memmove(x->child + pos, x->child + pos + 1, (n->count - pos - 1) * sizeof(void*));
+				if (--n->count == 3) {
+					art::node4*	y = new_node<art::node4>(art::NODE4);
+					copy_header(y, x);
+					std::memcpy(y->keys, x->keys, 3);
+					std::memcpy(y->child, x->child, 3 * sizeof(void*));
+					*ref = y;
+					free_node(x);
+				}
+				return ;
+			}
+			case art::NODE48: {
+				art::node48*	x = static_cast<art::node48*>(n);
+				x->child[x->index[b] - 1] = 0;
+				x->index[b] = 0;
+				if (--n->count == 12) {
+					art::node16*	y = new_node<art::node16>(art::NODE16);
+					copy_header(y, x);
+					unsigned	pos = 0;
+					for (int i = 0; i < 256; ++i) {
+						if (!x->index[i]) continue;
+						y->keys[pos] = static_cast<unsigned char>(i);
+						y->child[pos++] = x->child[x->index[i] - 1];
+					}
+					*ref = y;
+					free_node(x);
+				}
+				return ;
+			}
+			default: {
+				art::node256*	x = static_cast<art::node256*>(n);
+				x->child[b] = 0;
+				if (--n->count == 37) {
+					art::node48*	y = new_node<art::node48>(art::NODE48);
+					copy_header(y, x);
+					unsigned	slot = 0;
+					for (int i = 0; i < 256; ++i) {
+						if (!x->child[i]) continue;
+						y->index[i] = static_cast<unsigned char>(slot + 1);
+						y->child[slot++] = x->child[i];
+					}
+					*ref = y;
+					free_node(x);
+				}
+			}
+		}
+	}
+
+	//	after a removal : a node left with a single entry hands it to its parent
+	void collapse(void** ref) {
+		inner*	n = art::as_inner(*ref);
+
+		if (n->count == 0) {
+			*ref = art::tag_leaf(n->terminal);
+			free_node(n);
+			return ;
+		}
+		if (n->count > 1 || n->terminal) return ;
+
+		art::node4*	x = static_cast<art::node4*>(n);
+		void*		c = x->child[0];
+		if (!art::is_leaf(c)) {
+			inner*			ci = art::as_inner(c);
+			unsigned char	buf[art::max_prefix];
+			std::size_t		len = n->prefix_len < art::max_prefix ? n->prefix_len : art::max_prefix;
+
+			std::memcpy(buf, n->prefix, len);
+			if (len < art::max_prefix) buf[len++] = x->keys[0];
+			for (std::size_t i = 0; i < ci->prefix_len && len < art::max_prefix; ++i) buf[len++] = ci->prefix[i];
+			ci->prefix_len += n->prefix_len + 1;
+			std::memcpy(ci->prefix, buf, len);
+		}
+		*ref = c;
+		free_node(n);
+	}
+
+	/*
+	 *	Lookups
+	 */
+	list_node* find_leaf(const key_type& k) const {
+		const key_bytes			kb(k);
+		const unsigned char*	key = kb.data();
+		const std::size_t		len = kb.size();
+		void*					p = root;
+		std::size_t				depth = 0;
+
+		//	prefixes are only checked on their stored bytes : the leaf has the last word
+		while (p) {
+			if (art::is_leaf(p)) {
+				list_node*	l = art::as_leaf(p);
+				return compare(key_bytes(key_of(l)), key, len) == 0 ? l : 0;
+			}
+			inner*	n = art::as_inner(p);
+			if (n->prefix_len) {
+				if (depth + n->prefix_len > len) return 0;
+				const std::size_t	stored = n->prefix_len < art::max_prefix ? n->prefix_len : art::max_prefix;
+				if (std::memcmp(n->prefix, key + depth, stored) != 0) return 0;
+				depth += n->prefix_len;
+			}
+			if (depth == len) {
+				list_node*	l = n->terminal;
+				return l && compare(key_bytes(key_of(l)), key, len) == 0 ? l : 0;
+			}
+			void**	c = art::find_child(n, key[depth]);
+			if (c == 0) return 0;
+			p = *c;
+			++depth;
+		}
+		return 0;
+	}
+
+	list_node* lower(const key_type& k) const {
+		const key_bytes			kb(k);
+		const unsigned char*	key = kb.data();
+		const std::size_t		len = kb.size();
+		void*					p = root;
+		std::size_t				depth = 0;
+
+		while (p) {
+			if (art::is_leaf(p)) {
+				list_node*	l = art::as_leaf(p);
+				return compare(key_bytes(key_of(l)), key, len) >= 0 ? l : l->next;
+			}
+			inner*	n = art::as_inner(p);
+			if (n->prefix_len) {
+				const std::size_t	m = prefix_mismatch(n, key, len, depth);
+				if (m < n->prefix_len) {
+					if (depth + m == len || key[depth + m] < prefix_byte(n, depth, m)) return art::minimum(p);
+					return art::maximum(p)->next;
+				}
+				depth += n->prefix_len;
+			}
+			if (depth == len) return art::minimum(p);
+			void**	c = art::find_child(n, key[depth]);
+			if (c) {
+				p = *c;
+				++depth;
+				continue;
+			}
+			void*	next = art::next_child(n, key[depth]);
+			return next ? art::minimum(next) : art::maximum(p)->next;
+		}
+		return const_cast<list_node*>(&head);
+	}
+
+	/*
+	 *	Updates
+	 */
+	pair<list_node*, bool> insert_leaf(const value_type& v) {
+		const key_bytes			kb(v.first);
+		const unsigned char*	key = kb.data();
+		const std::size_t		len = kb.size();
+		void**					ref = &root;
+		std::size_t				depth = 0;
+
+		if (root == 0) {
+			leaf_type*	l = create_leaf(v);
+			art::link_before(&head, l);
+			root = art::tag_leaf(l);
+			++items;
+			return pair<list_node*, bool>(l, true);
+		}
+		for (;;) {
+			void*	p = *ref;
+
+			if (art::is_leaf(p)) {
+				list_node*				old = art::as_leaf(p);
+				const key_bytes			ok(key_of(old));
+				const unsigned char*	okey = ok.data();
+				std::size_t				i = depth;
+
+				while (i < len && i < ok.size() && key[i] == okey[i]) ++i;
+				if (i == len && i == ok.size()) return pair<list_node*, bool>(old, false);
+
+				art::node4*	n = new_node<art::node4>(art::NODE4);
+				leaf_type*	l;
+				try {
+					l = create_leaf(v);
+				}
+				catch (...) {
+					free_node(n);
+					throw ;
+				}
+				set_prefix(n, key + depth, i - depth);
+				void*	slot = n;
+				if (i == ok.size()) n->terminal = old;
+				else add_child(&slot, n, okey[i], p);
+				if (i == len) n->terminal = l;
+				else add_child(&slot, n, key[i], art::tag_leaf(l));
+				if (i == len || (i < ok.size() && key[i] < okey[i])) art::link_before(old, l);
+				else art::link_after(old, l);
+				*ref = n;
+				++items;
+				return pair<list_node*, bool>(l, true);
+			}
+
+			inner*	n = art::as_inner(p);
+			if (n->prefix_len) {
+				const std::size_t	m = prefix_mismatch(n, key, len, depth);
+				if (m < n->prefix_len) {
+					art::node4*		top = new_node<art::node4>(art::NODE4);
+					leaf_type*		l;
+					try {
+						l = create_leaf(v);
+					}
+					catch (...) {
+						free_node(top);
+						throw ;
+					}
+					const unsigned char	nb = prefix_byte(n, depth, m);
+					const bool			before = depth + m == len || key[depth + m] < nb;
+					list_node*			neighbour = before ? art::minimum(n) : art::maximum(n);
+
+					//	n keeps what follows the split byte
+					const std::size_t	rest = n->prefix_len - m - 1;
+					if (n->prefix_len <= art::max_prefix) std::memmove(n->prefix, n->prefix + m + 1, rest);
+					else {
+						const key_bytes	lk(key_of(art::minimum(n)));
+						std::memcpy(n->prefix, lk.data() + depth + m + 1, rest < art::max_prefix ? rest : art::max_prefix);
+					}
+					n->prefix_len = uint32_t(rest);
+
+					set_prefix(top, key + depth, m);
+					void*	slot = top;
+					add_child(&slot, top, nb, n);
+					if (depth + m == len) top->terminal = l;
+					else add_child(&slot, top, key[depth + m], art::tag_leaf(l));
+					if (before) art::link_before(neighbour, l);
+					else art::link_after(neighbour, l);
+					*ref = top;
+					++items;
+					return pair<list_node*, bool>(l, true);
+				}
+				depth += n->prefix_len;
+			}
+			if (depth == len) {
+				if (n->terminal) return pair<list_node*, bool>(n->terminal, false);
+				leaf_type*	l = create_leaf(v);
+				art::link_before(art::minimum(n), l);
+				n->terminal = l;
+				++items;
+				return pair<list_node*, bool>(l, true);
+			}
+			void**	c = art::find_child(n, key[depth]);
+			if (c) {
+				ref = c;
+				++depth;
+				continue;
+			}
+			leaf_type*	l = create_leaf(v);
+			void*		next = art::next_child(n, key[depth]);
+			if (next) art::link_before(art::minimum(next), l);
+			else art::link_after(art::maximum(n), l);
+			try {
+				add_child(ref, n, key[depth], art::tag_leaf(l));
+			}
+			catch (...) {
+				art::unlink(l);
+				destroy_leaf(l);
+				throw ;
+			}
+			++items;
+			return pair<list_node*, bool>(l, true);
+		}
+	}
+
+	size_type erase_key(const key_type& k) {
+		const key_bytes			kb(k);
+		const unsigned char*	key = kb.data();
+		const std::size_t		len = kb.size();
+		void**					ref = &root;
+		std::size_t				depth = 0;
+
+		if (root == 0) return 0;
+		if (art::is_leaf(root)) {
+			list_node*	l = art::as_leaf(root);
+			if (compare(key_bytes(key_of(l)), key, len) != 0) return 0;
+			root = 0;
+			return release(l);
+		}
+		for (;;) {
+			inner*	n = art::as_inner(*ref);
+			if (n->prefix_len) {
+				if (depth + n->prefix_len > len) return 0;
+				const std::size_t	stored = n->prefix_len < art::max_prefix ? n->prefix_len : art::max_prefix;
+				if (std::memcmp(n->prefix, key + depth, stored) != 0) return 0;
+				depth += n->prefix_len;
+			}
+			if (depth == len) {
+				list_node*	l = n->terminal;
+				if (l == 0 || compare(key_bytes(key_of(l)), key, len) != 0) return 0;
+				n->terminal = 0;
+				collapse(ref);
+				return release(l);
+			}
+			void**	c = art::find_child(n, key[depth]);
+			if (c == 0) return 0;
+			if (art::is_leaf(*c)) {
+				list_node*	l = art::as_leaf(*c);
+				if (compare(key_bytes(key_of(l)), key, len) != 0) return 0;
+				remove_child(ref, n, key[depth]);
+				collapse(ref);
+				return release(l);
+			}
+			ref = c;
+			++depth;
+		}
+	}
+
+	size_type release(list_node* l) {
+		art::unlink(l);
+		destroy_leaf(l);
+		--items;
+		return 1;
+	}
+
+	void reset_head() { head.prev = head.next = &head; }
+
+	void relink_head() {
+		if (items == 0) return reset_head();
+		head.next->prev = &head;
+		head.prev->next = &head;
+	}
+
+public:
+	explicit radix_map(const allocator_type& a = allocator_type()) : root(0), items(0), alloc(a) { reset_head(); }
+
+	template<typename Iter>
+	radix_map(Iter first, Iter last, const allocator_type& a = allocator_type()) : root(0), items(0), alloc(a) {
+		reset_head();
+		insert(first, last);
+	}
+
+	radix_map(const radix_map& other) : root(0), items(0), alloc(other.alloc) {
+		reset_head();
+		try {
+			insert(other.begin(), other.end());
+		}
+		catch (...) {
+			clear();
+			throw ;
+		}
+	}
+
+	~radix_map() { clear(); }
+
+	radix_map& operator=(const radix_map& other) {
+		if (this != &other) {
+			radix_map	tmp(other);
+			swap(tmp);
+		}
+		return *this;
+	}
+
+	allocator_type get_allocator() const { return alloc; }
+
+	iterator begin() { return iterator(head.next); }
+	const_iterator begin() const { return const_iterator(head.next); }
+	iterator end() { return iterator(&head); }
+	const_iterator end() const { return const_iterator(&head); }
+	reverse_iterator rbegin() { return reverse_iterator(end()); }
+	const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+	reverse_iterator rend() { return reverse_iterator(begin()); }
+	const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+	bool empty() const { return items == 0; }
+	size_type size() const { return items; }
+	size_type max_size() const { return alloc.max_size(); }
+	key_compare key_comp() const { return key_compare(); }
+
+	mapped_type& operator[](const key_type& k) {
+		list_node*	l = find_leaf(k);
+		if (l == 0) l = insert_leaf(value_type(k, mapped_type())).first;
+		return static_cast<leaf_type*>(l)->value.second;
+	}
+
+	mapped_type& at(const key_type& k) {
+		list_node*	l = find_leaf(k);
+		if (l == 0) throw std::out_of_range("Range Exception");
+		return static_cast<leaf_type*>(l)->value.second;
+	}
+	const mapped_type& at(const key_type& k) const {
+		list_node*	l = find_leaf(k);
+		if (l == 0) throw std::out_of_range("Range Exception");
+		return static_cast<leaf_type*>(l)->value.second;
+	}
+
+	pair<iterator, bool> insert(const value_type& v) {
+		pair<list_node*, bool>	ret = insert_leaf(v);
+		return pair<iterator, bool>(iterator(ret.first), ret.second);
+	}
+	iterator insert(iterator, const value_type& v) { return insert(v).first; }
+	template<typename Iter>
+	void insert(Iter first, Iter last) {
+		for (; first != last; ++first) insert_leaf(*first);
+	}
+
+	void erase(iterator pos) { erase_key(pos->first); }
+	size_type erase(const key_type& k) { return erase_key(k); }
+	void erase(iterator first, iterator last) {
+		while (first != last) erase(first++);
+	}
+
+	void swap(radix_map& other) {
+		std::swap(root, other.root);
+		std::swap(items, other.items);
+		std::swap(head, other.head);
+		std::swap(alloc, other.alloc);
+		relink_head();
+		other.relink_head();
+	}
+
+	void clear() {
+		if (root) destroy(root);
+		root = 0;
+		items = 0;
+		reset_head();
+	}
+
+	iterator find(const key_type& k) {
+		list_node*	l = find_leaf(k);
+		return l ? iterator(l) : end();
+	}
+	const_iterator find(const key_type& k) const {
+		list_node*	l = find_leaf(k);
+		return l ? const_iterator(l) : end();
+	}
+	size_type count(const key_type& k) const { return find_leaf(k) != 0; }
+
+	iterator lower_bound(const key_type& k) { return iterator(lower(k)); }
+	const_iterator lower_bound(const key_type& k) const { return const_iterator(lower(k)); }
+	iterator upper_bound(const key_type& k) {
+		iterator	it = lower_bound(k);
+		return it != end() && !(k < it->first) ? ++it : it;
+	}
+	const_iterator upper_bound(const key_type& k) const {
+		const_iterator	it = lower_bound(k);
+		return it != end() && !(k < it->first) ? ++it : it;
+	}
+	pair<iterator, iterator> equal_range(const key_type& k) {
+		return pair<iterator, iterator>(lower_bound(k), upper_bound(k));
+	}
+	pair<const_iterator, const_iterator> equal_range(const key_type& k) const {
+		return pair<const_iterator, const_iterator>(lower_bound(k), upper_bound(k));
+	}
+};
+
+template<typename K, typename T, typename Alloc>
+bool operator==(const radix_map<K, T, Alloc>& lhs, const radix_map<K, T, Alloc>& rhs)
+{ return lhs.size() == rhs.size() && ft::equal(lhs.begin(), lhs.end(), rhs.begin()); }
+
+template<typename K, typename T, typename Alloc>
+bool operator!=(const radix_map<K, T, Alloc>& lhs, const radix_map<K, T, Alloc>& rhs)
+{ return !(lhs == rhs); }
+
+template<typename K, typename T, typename Alloc>
+void swap(radix_map<K, T, Alloc>& lhs, radix_map<K, T, Alloc>& rhs) { lhs.swap(rhs); }
+
+}	//	FT
+
+#endif
@@ -0,0 +1,196 @@
+#ifndef RADIX_SORT_HPP
+# define RADIX_SORT_HPP
+
+#include "algorithm.hpp"
+#include "pair.hpp"
+#include "traits.hpp"
+#include "vector.hpp"
+
+#include <cstring>
+#include <memory>
+
+namespace ft
+{
+
+/*
+ *	Default key : the value itself, or first for a pair
+ */
+template<typename T>
+struct radix_key
+{
+	const T& operator()(const T& x) const { return x; }
+};
+
+template<typename T, typename U>
+struct radix_key<pair<T, U> >
+{
+	const T& operator()(const pair<T, U>& x) const { return x.first; }
+};
+
+namespace radix
+{
+
+//	below this a comparison sort wins over the histogram passes
+static const std::ptrdiff_t threshold = 256;
+
+/*
+ *	Integral key mapped to an unsigned integer with the same order
+ */
+template<typename K>
+struct key_traits
+{
+	static const int			bytes = sizeof(K);
+	static const bool			is_signed = K(-1) < K(0);
+
+	static unsigned long long bits(K k) {
+		unsigned long long u = static_cast<unsigned long long>(k);
+		if (is_signed) u ^= 1ULL << (bytes * 8 - 1);
+		if (bytes < 8) u &= (1ULL << (bytes * 8)) - 1;
+		return u;
+	}
+};
+
+template<typename KeyFunc>
+struct key_less
+{
+	KeyFunc	key;
+
+	key_less(const KeyFunc& k) : key(k) {}
+	template<typename T>
+	bool operator()(const T& lhs, const T& rhs) const { return key(lhs) < key(rhs); }
+};
+
+/*
+ *	Scratch space from the caller's allocator, copy constructed so passes can assign into it
+ */
+template<typename T, typename Alloc>
+class scratch_buffer
+{
+	typedef typename Alloc::template rebind<T>::other	allocator_type;
+
+	allocator_type	alloc;
+	T*				buf;
+	std::size_t		len;
+
+	scratch_buffer(const scratch_buffer&);
+	scratch_buffer& operator=(const scratch_buffer&);
+
+public:
+	template<typename InputIt>
+	scratch_buffer(InputIt first, std::size_t n, const Alloc& a) : alloc(a), buf(0), len(n) {
+		buf = alloc.allocate(n);
+		try {
+			std::uninitialized_copy(first, first + n, buf);
+		}
+		catch (...) {
+			alloc.deallocate(buf, n);
+			throw ;
+		}
+	}
+	~scratch_buffer() {
+		for (std::size_t i = 0; i < len; ++i) alloc.destroy(buf + i);
+		alloc.deallocate(buf, len);
+	}
+	T* begin() const { return buf; }
+};
+
+template<typename Src, typename Dst, typename KeyFunc, typename K>
+void scatter(Src src, Dst dst, std::ptrdiff_t n, int shift, std::size_t* offset, KeyFunc key, const K*) {
+	for (std::ptrdiff_t i = 0; i < n; ++i) {
+		const unsigned byte = (key_traits<K>::bits(key(src[i])) >> shift) & 0xff;
+		dst[offset[byte]++] = src[i];
+	}
+}
+
+//	keys with no byte order to histogram : a plain stable sort
+template<typename RandomIt, typename KeyFunc, typename Alloc, typename K>
+void sort(RandomIt first, RandomIt last, KeyFunc key, const Alloc&, const K*, false_type) {
+	ft::stable_sort(first, last, key_less<KeyFunc>(key));
+}
+
+/*
+ *	LSD : one histogram per key byte from a single read of the input,
+ *	then a stable scatter per byte. Bytes shared by every key are skipped.
+ */
+template<typename RandomIt, typename KeyFunc, typename Alloc, typename K>
+void sort(RandomIt first, RandomIt last, KeyFunc key, const Alloc& alloc, const K* tag, true_type) {
+	typedef typename iterator_traits<RandomIt>::value_type	value_type;
+	typedef key_traits<K>									traits;
+	const std::ptrdiff_t	n = last - first;
+	const int				bytes = traits::bytes;
+
+	if (n < threshold) {
+		ft::stable_sort(first, last, key_less<KeyFunc>(key));
+		return ;
+	}
+
+	std::size_t	count[8][256];
+	std::memset(count, 0, sizeof(count));
+	for (RandomIt it = first; it != last; ++it) {
+		unsigned long long u = traits::bits(key(*it));
+		for (int b = 0; b < bytes; ++b, u >>= 8) ++count[b][u & 0xff];
+	}
+
+	scratch_buffer<value_type, Alloc>	buf(first, n, alloc);
+	const unsigned long long			head = traits::bits(key(*first));
+	bool								in_buf = false;
+
+	for (int b = 0; b < bytes; ++b) {
+		if (count[b][(head >> (8 * b)) & 0xff] == std::size_t(n)) continue;
+
+		std::size_t offset[256];
+		std::size_t sum = 0;
+		for (int i = 0; i < 256; ++i) {
+			offset[i] = sum;
+			sum += count[b][i];
+		}
+		if (in_buf) radix::scatter(buf.begin(), first, n, 8 * b, offset, key, tag);
+		else radix::scatter(first, buf.begin(), n, 8 * b, offset, key, tag);
+		in_buf = !in_buf;
+	}
+	if (in_buf) ft::copy(buf.begin(), buf.begin() + n, first);
+}
+
+//	chosen at compile time, so key_traits is never instantiated for a string or a 128 bit key
+template<typename RandomIt, typename KeyFunc, typename Alloc, typename K>
+void sort(RandomIt first, RandomIt last, KeyFunc key, const Alloc& alloc, const K&) {
+	typedef integral_constant<bool, is_integral<K>::value && sizeof(K) <= 8>	histogram;
+	radix::sort(first, last, key, alloc, static_cast<const K*>(0), histogram());
+}
+
+}	//	RADIX
+
+/*
+ *	radix_sort : stable sort on an integral key, ft::stable_sort on any other.
+ *	key(x) extracts the key (default : x, or x.first for pairs),
+ *	alloc provides the n element scratch buffer.
+ */
+template<typename RandomIt, typename KeyFunc, typename Alloc>
+void radix_sort(RandomIt first, RandomIt last, KeyFunc key, const Alloc& alloc) {
+	if (last - first < 2) return ;
+	radix::sort(first, last, key, alloc, key(*first));
+}
+
+template<typename RandomIt, typename KeyFunc>
+void radix_sort(RandomIt first, RandomIt last, KeyFunc key) {
+	ft::radix_sort(first, last, key, std::allocator<typename iterator_traits<RandomIt>::value_type>());
+}
+
+template<typename RandomIt>
+void radix_sort(RandomIt first, RandomIt last) {
+	ft::radix_sort(first, last, radix_key<typename iterator_traits<RandomIt>::value_type>());
+}
+
+template<typename T, typename Alloc>
+void radix_sort(ft::vector<T, Alloc>& v) {
+	ft::radix_sort(v.begin(), v.end(), radix_key<T>(), v.get_allocator());
+}
+
+template<typename T, typename Alloc, typename KeyFunc>
+void radix_sort(ft::vector<T, Alloc>& v, KeyFunc key) {
+	ft::radix_sort(v.begin(), v.end(), key, v.get_allocator());
+}
+
+}	//	FT
+
+#endif
@@ -6,7 +6,12 @@
 # include "pair.hpp"
 # include "algorithm.hpp"
 
+# include <functional>
+# include <limits>
 # include <memory>
+# include <string>
+
+# include <stdint.h>
 
 namespace ft
 {
@@ -15,36 +20,29 @@ enum eColor {
 	BLACK
 };
 
+/*
+ *	-DFT_RBTREE_COMPACT packs the color into the parent pointer : nodes are pointer
+ *	aligned so bit 0 is free, and RED / BLACK are 0 / 1.
+ *	A map<int, int> node drops from 40 to 32 bytes.
+ */
 struct tree_node
 {
 	typedef tree_node* 			node_ptr;
 	typedef const tree_node*	const_node_ptr;
 
+#ifdef FT_RBTREE_COMPACT
+	uintptr_t	parent_color;		//	parent address, color in bit 0
+#else
 	eColor		color;
 	node_ptr	parent;
+#endif
 	node_ptr	left;
 	node_ptr	right;
 
-	static node_ptr	minimum(node_ptr ptr)
-	{
-		while(ptr->left != 0) ptr = ptr->left;
-		return ptr;
-	}
-	static node_ptr	maximum(node_ptr ptr)
-	{
-		while(ptr->right != 0) ptr = ptr->right;
-		return ptr;
-	}
-	static const_node_ptr minimum(const_node_ptr ptr)
-	{
-		while(ptr->left != 0) ptr = ptr->left;
-		return ptr;
-	}
-	static const_node_ptr maximum(const_node_ptr ptr)
-	{
-		while(ptr->right != 0) ptr = ptr->right;
-		return ptr;
-	}
+	static node_ptr	minimum(node_ptr ptr);
+	static node_ptr	maximum(node_ptr ptr);
+	static const_node_ptr minimum(const_node_ptr ptr);
+	static const_node_ptr maximum(const_node_ptr ptr);
 };
 
 template<typename T>
@@ -54,62 +52,507 @@ struct rb_node : public tree_node
 	T						value;
 };
 
-tree_node*
-tree_increment(tree_node* ptr)
+/*
+ *	Node Traits : how the tree algorithms read and write a node.
+ *	A missing child is written with set_*_thread(node, neighbour) :
+ *	plain links store null, threaded links remember the in-order neighbour.
+ */
+struct plain_node_traits
 {
-	if (ptr->right)
+	typedef tree_node			node;
+	typedef tree_node*			node_ptr;
+	typedef const tree_node*	const_node_ptr;
+
+	static const bool	threaded = false;
+	static const bool	augmented = false;
+
+	//	recomputes what x caches about its subtree, from its children : augmented traits only
+	static void update(node_ptr) {}
+
+#ifdef FT_RBTREE_COMPACT
+	static node_ptr get_parent(const_node_ptr n) { return reinterpret_cast<node_ptr>(n->parent_color & ~uintptr_t(1)); }
+	static void set_parent(node_ptr n, node_ptr p) {
+		n->parent_color = reinterpret_cast<uintptr_t>(p) | (n->parent_color & 1);
+	}
+	static eColor get_color(const_node_ptr n) { return eColor(n->parent_color & 1); }
+	static void set_color(node_ptr n, eColor c) { n->parent_color = (n->parent_color & ~uintptr_t(1)) | c; }
+#else
+	static node_ptr get_parent(const_node_ptr n) { return n->parent; }
+	static void set_parent(node_ptr n, node_ptr p) { n->parent = p; }
+	static eColor get_color(const_node_ptr n) { return n->color; }
+	static void set_color(node_ptr n, eColor c) { n->color = c; }
+#endif
+
+	static node_ptr get_left(const_node_ptr n) { return n->left; }
+	static void set_left(node_ptr n, node_ptr l) { n->left = l; }
+	static node_ptr get_left_thread(const_node_ptr) { return 0; }
+	static void set_left_thread(node_ptr n, node_ptr) { n->left = 0; }
+
+	static node_ptr get_right(const_node_ptr n) { return n->right; }
+	static void set_right(node_ptr n, node_ptr r) { n->right = r; }
+	static node_ptr get_right_thread(const_node_ptr) { return 0; }
+	static void set_right_thread(node_ptr n, node_ptr) { n->right = 0; }
+};
+
+/*
+ *	Threaded : a missing child link holds the predecessor (left) or successor (right)
+ *	with the low bit set, so ++ and -- never climb parent pointers.
+ *	The extremes thread to the header, whose own left / right stay plain.
+ */
+struct threaded_node_traits : public plain_node_traits
+{
+	static const bool	threaded = true;
+
+	static bool is_thread(const_node_ptr link) { return reinterpret_cast<uintptr_t>(link) & 1; }
+	static node_ptr make_thread(node_ptr target) {
+		return reinterpret_cast<node_ptr>(reinterpret_cast<uintptr_t>(target) | 1);
+	}
+	static node_ptr thread_target(const_node_ptr link) {
+		return reinterpret_cast<node_ptr>(reinterpret_cast<uintptr_t>(link) & ~uintptr_t(1));
+	}
+
+	static node_ptr get_left(const_node_ptr n) { return is_thread(n->left) ? 0 : n->left; }
+	static node_ptr get_left_thread(const_node_ptr n) { return is_thread(n->left) ? thread_target(n->left) : 0; }
+	static void set_left_thread(node_ptr n, node_ptr pred) { n->left = make_thread(pred); }
+
+	static node_ptr get_right(const_node_ptr n) { return is_thread(n->right) ? 0 : n->right; }
+	static node_ptr get_right_thread(const_node_ptr n) { return is_thread(n->right) ? thread_target(n->right) : 0; }
+	static void set_right_thread(node_ptr n, node_ptr succ) { n->right = make_thread(succ); }
+};
+
+//	-DFT_RBTREE_THREADED switches every tree of the program to threaded links
+#ifdef FT_RBTREE_THREADED
+typedef threaded_node_traits	tree_node_traits;
+#else
+typedef plain_node_traits		tree_node_traits;
+#endif
+
+/*
+ *	Red Black Tree algorithms on any node layout described by Traits.
+ *	The header's parent is the root, its left / right the leftmost / rightmost node.
+ */
+template<typename Traits>
+struct rb_algorithms
+{
+	typedef Traits							traits;
+	typedef typename Traits::node_ptr		node_ptr;
+
+	static node_ptr	minimum(node_ptr x)
+	{
+		for (node_ptr l; (l = traits::get_left(x)) != 0; ) x = l;
+		return x;
+	}
+	static node_ptr	maximum(node_ptr x)
+	{
+		for (node_ptr r; (r = traits::get_right(x)) != 0; ) x = r;
+		return x;
+	}
+
+	static bool is_header(node_ptr x)
 	{
-		ptr = ptr->right;
-		while (ptr->left) ptr = ptr->left;
+		return traits::get_color(x) == RED && traits::get_parent(traits::get_parent(x)) == x;
 	}
-	else
+
+	static node_ptr increment(node_ptr x)
 	{
-		tree_node*	tmp = ptr->parent;
-		while (ptr == tmp->right)
+		node_ptr	r = traits::get_right(x);
+
+		if (r) return minimum(r);
+		if (traits::threaded) return traits::get_right_thread(x);
+
+		node_ptr	y = traits::get_parent(x);
+		while (x == traits::get_right(y))
 		{
-			ptr = tmp;
-			tmp = tmp->parent;
+			x = y;
+			y = traits::get_parent(y);
 		}
-		if (ptr->right != tmp)
-			ptr = tmp;
+		if (traits::get_right(x) != y)
+			x = y;
+		return x;
 	}
-	return ptr;
-}
 
-const tree_node*
-tree_increment(const tree_node* ptr)
-{
-	return tree_increment(const_cast<tree_node*>(ptr));
-}
+	static node_ptr decrement(node_ptr x)
+	{
+		if (is_header(x)) return traits::get_right(x);
 
-tree_node*
-tree_decrement(tree_node* ptr)
-{
-	if (ptr->color == RED && ptr->parent->parent == ptr)
-		ptr = ptr->right;
-	else if (ptr->left)
+		node_ptr	l = traits::get_left(x);
+
+		if (l) return maximum(l);
+		if (traits::threaded) return traits::get_left_thread(x);
+
+		node_ptr	y = traits::get_parent(x);
+		while (x == traits::get_left(y))
+		{
+			x = y;
+			y = traits::get_parent(y);
+		}
+		return y;
+	}
+
+	static void replace_child(node_ptr x, node_ptr y, node_ptr header)
+	{
+		node_ptr	p = traits::get_parent(x);
+
+		if (p == header) traits::set_parent(header, y);
+		else if (x == traits::get_left(p)) traits::set_left(p, y);
+		else traits::set_right(p, y);
+	}
+
+	static void rotate_left(node_ptr x, node_ptr header)
+	{
+		node_ptr	y = traits::get_right(x);
+		node_ptr	yl = traits::get_left(y);
+
+		if (yl)
+		{
+			traits::set_right(x, yl);
+			traits::set_parent(yl, x);
+		}
+		else traits::set_right_thread(x, y);
+		traits::set_parent(y, traits::get_parent(x));
+		replace_child(x, y, header);
+		traits::set_left(y, x);
+		traits::set_parent(x, y);
+		if (traits::augmented)
+		{
+			traits::update(x);
+			traits::update(y);
+		}
+	}
+
+	static void rotate_right(node_ptr x, node_ptr header)
+	{
+		node_ptr	y = traits::get_left(x);
+		node_ptr	yr = traits::get_right(y);
+
+		if (yr)
+		{
+			traits::set_left(x, yr);
+			traits::set_parent(yr, x);
+		}
+		else traits::set_left_thread(x, y);
+		traits::set_parent(y, traits::get_parent(x));
+		replace_child(x, y, header);
+		traits::set_right(y, x);
+		traits::set_parent(x, y);
+		if (traits::augmented)
+		{
+			traits::update(x);
+			traits::update(y);
+		}
+	}
+
+	//	x and every ancestor up to the root, after the subtree under x changed
+	static void update_path(node_ptr x, node_ptr header)
+	{
+		for (; x != header; x = traits::get_parent(x)) traits::update(x);
+	}
+
+	//	every node of the subtree, children first
+	static void update_subtree(node_ptr x)
 	{
-		tree_node* tmp = ptr->left;
-		while(tmp->right) tmp = tmp->right;
-		ptr = tmp;
+		if (x == 0) return ;
+		update_subtree(traits::get_left(x));
+		update_subtree(traits::get_right(x));
+		traits::update(x);
 	}
-	else
+
+	static void insert_rebalance(const bool insert_left, node_ptr target, node_ptr parent, node_ptr header)
 	{
-		tree_node*	tmp = ptr->parent;
-		while (ptr == tmp->left)
+		traits::set_parent(target, parent);
+		traits::set_color(target, RED);
+
+		/**
+		 * @brief : Insert, First node should be Left node
+		 */
+		if (insert_left)
 		{
-			ptr = tmp;
-			tmp = tmp->parent;
+			traits::set_left_thread(target, parent == header ? header : traits::get_left_thread(parent));
+			traits::set_right_thread(target, parent);
+			traits::set_left(parent, target);
+			if (parent == header)
+			{
+				traits::set_parent(header, target);
+				traits::set_right(header, target);
+			} else if (parent == traits::get_left(header))
+				traits::set_left(header, target);
+		} else {
+			traits::set_left_thread(target, parent);
+			traits::set_right_thread(target, traits::get_right_thread(parent));
+			traits::set_right(parent, target);
+			if (parent == traits::get_right(header))
+				traits::set_right(header, target);
+		}
+		//	rotations below keep each rotated subtree's contents : only this path changes
+		if (traits::augmented) update_path(target, header);
+
+		/**
+		 * @brief : Rebalance
+		 */
+		while (target != traits::get_parent(header) && traits::get_color(traits::get_parent(target)) == RED) {
+			node_ptr const	par = traits::get_parent(target);
+			node_ptr const	parpar = traits::get_parent(par);
+
+			if (par == traits::get_left(parpar)) {
+				node_ptr const	tmp = traits::get_right(parpar);
+
+				if (tmp && traits::get_color(tmp) == RED) {	//	#Case 1
+					traits::set_color(par, BLACK);
+					traits::set_color(tmp, BLACK);
+					traits::set_color(parpar, RED);
+					target = parpar;
+				} else {										//	#Case 2
+					if (target == traits::get_right(par)) {
+						target = par;
+						rotate_left(target, header);
+					}
+					traits::set_color(traits::get_parent(target), BLACK);
+					traits::set_color(parpar, RED);
+					rotate_right(parpar, header);
+				}
+			}
+			else {
+				node_ptr const	tmp = traits::get_left(parpar);
+
+				if (tmp && traits::get_color(tmp) == RED) {	//	#Case 1
+					traits::set_color(par, BLACK);
+					traits::set_color(tmp, BLACK);
+					traits::set_color(parpar, RED);
+					target = parpar;
+				} else {										//	#Case 2
+					if (target == traits::get_left(par)) {
+						target = par;
+						rotate_right(target, header);
+					}
+					traits::set_color(traits::get_parent(target), BLACK);
+					traits::set_color(parpar, RED);
+					rotate_left(parpar, header);
+				}
+			}
 		}
-		ptr = tmp;
+		traits::set_color(traits::get_parent(header), BLACK);
 	}
-	return ptr;
+
+	static bool is_black(node_ptr x) { return x == 0 || traits::get_color(x) == BLACK; }
+
+	static node_ptr rebalance_erase(node_ptr const z, node_ptr header)
+	{
+		node_ptr const	zl = traits::get_left(z);
+		node_ptr const	zr = traits::get_right(z);
+		node_ptr		y = z;
+		node_ptr		x = 0;
+		node_ptr		x_parent = 0;
+
+		if (zl == 0)			// z has at most one non-null child. y == z.
+			x = zr;				// x might be null.
+		else if (zr == 0)		// z has exactly one non-null child. y == z.
+			x = zl;				// x is not null.
+		else
+		{
+			// z has two non-null children.
+			y = minimum(zr);	// Set y to z's successor.  x might be null.
+			x = traits::get_right(y);
+		}
+
+		if (y != z)
+		{
+			// relink y in place of z.  y is z's successor
+			if (traits::threaded) traits::set_right_thread(maximum(zl), y);
+			traits::set_parent(zl, y);
+			traits::set_left(y, zl);
+			if (y != zr)
+			{
+				x_parent = traits::get_parent(y);
+				if (x)
+				{
+					traits::set_parent(x, x_parent);
+					traits::set_left(x_parent, x);		// y must be a left child
+				}
+				else traits::set_left_thread(x_parent, y);
+				traits::set_right(y, zr);
+				traits::set_parent(zr, y);
+			}
+			else
+				x_parent = y;
+
+			replace_child(z, y, header);
+			traits::set_parent(y, traits::get_parent(z));
+			const eColor	c = traits::get_color(y);
+			traits::set_color(y, traits::get_color(z));
+			traits::set_color(z, c);
+			y = z;
+			// y now points to node to be actually deleted
+		}
+		else
+		{
+			// y == z
+			x_parent = traits::get_parent(z);
+			if (x)
+			{
+				traits::set_parent(x, x_parent);
+				replace_child(z, x, header);
+				if (traits::threaded)
+				{
+					if (zl) traits::set_right_thread(maximum(x), traits::get_right_thread(z));
+					else traits::set_left_thread(minimum(x), traits::get_left_thread(z));
+				}
+			}
+			else if (x_parent == header)
+				traits::set_parent(header, 0);
+			else if (traits::get_left(x_parent) == z)
+				traits::set_left_thread(x_parent, traits::get_left_thread(z));
+			else
+				traits::set_right_thread(x_parent, traits::get_right_thread(z));
+
+			if (traits::get_left(header) == z)
+			{
+				if (zr == 0)		// z's left must be null also
+					traits::set_left(header, x_parent);
+				else				// makes leftmost == header if z == root
+					traits::set_left(header, minimum(x));
+			}
+
+			if (traits::get_right(header) == z)
+			{
+				if (zl == 0)		// z's right must be null also
+					traits::set_right(header, x_parent);
+				else				// makes rightmost == header if z == root
+					traits::set_right(header, maximum(x));	// x == z's left
+			}
+		}
+		if (traits::augmented) update_path(x_parent, header);
+
+		if (traits::get_color(y) != RED)
+		{
+			while (x != traits::get_parent(header) && is_black(x))
+			{
+				if (x == traits::get_left(x_parent))
+				{
+					node_ptr	w = traits::get_right(x_parent);
+					if (traits::get_color(w) == RED)	// Case 1
+					{
+						traits::set_color(w, BLACK);
+						traits::set_color(x_parent, RED);
+						rotate_left(x_parent, header);
+						w = traits::get_right(x_parent);
+					}
+
+					if (is_black(traits::get_left(w)) && is_black(traits::get_right(w)))	// Case 2
+					{
+						traits::set_color(w, RED);
+						x = x_parent;
+						x_parent = traits::get_parent(x_parent);
+					}
+					else
+					{
+						if (is_black(traits::get_right(w)))	// Case 3
+						{
+							traits::set_color(traits::get_left(w), BLACK);
+							traits::set_color(w, RED);
+							rotate_right(w, header);
+							w = traits::get_right(x_parent);
+						}
+						traits::set_color(w, traits::get_color(x_parent));	// Case 4
+						traits::set_color(x_parent, BLACK);
+						if (traits::get_right(w))
+							traits::set_color(traits::get_right(w), BLACK);
+						rotate_left(x_parent, header);
+						break;
+					}
+				}
+				else
+				{
+					// same as above, with right <-> left.
+					node_ptr	w = traits::get_left(x_parent);
+					if (traits::get_color(w) == RED)	// Case 1
+					{
+						traits::set_color(w, BLACK);
+						traits::set_color(x_parent, RED);
+						rotate_right(x_parent, header);
+						w = traits::get_left(x_parent);
+					}
+
+					if (is_black(traits::get_right(w)) && is_black(traits::get_left(w)))	// Case 2
+					{
+						traits::set_color(w, RED);
+						x = x_parent;
+						x_parent = traits::get_parent(x_parent);
+					}
+					else
+					{
+						if (is_black(traits::get_left(w)))	// Case 3
+						{
+							traits::set_color(traits::get_right(w), BLACK);
+							traits::set_color(w, RED);
+							rotate_left(w, header);
+							w = traits::get_left(x_parent);
+						}
+						traits::set_color(w, traits::get_color(x_parent));	// Case 4
+						traits::set_color(x_parent, BLACK);
+						if (traits::get_left(w))
+							traits::set_color(traits::get_left(w), BLACK);
+						rotate_right(x_parent, header);
+						break;
+					}
+				}
+			}
+			if (x) traits::set_color(x, BLACK);
+		}
+		return y;
+	}
+
+	//	threads a subtree built with null missing children (copy), pred / succ bound it
+	static void thread_subtree(node_ptr x, node_ptr pred, node_ptr succ)
+	{
+		while (x)
+		{
+			node_ptr	l = traits::get_left(x);
+			node_ptr	r = traits::get_right(x);
+
+			if (l) thread_subtree(l, pred, x);
+			else traits::set_left_thread(x, pred);
+			if (r == 0)
+			{
+				traits::set_right_thread(x, succ);
+				return ;
+			}
+			pred = x;
+			x = r;
+		}
+	}
+};
+
+typedef rb_algorithms<tree_node_traits>	tree_algorithms;
+
+inline tree_node::node_ptr tree_node::minimum(node_ptr ptr) { return tree_algorithms::minimum(ptr); }
+inline tree_node::node_ptr tree_node::maximum(node_ptr ptr) { return tree_algorithms::maximum(ptr); }
+inline tree_node::const_node_ptr tree_node::minimum(const_node_ptr ptr)
+{ return tree_algorithms::minimum(const_cast<node_ptr>(ptr)); }
+inline tree_node::const_node_ptr tree_node::maximum(const_node_ptr ptr)
+{ return tree_algorithms::maximum(const_cast<node_ptr>(ptr)); }
+
+inline tree_node*
+tree_increment(tree_node* ptr)
+{
+	return tree_algorithms::increment(ptr);
+}
+
+inline const tree_node*
+tree_increment(const tree_node* ptr)
+{
+	return tree_algorithms::increment(const_cast<tree_node*>(ptr));
+}
+
+inline tree_node*
+tree_decrement(tree_node* ptr)
+{
+	return tree_algorithms::decrement(ptr);
 }
 
-const tree_node*
+inline const tree_node*
 tree_decrement(const tree_node* ptr)
 {
-	return tree_decrement(const_cast<tree_node*>(ptr));
+	return tree_algorithms::decrement(const_cast<tree_node*>(ptr));
 }
 
 template<typename T>
@@ -223,291 +666,192 @@ template<typename T>
 bool operator!=(const rb_iterator<T>& lhs, const const_rb_iterator<T>& rhs)
 { return lhs.node != rhs.node; }
 
-void tree_rotate_left(tree_node* const x, tree_node*& root)
-{
-	tree_node* const y = x->right;
 
-	x->right = y->left;
-	if (y->left) y->left->parent = x;
-	y->parent = x->parent;
+inline void tree_rotate_left(tree_node* const x, tree_node& header)
+{
+	tree_algorithms::rotate_left(x, &header);
+}
 
-	if (x == root) root = y;
-	else if (x == x->parent->left) x->parent->left = y;
-	else x->parent->right = y;
-	y->left = x;
-	x->parent = y;
+inline void tree_rotate_right(tree_node* const x, tree_node& header)
+{
+	tree_algorithms::rotate_right(x, &header);
 }
 
-void tree_rotate_right(tree_node* const x, tree_node*& root)
+inline void insert_rebalance(const bool insert_left, tree_node* target, tree_node* parent, tree_node& header)
 {
-	tree_node* const	y = x->left;
+	tree_algorithms::insert_rebalance(insert_left, target, parent, &header);
+}
 
-	x->left = y->right;
-	if (y->right) y->right->parent = x;
-	y->parent = x->parent;
+inline tree_node* rebalance_erase(tree_node* const z, tree_node& header)
+{
+	return tree_algorithms::rebalance_erase(z, &header);
+}
 
-	if (x == root) root = y;
-	else if (x == x->parent->right) x->parent->right = y;
-	else x->parent->left = y;
-	y->right = x;
-	x->parent = y;
+//	cache hint for a node about to be visited, nothing where there is no builtin
+inline void prefetch_node(const void* p)
+{
+#ifdef __GNUC__
+	__builtin_prefetch(p);
+#else
+	(void)p;
+#endif
 }
 
-void insert_rebalance(const bool insert_left, tree_node* target, tree_node* parent, tree_node& header)
+/*
+ *	Node Policy : what a node of RbTree carries besides its links and value,
+ *	the node type, the traits the tree algorithms use on it and the key cache.
+ *
+ *	Key Cache : optionally, the leading bytes of each key copied into its node.
+ *	Descents compare the cached words first and call the comparator only on ties,
+ *	so most steps never touch the key's own storage.
+ *	compare(node, probe) is the sign of node's word against the searched one, 0 on ties.
+ */
+struct plain_node_policy
 {
-	tree_node*& root = header.parent;
+	template<typename V> struct node { typedef rb_node<V> type; };
+	template<typename Node> struct traits { typedef tree_node_traits type; };
+	typedef void	aggregate_type;
+	typedef int		probe;
+
+	//	the node's own extra members, around the value's lifetime
+	template<typename N> static void construct(N*) {}
+	template<typename N> static void destroy(N*) {}
+
+	template<typename K> static probe make(const K&) { return 0; }
+	template<typename N, typename K> static void store(N*, const K&) {}
+	template<typename N> static int compare(const N*, probe) { return 0; }
+};
 
-	target->parent = parent;
-	target->left = 0;
-	target->right = 0;
-	target->color = RED;
+template<typename V>
+struct prefixed_node : public rb_node<V>
+{
+	uint64_t	key_prefix;
+};
 
-	/**
-	 * @brief : Insert, First node should be Left node
-	 */
-	if (insert_left)
-	{
-		parent->left = target;
-		if (parent == &header)
-		{
-			header.parent = target;
-			header.right = target;
-		} else if (parent == header.left)
-			header.left = target;
-	} else {
-		parent->right = target;
-		if (parent == header.right)
-			header.right = target;
+//	first 8 bytes, big endian, zero padded : a smaller string never gets a greater word
+struct string_prefix_cache : public plain_node_policy
+{
+	template<typename V> struct node { typedef prefixed_node<V> type; };
+	typedef uint64_t	probe;
+
+	static probe make(const std::string& k) {
+		const std::size_t	n = k.size() < 8 ? k.size() : 8;
+		uint64_t			w = 0;
+		for (std::size_t i = 0; i < n; ++i) w |= uint64_t(static_cast<unsigned char>(k[i])) << (56 - 8 * i);
+		return w;
 	}
+	template<typename N> static void store(N* n, const std::string& k) { n->key_prefix = make(k); }
+	template<typename N> static int compare(const N* n, probe p) { return n->key_prefix < p ? -1 : n->key_prefix > p; }
+};
 
-	/**
-	 * @brief : Rebalance
-	 */
-	 while (target != root && target->parent->color == RED) {
-		 tree_node* const parpar = target->parent->parent;
-
-		 if (target->parent == parpar->left) {
-			 tree_node* const	tmp = parpar->right;
-
-			 if (tmp && tmp->color == RED) {//	#Case 1
-				target->parent->color = BLACK;
-				tmp->color = BLACK;
-				parpar->color = RED;
-				target = parpar;
-			 } else {						//	#Case 2
-				 if (target == target->parent->right) {
-					 target = target->parent;
-					 tree_rotate_left(target, root);
-				 }
-				 target->parent->color = BLACK;
-				 parpar->color = RED;
-				 tree_rotate_right(parpar, root);
-			 }
-		 }
-		 else {
-			 tree_node* const	tmp = parpar->left;
-
-			 if (tmp && tmp->color == RED) {	//	#Case 1
-				 target->parent->color = BLACK;
-				 tmp->color = BLACK;
-				 parpar->color = RED;
-				 target = parpar;
-			 } else {						//	#Case 2
-				 if (target == target->parent->left) {
-					 target = target->parent;
-					 tree_rotate_right(target, root);
-				 }
-				 target->parent->color = BLACK;
-				 parpar->color = RED;
-				 tree_rotate_left(parpar, root);
-			 }
-		 }
-	 }
-	 root->color = BLACK;
-}
+//	the cache is only sound for comparators ordering keys by their bytes
+template<typename K, typename Comp>
+struct key_cache_for { typedef plain_node_policy type; };
+
+template<>
+struct key_cache_for<std::string, std::less<std::string> > { typedef string_prefix_cache type; };
+
+template<>
+struct key_cache_for<std::string, ft::less<std::string> > { typedef string_prefix_cache type; };
 
-tree_node* rebalance_erase(tree_node* const z, tree_node& header)
+/*
+ *	Monoid : an associative operator and its identity, default constructed where used.
+ *		value_type, identity(), operator()(a, b)
+ */
+template<typename T>
+struct plus_monoid
 {
-	tree_node*& root = header.parent;
-	tree_node*& leftmost = header.left;
-	tree_node*& rightmost = header.right;
-	tree_node* y = z;
-	tree_node* x = 0;
-	tree_node* x_parent = 0;
-
-	if (y->left == 0)     // z has at most one non-null child. y == z.
-		x = y->right;       // x might be null.
-	else
-	{
-		if (y->right == 0)  // z has exactly one non-null child. y == z.
-			x = y->left;      // __x is not null.
-		else
-		{
-			// z has two non-null children.
-			y = y->right;   // Set y to z's successor.  x might be null.
-			while (y->left != 0)
-				y = y->left;
-			x = y->right;
-		}
-	}
+	typedef T	value_type;
+	T identity() const { return T(); }
+	T operator()(const T& a, const T& b) const { return a + b; }
+};
 
-	if (y != z)
-	{
-		// relink y in place of z.  y is z's successor
-		z->left->parent = y;
-		y->left = z->left;
-		if (y != z->right)
-		{
-			x_parent = y->parent;
-			if (x) x->parent = y->parent;
-			y->parent->left = x;   // y must be a child of M_left
-			y->right = z->right;
-			z->right->parent = y;
-		}
-		else
-			x_parent = y;
+template<typename T>
+struct min_monoid
+{
+	typedef T	value_type;
+	T identity() const { return std::numeric_limits<T>::max(); }
+	T operator()(const T& a, const T& b) const { return b < a ? b : a; }
+};
 
-		if (root == z)
-			root = y;
-		else if (z->parent->left == z)
-			z->parent->left = y;
-		else
-			z->parent->right = y;
-		y->parent = z->parent;
-		std::swap(y->color, z->color);
-		y = z;
-		// y now points to node to be actually deleted
-	}
-	else
-	{
-		// y == z
-		x_parent = y->parent;
-		if (x)
-			x->parent = y->parent;
+template<typename T>
+struct max_monoid
+{
+	typedef T	value_type;
+	T identity() const { return std::numeric_limits<T>::lowest(); }
+	T operator()(const T& a, const T& b) const { return a < b ? b : a; }
+};
 
-		if (root == z)
-			root = x;
-		else
-		{
-			if (z->parent->left == z)
-				z->parent->left = x;
-			else
-				z->parent->right = x;
-		}
+//	what an element contributes : a set's key, a map's mapped value
+template<typename K, typename V>
+struct element_measure
+{
+	const V& operator()(const V& v) const { return v; }
+};
 
-		if (leftmost == z)
-		{
-			if (z->right == 0)        // __z->_M_left must be null also
-				leftmost = z->parent;
-			else                        // makes __leftmost == _M_header if __z == __root
-				leftmost = tree_node::minimum(x);
-		}
+template<typename K, typename T>
+struct element_measure<K, pair<const K, T> >
+{
+	const T& operator()(const pair<const K, T>& v) const { return v.second; }
+};
 
-		if (rightmost == z)
-		{
-			if (z->left == 0)         // __z->_M_right must be null also
-				rightmost = z->parent;
-			else                        	// makes __rightmost == _M_header if __z == __root
-				rightmost = tree_node::maximum(x);  // __x == __z->_M_left
-		}
-	}
+template<typename V, typename A>
+struct augmented_node : public rb_node<V>
+{
+	A	aggregate;		//	over the subtree, in key order
+};
 
-	if (y->color != RED)
-	{
-		while (x != root && (x == 0 || x->color == BLACK))
-		{
-			if (x == x_parent->left)
-			{
-				tree_node* w = x_parent->right;
-				if (w->color == RED)  // Case 1
-				{
-					w->color = BLACK;
-					x_parent->color = RED;
-					tree_rotate_left(x_parent, root);
-					w = x_parent->right;
-				}
+template<typename Node, typename Monoid, typename Measure>
+struct augmented_node_traits : public tree_node_traits
+{
+	static const bool	augmented = true;
 
-				if ((w->left == 0 ||
-					 w->left->color == BLACK) &&
-					(w->right == 0 ||
-					 w->right->color == BLACK))  // Case 2
-				{
-					w->color = RED;
-					x = x_parent;
-					x_parent = x_parent->parent;
-				}
-				else
-				{
-					if (w->right == 0
-						|| w->right->color == BLACK) // Case 3
-					{
-						w->left->color = BLACK;
-						w->color = RED;
-						tree_rotate_right(w, root);
-						w = x_parent->right;
-					}
-					w->color = x_parent->color; // Case 4
-					x_parent->color = BLACK;
-					if (w->right)
-						w->right->color = BLACK;
-					tree_rotate_left(x_parent, root);
-					break;
-				}
-			}
-			else
-			{
-				// same as above, with _M_right <-> _M_left.
-				tree_node* w = x_parent->left;
-				if (w->color == RED)  // Case 1
-				{
-					w->color = BLACK;
-					x_parent->color = RED;
-					tree_rotate_right(x_parent, root);
-					w = x_parent->left;
-				}
+	static void update(node_ptr x)
+	{
+		const Monoid					op = Monoid();
+		Node* const						n = static_cast<Node*>(x);
+		typename Monoid::value_type		a = Measure()(n->value);
 
-				if ((w->right == 0 ||
-					 w->right->color == BLACK) &&
-					(w->left == 0 ||
-					 w->left->color == BLACK))  // Case 2
-				{
-					w->color = RED;
-					x = x_parent;
-					x_parent = x_parent->parent;
-				}
-				else
-				{
-					if (w->left == 0
-						|| w->left->color == BLACK)  // Case 3
-					{
-						w->right->color = BLACK;
-						w->color = RED;
-						tree_rotate_left(w, root);
-						w = x_parent->left;
-					}
-					w->color = x_parent->color; // Case 4
-					x_parent->color = BLACK;
-					if (w->left)
-						w->left->color = BLACK;
-					tree_rotate_right(x_parent, root);
-					break;
-				}
-			}
-		}
-		if (x) x->color = BLACK;
+		if (node_ptr l = get_left(x)) a = op(static_cast<Node*>(l)->aggregate, a);
+		if (node_ptr r = get_right(x)) a = op(a, static_cast<Node*>(r)->aggregate);
+		n->aggregate = a;
 	}
-	return y;
-}
+};
+
+/*
+ *	Augmented : every node caches Monoid over its subtree, kept by the rotations,
+ *	insert and erase at O(log n) extra, so any key range folds in O(log n).
+ */
+template<typename Monoid, typename Measure>
+struct augment_policy : public plain_node_policy
+{
+	typedef Monoid							monoid;
+	typedef Measure							measure;
+	typedef typename Monoid::value_type		aggregate_type;
+
+	template<typename V> struct node { typedef augmented_node<V, aggregate_type> type; };
+	template<typename Node> struct traits { typedef augmented_node_traits<Node, Monoid, Measure> type; };
+
+	template<typename N> static void construct(N* n) { ::new(static_cast<void*>(&n->aggregate)) aggregate_type(); }
+	template<typename N> static void destroy(N* n) { n->aggregate.~aggregate_type(); }
+};
 
-template<typename K, typename V, typename KV, typename Comp, typename Alloc = std::allocator<V> >
+template<typename K, typename V, typename KV, typename Comp, typename Alloc = std::allocator<V>,
+		typename NodePolicy = plain_node_policy>
 class RbTree
 {
-	typedef typename Alloc::template rebind<rb_node<V> >::other		node_allocator;
+protected:
+	typedef typename NodePolicy::template node<V>::type		node_type;
+
+private:
+	typedef typename Alloc::template rebind<node_type>::other	node_allocator;
 
 protected:
 	typedef tree_node*			node_ptr;
 	typedef const tree_node*	const_node_ptr;
-	typedef rb_node<V>			rb_node;
+	typedef typename NodePolicy::template traits<node_type>::type	node_traits;
+	typedef rb_algorithms<node_traits>								algorithms;
+	typedef typename NodePolicy::probe								probe_type;
 
 public:
 	typedef	K					key_type;
@@ -516,11 +860,12 @@ public:
 	typedef const value_type*	const_pointer;
 	typedef value_type&			reference;
 	typedef const value_type&	const_reference;
-	typedef rb_node*			link_type;
-	typedef const rb_node*		const_link_type;
+	typedef node_type*			link_type;
+	typedef const node_type*	const_link_type;
 	typedef std::size_t			size_type;
 	typedef std::ptrdiff_t		difference_type;
 	typedef Alloc				allocator_type;
+	typedef typename NodePolicy::aggregate_type	aggregate_type;
 
 	node_allocator& get_node_alloc() { return *static_cast<node_allocator*>(&this->impl); }
 	const node_allocator& get_node_alloc() const { return *static_cast<const node_allocator*>(&this->impl); }
@@ -528,10 +873,12 @@ public:
 	allocator_type get_alloc() const { return allocator_type(get_node_alloc()); }
 
 protected:
-	rb_node* get_node() { return impl.node_allocator::allocate(1); }
-	void put_node(rb_node* ptr) { impl.node_allocator::deallocate(ptr, 1); }
+	link_type get_node() { return impl.node_allocator::allocate(1); }
+	void put_node(link_type ptr) { impl.node_allocator::deallocate(ptr, 1); }
 	link_type create_node(const value_type& v) {
 		link_type ret = get_node();
+		//	zeroed links : compact set_color / set_parent keep the other half of the word
+		::new(static_cast<void*>(static_cast<tree_node*>(ret))) tree_node();
 		try {
 			get_alloc().construct(&ret->value, v);
 		}
@@ -539,17 +886,28 @@ protected:
 			put_node(ret);
 			throw ;
 		}
+		try {
+			NodePolicy::construct(ret);
+		}
+		catch (...) {
+			get_alloc().destroy(&ret->value);
+			put_node(ret);
+			throw ;
+		}
+		NodePolicy::store(ret, KV()(v));
 		return ret;
 	}
 
 	link_type copy_node(const_link_type target) {
 		link_type dest = create_node(target->value);
-		dest->color = target->color;
-		dest->left = dest->right = 0;
+		node_traits::set_color(dest, node_traits::get_color(target));
+		node_traits::set_left_thread(dest, 0);
+		node_traits::set_right_thread(dest, 0);
 		return dest;
 	}
 
 	void destroy_node(link_type target) {
+		NodePolicy::destroy(target);
 		get_alloc().destroy(&target->value);
 		put_node(target);
 	}
@@ -564,8 +922,8 @@ protected:
 		RbTreeImpl(const node_allocator& alloc = node_allocator(), const KeyComp& comp = KeyComp())
 		: node_allocator(alloc), keyCompare(comp), header(), size(0)
 		{
-			this->header.color = RED;
-			this->header.parent = 0;
+			node_traits::set_color(&this->header, RED);
+			node_traits::set_parent(&this->header, 0);
 			this->header.left = this->header.right = &this->header;
 		}
 	};
@@ -580,23 +938,24 @@ protected:
 		RbTreeImpl(const node_allocator& alloc = node_allocator(), const KeyComp& comp = KeyComp())
 		: node_allocator(alloc), keyCompare(comp), header(), size(0)
 		{
-			this->header.color = RED;
-			this->header.parent = 0;
+			node_traits::set_color(&this->header, RED);
+			node_traits::set_parent(&this->header, 0);
 			this->header.left = this->header.right = &this->header;
 		}
 	};
 	RbTreeImpl<Comp>	impl;
 
 protected:
-	node_ptr& root() { return this->impl.header.parent; }
-	const_node_ptr root() const { return this->impl.header.parent; }
+	node_ptr root() { return node_traits::get_parent(&this->impl.header); }
+	const_node_ptr root() const { return node_traits::get_parent(&this->impl.header); }
+	void set_root(node_ptr x) { node_traits::set_parent(&this->impl.header, x); }
 	node_ptr& get_leftest() { return this->impl.header.left; }
 	const_node_ptr get_leftest() const { return this->impl.header.left; }
 	node_ptr& get_rightest() { return this->impl.header.right; }
 	const_node_ptr get_rightest() const { return this->impl.header.right; }
 
-	link_type ibegin() { return static_cast<link_type>(this->impl.header.parent); }
-	const_link_type ibegin() const { return static_cast<const_link_type>(this->impl.header.parent); }
+	link_type ibegin() { return static_cast<link_type>(root()); }
+	const_link_type ibegin() const { return static_cast<const_link_type>(root()); }
 	link_type iend() { return static_cast<link_type>(&this->impl.header); }
 	const_link_type iend() const { return static_cast<const_link_type>(&this->impl.header); }
 
@@ -606,10 +965,22 @@ protected:
 	static const K& getKey(const_link_type target) { return KV()(getValue(target)); }
 	static const K& getKey(const_node_ptr target) { return KV()(getValue(target)); }
 
-	static link_type getLeft(node_ptr target) { return static_cast<link_type>(target->left); }
-	static const_link_type getLeft(const_node_ptr target) { return static_cast<const_link_type>(target->left); }
-	static link_type getRight(node_ptr target) { return static_cast<link_type>(target->right); }
-	static const_link_type getRight(const_node_ptr target) { return static_cast<const_link_type>(target->right); }
+	static link_type getLeft(node_ptr target) { return static_cast<link_type>(node_traits::get_left(target)); }
+	static const_link_type getLeft(const_node_ptr target) { return static_cast<const_link_type>(node_traits::get_left(target)); }
+	static link_type getRight(node_ptr target) { return static_cast<link_type>(node_traits::get_right(target)); }
+	static const_link_type getRight(const_node_ptr target) { return static_cast<const_link_type>(node_traits::get_right(target)); }
+
+	//	k < key(x) and key(x) < k, the cached words deciding when they differ
+	bool key_less_node(const K& k, probe_type p, const_node_ptr x) const
+	{
+		const int	c = NodePolicy::compare(static_cast<const_link_type>(x), p);
+		return c ? c > 0 : impl.keyCompare(k, getKey(x));
+	}
+	bool node_less_key(const_node_ptr x, const K& k, probe_type p) const
+	{
+		const int	c = NodePolicy::compare(static_cast<const_link_type>(x), p);
+		return c ? c < 0 : impl.keyCompare(getKey(x), k);
+	}
 
 	static node_ptr minimum(node_ptr target) { return tree_node::minimum(target); }
 	static const_node_ptr minimum(const_node_ptr target) { return tree_node::minimum(target); }
@@ -630,7 +1001,7 @@ private:
 
 		link_type	z = create_node(v);
 
-		insert_rebalance(insert_left, z, p, impl.header);
+		algorithms::insert_rebalance(insert_left, z, p, &impl.header);
 		++impl.size;
 		return iterator(z);
 	}
@@ -640,7 +1011,7 @@ private:
 
 		link_type	z = create_node(v);
 
-		insert_rebalance(insert_left, z, const_cast<node_ptr>(p), impl.header);
+		algorithms::insert_rebalance(insert_left, z, const_cast<node_ptr>(p), &impl.header);
 		++impl.size;
 		return const_iterator(z);
 	}
@@ -650,26 +1021,26 @@ private:
 
 		link_type	z = create_node(v);
 
-		insert_rebalance(insert_left, z, p, impl.header);
+		algorithms::insert_rebalance(insert_left, z, p, &impl.header);
 		++impl.size;
 		return iterator(z);
 	}
 	link_type mcopy(const_link_type x, link_type p)
 	{
 		link_type	top = copy_node(x);
-		top->parent = p;
+		node_traits::set_parent(top, p);
 
 		try {
-			if (x->right) top->right = mcopy(getRight(x), top);
+			if (getRight(x)) node_traits::set_right(top, mcopy(getRight(x), top));
 			p = top;
 			x = getLeft(x);
 
 			while (x)
 			{
 				link_type	y = copy_node(x);
-				p->left = y;
-				y->parent = p;
-				if (x->right) y->right = mcopy(getRight(x), y);
+				node_traits::set_left(p, y);
+				node_traits::set_parent(y, p);
+				if (getRight(x)) node_traits::set_right(y, mcopy(getRight(x), y));
 				p = y;
 				x = getLeft(x);
 			}
@@ -681,6 +1052,73 @@ private:
 		 return top;
 	}
 
+	/*
+	 *	Balanced build, in order, so first may be a one pass input iterator.
+	 *	Levels above red_depth are complete and black, nodes on red_depth are red.
+	 */
+	template<typename Iter>
+	link_type mbuild(Iter& first, size_type n, size_type depth, size_type red_depth)
+	{
+		const size_type	half = n / 2;
+		link_type		l = half ? mbuild(first, half, depth + 1, red_depth) : 0;
+		link_type		z;
+
+		try {
+			z = create_node(*first);
+		}
+		catch (...) {
+			merase(l);
+			throw ;
+		}
+		++first;
+		node_traits::set_color(z, depth == red_depth ? RED : BLACK);
+		node_traits::set_right_thread(z, 0);
+		if (l)
+		{
+			node_traits::set_left(z, l);
+			node_traits::set_parent(l, z);
+		}
+		else node_traits::set_left_thread(z, 0);
+
+		if (n - half - 1)
+		{
+			try {
+				link_type	r = mbuild(first, n - half - 1, depth + 1, red_depth);
+				node_traits::set_right(z, r);
+				node_traits::set_parent(r, z);
+			}
+			catch (...) {
+				merase(z);
+				throw ;
+			}
+		}
+		return z;
+	}
+
+	//	copies a non empty tree into this empty one
+	void mclone(const RbTree& target)
+	{
+		set_root(mcopy(target.ibegin(), iend()));
+		get_leftest() = minimum(root());
+		get_rightest() = maximum(root());
+		if (node_traits::threaded) algorithms::thread_subtree(root(), iend(), iend());
+		if (node_traits::augmented) algorithms::update_subtree(root());
+		impl.size = target.impl.size;
+	}
+
+	//	points root and extreme threads back at this header, after the nodes changed hands
+	void link_header()
+	{
+		if (root() == 0)
+		{
+			get_leftest() = get_rightest() = iend();
+			return ;
+		}
+		node_traits::set_parent(root(), iend());
+		node_traits::set_left_thread(get_leftest(), iend());
+		node_traits::set_right_thread(get_rightest(), iend());
+	}
+
 	void merase(link_type x)
 	{
 		while (x) {
@@ -695,28 +1133,18 @@ public:
 	RbTree(){};
 	RbTree(const Comp& comp) : impl(allocator_type(), comp) {};
 	RbTree(const Comp& comp, const allocator_type& alloc) : impl(alloc, comp) {};
-	RbTree(const RbTree<K, V, KV, Comp, Alloc>& target) : impl(target.get_node_alloc(), target.impl.keyCompare) {
-		if (target.root() != 0) {
-			root() = mcopy(target.ibegin(), iend());
-			get_leftest() = minimum(root());
-			get_rightest() = minimum(root());
-			impl.size = target.impl.size;
-		}
+	RbTree(const RbTree& target) : impl(target.get_node_alloc(), target.impl.keyCompare) {
+		if (target.root() != 0) mclone(target);
 	}
 
 	~RbTree() { merase(ibegin()); }
 
-	RbTree<K, V, KV, Comp, Alloc>& operator=(const RbTree<K, V, KV, Comp, Alloc>& target)
+	RbTree& operator=(const RbTree& target)
 	{
 		if (this == &target) return *this;
 		clear();
 		impl.keyCompare = target.impl.keyCompare;
-		if (target.root() != 0) {
-			root() = mcopy(target.ibegin(), iend());
-			get_leftest() = minimum(root());
-			get_rightest() = maximum(root());
-			impl.size = target.impl.size;
-		}
+		if (target.root() != 0) mclone(target);
 		return *this;
 	}
 
@@ -728,47 +1156,22 @@ public:
 	iterator end() { return iterator(static_cast<link_type>(&impl.header)); }
 	const_iterator end() const { return const_iterator(static_cast<const_link_type>(&impl.header)); }
 	reverse_iterator rbegin() { return reverse_iterator(end()); }
-	const_reverse_iterator rbegin() const { return const_reverse_iterator(begin()); }
+	const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
 	reverse_iterator rend() { return reverse_iterator(begin()); }
 	const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
 
 	bool empty() const { return !impl.size; }
 	size_type size() const { return impl.size; }
 	size_type max_size() const { return get_alloc().max_size(); }
-	void swap(RbTree<K, V, KV, Comp, Alloc>& other)
+	void swap(RbTree& other)
 	{
-		if (root() == 0)
-		{
-			if (other.root() != 0)
-			{
-				root() = other.root();
-
-				get_leftest() = other.get_leftest();
-				get_rightest() = other.get_rightest();
-				root()->parent = iend();
-				other.root() = 0;
-				other.get_leftest() = other.get_rightest() = other.iend();
-			}
-		}
-		else if (other.root() == 0)
-		{
-			other.root() = root();
-			other.get_leftest() = get_leftest();
-			other.get_rightest() = get_rightest();
-			other.root()->parent = other.iend();
-
-			root() = 0;
-			get_leftest() = get_rightest() = iend();
-		}
-		else
-		{
-			std::swap(root(), other.root());
-			std::swap(get_leftest(), other.get_leftest());
-			std::swap(get_rightest(), other.get_rightest());
-
-			root()->parent = iend();
-			other.root()->parent = other.iend();
-		}
+		node_ptr	tmp = root();
+		set_root(other.root());
+		other.set_root(tmp);
+		std::swap(get_leftest(), other.get_leftest());
+		std::swap(get_rightest(), other.get_rightest());
+		link_header();
+		other.link_header();
 
 		std::swap(impl.size, other.impl.size);
 		std::swap(impl.keyCompare, other.impl.keyCompare);
@@ -780,14 +1183,15 @@ public:
 
 	ft::pair<iterator, bool> insert_unique(const value_type& v)
 	{
-		link_type	x = ibegin();
-		link_type	y = iend();
-		bool		comp = true;
+		link_type			x = ibegin();
+		link_type			y = iend();
+		bool				comp = true;
+		const probe_type	p = NodePolicy::make(KV()(v));
 
 		while (x)
 		{
 			y = x;
-			comp = impl.keyCompare(KV()(v), getKey(x));
+			comp = key_less_node(KV()(v), p, x);
 			x = comp ? getLeft(x) : getRight(x);
 		}
 		iterator	it = iterator(y);
@@ -795,7 +1199,7 @@ public:
 			if (it == begin()) return pair<iterator, bool>(minsert(x, y, v), true);
 			else --it;
 		}
-		if (impl.keyCompare(getKey(it.node), KV()(v))) return pair<iterator, bool>(minsert(x, y, v), true);
+		if (node_less_key(it.node, KV()(v), p)) return pair<iterator, bool>(minsert(x, y, v), true);
 		return pair<iterator, bool>(it, false);
 	}
 
@@ -974,14 +1378,14 @@ public:
 
 	void erase(iterator pos)
 	{
-		link_type	y = static_cast<link_type>(rebalance_erase(pos.node, impl.header));
+		link_type	y = static_cast<link_type>(algorithms::rebalance_erase(pos.node, &impl.header));
 		destroy_node(y);
 		--impl.size;
 	}
 
 	void erase(const_iterator pos)
 	{
-		link_type	y = static_cast<link_type>(rebalance_erase(const_cast<node_ptr>(pos.node), impl.header));
+		link_type	y = static_cast<link_type>(algorithms::rebalance_erase(const_cast<node_ptr>(pos.node), &impl.header));
 		destroy_node(y);
 		--impl.size;
 	}
@@ -1020,11 +1424,34 @@ public:
 			erase(*first++);
 	}
 
+	/*
+	 *	Replace the contents with the n values read from first, in O(n).
+	 *	The keys must be strictly increasing.
+	 */
+	template<typename Iter>
+	void assign_sorted(Iter first, size_type n)
+	{
+		clear();
+		if (n == 0) return ;
+
+		size_type	full = 0;		//	levels 0 .. full - 1 are complete
+		while ((size_type(2) << full) - 1 <= n) ++full;
+
+		link_type	top = mbuild(first, n, 0, full);
+		node_traits::set_parent(top, iend());
+		set_root(top);
+		get_leftest() = minimum(root());
+		get_rightest() = maximum(root());
+		if (node_traits::threaded) algorithms::thread_subtree(root(), iend(), iend());
+		if (node_traits::augmented) algorithms::update_subtree(root());
+		impl.size = n;
+	}
+
 	void clear()
 	{
 		merase(ibegin());
 		get_leftest() = iend();
-		root() = 0;
+		set_root(0);
 		get_rightest() = iend();
 		impl.size = 0;
 	}
@@ -1033,10 +1460,11 @@ public:
 	{
 		link_type	x = ibegin();
 		link_type	y = iend();
+		const probe_type	p = NodePolicy::make(k);
 
 		while(x)
 		{
-			if (!impl.keyCompare(getKey(x), k))
+			if (!node_less_key(x, k, p))
 			{
 				y = x;
 				x = getLeft(x);
@@ -1044,17 +1472,18 @@ public:
 			else x = getRight(x);
 		}
 		iterator	it = iterator(y);
-		return it == end() || impl.keyCompare(k, getKey(it.node)) ? end() : it;
+		return it == end() || key_less_node(k, p, it.node) ? end() : it;
 	}
 
 	const_iterator find(const key_type& k) const
 	{
 		const_link_type	x = ibegin();
 		const_link_type	y = iend();
+		const probe_type	p = NodePolicy::make(k);
 
 		while(x)
 		{
-			if (!impl.keyCompare(getKey(x), k))
+			if (!node_less_key(x, k, p))
 			{
 				y = x;
 				x = getLeft(x);
@@ -1062,7 +1491,7 @@ public:
 			else x = getRight(x);
 		}
 		const_iterator	it = const_iterator(y);
-		return it == end() || impl.keyCompare(k, getKey(it.node)) ? end() : it;
+		return it == end() || key_less_node(k, p, it.node) ? end() : it;
 	}
 
 	size_type count(const key_type& k) const
@@ -1076,10 +1505,11 @@ public:
 	{
 		link_type	x = ibegin();
 		link_type	y = iend();
+		const probe_type	p = NodePolicy::make(k);
 
 		while(x)
 		{
-			if (!impl.keyCompare(getKey(x), k))
+			if (!node_less_key(x, k, p))
 			{
 				y = x;
 				x = getLeft(x);
@@ -1093,10 +1523,11 @@ public:
 	{
 		const_link_type	x = ibegin();
 		const_link_type	y = iend();
+		const probe_type	p = NodePolicy::make(k);
 
 		while(x)
 		{
-			if (!impl.keyCompare(getKey(x), k))
+			if (!node_less_key(x, k, p))
 			{
 				y = x;
 				x = getLeft(x);
@@ -1110,10 +1541,11 @@ public:
 	{
 		link_type	x = ibegin();
 		link_type	y = iend();
+		const probe_type	p = NodePolicy::make(k);
 
 		while (x)
 		{
-			if (impl.keyCompare(k, getKey(x)))
+			if (key_less_node(k, p, x))
 			{
 				y = x;
 				x = getLeft(x);
@@ -1127,10 +1559,11 @@ public:
 	{
 		const_link_type	x = ibegin();
 		const_link_type	y = iend();
+		const probe_type	p = NodePolicy::make(k);
 
 		while (x)
 		{
-			if (impl.keyCompare(k, getKey(x)))
+			if (key_less_node(k, p, x))
 			{
 				y = x;
 				x = getLeft(x);
@@ -1139,6 +1572,136 @@ public:
 		}
 		return const_iterator(y);
 	}
+
+	/*
+	 *	Batched lookups : one iterator per key of [first, last) written to out.
+	 *	batch_group searches go down the tree in lock step, each prefetching its
+	 *	next node before any of them reads one, so their cache misses overlap.
+	 *	Keys are read through references : KeyIter must be a forward iterator.
+	 */
+	static const size_type	batch_group = 32;
+
+	template<typename KeyIter, typename OutIter>
+	OutIter lower_bound_batch(KeyIter first, KeyIter last, OutIter out)
+	{ return mbatch(first, last, out, false, static_cast<iterator*>(0)); }
+
+	template<typename KeyIter, typename OutIter>
+	OutIter lower_bound_batch(KeyIter first, KeyIter last, OutIter out) const
+	{ return mbatch(first, last, out, false, static_cast<const_iterator*>(0)); }
+
+	template<typename KeyIter, typename OutIter>
+	OutIter find_batch(KeyIter first, KeyIter last, OutIter out)
+	{ return mbatch(first, last, out, true, static_cast<iterator*>(0)); }
+
+	template<typename KeyIter, typename OutIter>
+	OutIter find_batch(KeyIter first, KeyIter last, OutIter out) const
+	{ return mbatch(first, last, out, true, static_cast<const_iterator*>(0)); }
+
+private:
+	template<typename KeyIter, typename OutIter, typename Iterator>
+	OutIter mbatch(KeyIter first, KeyIter last, OutIter out, bool exact, Iterator*) const
+	{
+		const_node_ptr		x[batch_group];
+		const_node_ptr		y[batch_group];
+		const key_type*		k[batch_group];
+		probe_type			p[batch_group];
+
+		while (first != last)
+		{
+			size_type	n = 0;
+			for (; n < batch_group && first != last; ++n, ++first)
+			{
+				k[n] = &*first;
+				p[n] = NodePolicy::make(*k[n]);
+				x[n] = root();
+				y[n] = iend();
+			}
+			for (bool active = true; active; )
+			{
+				active = false;
+				for (size_type i = 0; i < n; ++i)
+				{
+					if (!x[i]) continue;
+					if (!node_less_key(x[i], *k[i], p[i]))
+					{
+						y[i] = x[i];
+						x[i] = node_traits::get_left(x[i]);
+					}
+					else x[i] = node_traits::get_right(x[i]);
+					if (x[i])
+					{
+						prefetch_node(x[i]);
+						active = true;
+					}
+				}
+			}
+			for (size_type i = 0; i < n; ++i, ++out)
+			{
+				if (exact && y[i] != iend() && key_less_node(*k[i], p[i], y[i])) y[i] = iend();
+				*out = Iterator(static_cast<link_type>(const_cast<node_ptr>(y[i])));
+			}
+		}
+		return out;
+	}
+
+public:
+	/*
+	 *	Augmented trees only : the monoid folded over the elements of keys in [lo, hi),
+	 *	in key order. One descent to the node splitting the range, then one down each side.
+	 */
+	aggregate_type aggregate(const key_type& lo, const key_type& hi) const
+	{
+		typedef typename NodePolicy::monoid		monoid;
+		typedef typename NodePolicy::measure	measure;
+
+		const monoid	op = monoid();
+		const_node_ptr	x = root();
+
+		while (x)
+		{
+			if (impl.keyCompare(getKey(x), lo)) x = node_traits::get_right(x);
+			else if (!impl.keyCompare(getKey(x), hi)) x = node_traits::get_left(x);
+			else break;
+		}
+		if (x == 0) return op.identity();
+
+		aggregate_type	left = op.identity();
+		for (const_node_ptr l = node_traits::get_left(x); l; )
+		{
+			if (impl.keyCompare(getKey(l), lo)) l = node_traits::get_right(l);
+			else
+			{
+				left = op(op(measure()(getValue(l)), subtree_aggregate(node_traits::get_right(l))), left);
+				l = node_traits::get_left(l);
+			}
+		}
+		aggregate_type	right = op.identity();
+		for (const_node_ptr r = node_traits::get_right(x); r; )
+		{
+			if (!impl.keyCompare(getKey(r), hi)) r = node_traits::get_left(r);
+			else
+			{
+				right = op(right, op(subtree_aggregate(node_traits::get_left(r)), measure()(getValue(r))));
+				r = node_traits::get_right(r);
+			}
+		}
+		return op(op(left, measure()(getValue(x))), right);
+	}
+
+	//	over every element
+	aggregate_type aggregate() const { return subtree_aggregate(root()); }
+
+	//	after changing the measured part of *pos in place, e.g. a map's mapped value
+	void refresh(iterator pos) { algorithms::update_path(pos.node, &impl.header); }
+	void refresh(const_iterator pos) { algorithms::update_path(const_cast<node_ptr>(pos.node), &impl.header); }
+
+private:
+	static aggregate_type subtree_aggregate(const_node_ptr x)
+	{
+		return x ? static_cast<const_link_type>(x)->aggregate : typename NodePolicy::monoid().identity();
+	}
+
+public:
 	pair<iterator, iterator>
 	equal_range(const key_type& k)
 	{ return pair<iterator, iterator>(lower_bound(k), upper_bound(k)); }
@@ -1148,41 +1711,68 @@ public:
 	{ return pair<const_iterator, const_iterator>(lower_bound(k), upper_bound(k)); }
 };
 
-template <typename K, typename V, typename KV, typename Comp, typename Alloc>
-bool operator==(const RbTree<K, V, KV, Comp, Alloc>& lhs,
-				const RbTree<K, V, KV, Comp, Alloc>& rhs)
+template <typename K, typename V, typename KV, typename Comp, typename Alloc, typename NodePolicy>
+bool operator==(const RbTree<K, V, KV, Comp, Alloc, NodePolicy>& lhs,
+				const RbTree<K, V, KV, Comp, Alloc, NodePolicy>& rhs)
 { return lhs.size() == rhs.size() && ft::equal(lhs.begin(), lhs.end(), rhs.begin()); }
 
-template <typename K, typename V, typename KV, typename Comp, typename Alloc>
-bool operator!=(const RbTree<K, V, KV, Comp, Alloc>& lhs,
-				const RbTree<K, V, KV, Comp, Alloc>& rhs)
+template <typename K, typename V, typename KV, typename Comp, typename Alloc, typename NodePolicy>
+bool operator!=(const RbTree<K, V, KV, Comp, Alloc, NodePolicy>& lhs,
+				const RbTree<K, V, KV, Comp, Alloc, NodePolicy>& rhs)
 { return !(lhs == rhs); }
 
-template <typename K, typename V, typename KV, typename Comp, typename Alloc>
-bool operator<(const RbTree<K, V, KV, Comp, Alloc>& lhs,
-				const RbTree<K, V, KV, Comp, Alloc>& rhs)
+template <typename K, typename V, typename KV, typename Comp, typename Alloc, typename NodePolicy>
+bool operator<(const RbTree<K, V, KV, Comp, Alloc, NodePolicy>& lhs,
+				const RbTree<K, V, KV, Comp, Alloc, NodePolicy>& rhs)
 { return ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()); }
 
-template <typename K, typename V, typename KV, typename Comp, typename Alloc>
-bool operator<=(const RbTree<K, V, KV, Comp, Alloc>& lhs,
-			   const RbTree<K, V, KV, Comp, Alloc>& rhs)
+template <typename K, typename V, typename KV, typename Comp, typename Alloc, typename NodePolicy>
+bool operator<=(const RbTree<K, V, KV, Comp, Alloc, NodePolicy>& lhs,
+			   const RbTree<K, V, KV, Comp, Alloc, NodePolicy>& rhs)
 { return !(rhs < lhs); }
 
-template <typename K, typename V, typename KV, typename Comp, typename Alloc>
-bool operator>(const RbTree<K, V, KV, Comp, Alloc>& lhs,
-				const RbTree<K, V, KV, Comp, Alloc>& rhs)
+template <typename K, typename V, typename KV, typename Comp, typename Alloc, typename NodePolicy>
+bool operator>(const RbTree<K, V, KV, Comp, Alloc, NodePolicy>& lhs,
+				const RbTree<K, V, KV, Comp, Alloc, NodePolicy>& rhs)
 { return rhs < lhs; }
 
-template <typename K, typename V, typename KV, typename Comp, typename Alloc>
-bool operator>=(const RbTree<K, V, KV, Comp, Alloc>& lhs,
-				const RbTree<K, V, KV, Comp, Alloc>& rhs)
+template <typename K, typename V, typename KV, typename Comp, typename Alloc, typename NodePolicy>
+bool operator>=(const RbTree<K, V, KV, Comp, Alloc, NodePolicy>& lhs,
+				const RbTree<K, V, KV, Comp, Alloc, NodePolicy>& rhs)
 { return !(lhs < rhs); }
 
-template <typename K, typename V, typename KV, typename Comp, typename Alloc>
-void swap(const RbTree<K, V, KV, Comp, Alloc>& lhs,
-		  const RbTree<K, V, KV, Comp, Alloc>& rhs)
+template <typename K, typename V, typename KV, typename Comp, typename Alloc, typename NodePolicy>
+void swap(const RbTree<K, V, KV, Comp, Alloc, NodePolicy>& lhs,
+		  const RbTree<K, V, KV, Comp, Alloc, NodePolicy>& rhs)
 { lhs.swap(rhs); }
 
+/*
+ *	Tree policy for map / set : which tree holds the elements.
+ *	pointer_tree is RbTree, prefix_tree RbTree with cached key prefixes,
+ *	augmented_tree RbTree with subtree aggregates, index_tree (index_tree.hpp)
+ *	the 32 bit index pool.
+ */
+struct pointer_tree
+{
+	template<typename K, typename V, typename KV, typename Comp, typename Alloc>
+	struct rebind { typedef RbTree<K, V, KV, Comp, Alloc> other; };
+};
+
+//	RbTree with the key cache of key_cache_for<K, Comp> : string keys under std::less
+struct prefix_tree
+{
+	template<typename K, typename V, typename KV, typename Comp, typename Alloc>
+	struct rebind { typedef RbTree<K, V, KV, Comp, Alloc, typename key_cache_for<K, Comp>::type> other; };
+};
+
+//	Monoid over a map's mapped values or a set's keys, see RbTree::aggregate
+template<typename Monoid>
+struct augmented_tree
+{
+	template<typename K, typename V, typename KV, typename Comp, typename Alloc>
+	struct rebind { typedef RbTree<K, V, KV, Comp, Alloc, augment_policy<Monoid, element_measure<K, V> > > other; };
+};
+
 }   //  FT
 
 #endif
\ No newline at end of file
@@ -6,7 +6,7 @@
 namespace ft
 {
 
-template<typename K, typename Comp = ft::less<K>, typename Alloc = std::allocator<K> >
+template<typename K, typename Comp = ft::less<K>, typename Alloc = std::allocator<K>, typename Tree = pointer_tree>
 class set
 {
 	typedef typename Alloc::value_type            alloc_value_type;
@@ -20,7 +20,8 @@ public:
 
 private:
 	typedef typename Alloc::template rebind<K>::other											key_alloc_type;
-	typedef RbTree<key_type, value_type, Identity<value_type>, key_compare, key_alloc_type>		rep_type;
+	typedef typename Tree::template rebind<key_type, value_type, Identity<value_type>,
+											key_compare, key_alloc_type>::other			rep_type;
 	rep_type	rep;
 
 public:
@@ -38,15 +39,16 @@ public:
 
 	set() : rep(Comp(), Alloc()) {}
 	explicit set(const Comp& comp, const allocator_type& alloc = allocator_type()) : rep(comp, alloc) {}
+	explicit set(const allocator_type& alloc) : rep(Comp(), alloc) {}
 	template <typename Iter>
 	set(Iter first, Iter last) : rep(Comp(), allocator_type())
 	{ rep.insert_unique(first, last); }
 	template <class Iter>
 	set(Iter first, Iter last, const Comp& comp, const allocator_type& alloc = allocator_type()) : rep(comp, alloc)
 	{ rep.insert_unique(first, last); }
-	set(const set<K, Comp, Alloc>& rhs) : rep(rhs.rep) {}
+	set(const set<K, Comp, Alloc, Tree>& rhs) : rep(rhs.rep) {}
 
-	set<K, Comp, Alloc>& operator=(const set<K, Comp, Alloc>& rhs)
+	set<K, Comp, Alloc, Tree>& operator=(const set<K, Comp, Alloc, Tree>& rhs)
 	{
 		rep = rhs.rep;
 		return *this;
@@ -63,7 +65,7 @@ public:
 	bool empty() const { return rep.empty(); };
 	size_type size() const { return rep.size(); }
 	size_type max_size() const { return rep.max_size(); }
-	void swap(set<K, Comp, Alloc>& rhs) { rep.swap(rhs.rep); }
+	void swap(set<K, Comp, Alloc, Tree>& rhs) { rep.swap(rhs.rep); }
 
 	ft::pair<iterator, bool> insert(const value_type& v)
 	{
@@ -78,6 +80,9 @@ public:
 	size_type erase(const key_type& k) { return rep.erase(k); }
 	void erase(iterator first, iterator last) { rep.erase(first, last); }
 	void clear() { rep.clear(); }
+	//	n strictly increasing values from first, O(n) instead of n inserts
+	template<typename Iter>
+	void assign_sorted(Iter first, size_type n) { rep.assign_sorted(first, n); }
 	size_type count(const key_type& k) const { return rep.find(k) == rep.end() ? 0 : 1; }
 
 	iterator find(const key_type& k) { return rep.find(k); }
@@ -88,28 +93,40 @@ public:
 	iterator upper_bound(const key_type& k) { return rep.upper_bound(k); }
 	const_iterator upper_bound(const key_type& k) const { return rep.upper_bound(k); }
 
+	//	one iterator per key of the forward range [first, last), the searches interleaved
+	template<typename KeyIter, typename OutIter>
+	OutIter find_batch(KeyIter first, KeyIter last, OutIter out) const { return rep.find_batch(first, last, out); }
+	template<typename KeyIter, typename OutIter>
+	OutIter lower_bound_batch(KeyIter first, KeyIter last, OutIter out) const
+	{ return rep.lower_bound_batch(first, last, out); }
+
+	//	augmented_tree only : the monoid over the keys in [lo, hi), in O(log n)
+	typename rep_type::aggregate_type aggregate(const key_type& lo, const key_type& hi) const
+	{ return rep.aggregate(lo, hi); }
+	typename rep_type::aggregate_type aggregate() const { return rep.aggregate(); }
+
 	ft::pair<iterator, iterator> equal_range(const key_type& k) { return rep.equal_range(k); }
 	ft::pair<const_iterator, const_iterator> equal_range(const key_type& k) const { return rep.equal_range(k); }
 
-	template <typename OtherK, typename OtherComp, typename OtherAlloc>
-	friend bool operator==(const set<OtherK, OtherComp, OtherAlloc>&, const set<OtherK, OtherComp, OtherAlloc>&);
-	template <typename OtherK, typename OtherComp, typename OtherAlloc>
-	friend bool operator<(const set<OtherK, OtherComp, OtherAlloc>&, const set<OtherK, OtherComp, OtherAlloc>&);
+	template <typename OtherK, typename OtherComp, typename OtherAlloc, typename OtherTree>
+	friend bool operator==(const set<OtherK, OtherComp, OtherAlloc, OtherTree>&, const set<OtherK, OtherComp, OtherAlloc, OtherTree>&);
+	template <typename OtherK, typename OtherComp, typename OtherAlloc, typename OtherTree>
+	friend bool operator<(const set<OtherK, OtherComp, OtherAlloc, OtherTree>&, const set<OtherK, OtherComp, OtherAlloc, OtherTree>&);
 };
-template <typename K, typename Comp, typename Alloc>
-bool operator==(const set<K, Comp, Alloc>& lhs, const set<K, Comp, Alloc>& rhs) { return lhs.rep == rhs.rep; }
-template <typename K, typename Comp, typename Alloc>
-bool operator<(const set<K, Comp, Alloc>& lhs, const set<K, Comp, Alloc>& rhs) { return lhs.rep < rhs.rep; }
-template <typename K, typename Comp, typename Alloc>
-bool operator!=(const set<K, Comp, Alloc>& lhs, const set<K, Comp, Alloc>& rhs) { return !(lhs == rhs); }
-template <typename K, typename Comp, typename Alloc>
-bool operator>(const set<K, Comp, Alloc>& lhs, const set<K, Comp, Alloc>& rhs) { return rhs < lhs; }
-template <typename K, typename Comp, typename Alloc>
-bool operator<=(const set<K, Comp, Alloc>& lhs, const set<K, Comp, Alloc>& rhs) { return !(rhs < lhs); }
-template <typename K, typename Comp, typename Alloc>
-bool operator>=(const set<K, Comp, Alloc>& lhs, const set<K, Comp, Alloc>& rhs) { return !(lhs < rhs); }
-
-template <class K, class Comp, class Alloc>
-void swap(set<K, Comp, Alloc>& lhs, set<K, Comp, Alloc>& rhs) { lhs.swap(rhs); }
+template <typename K, typename Comp, typename Alloc, typename Tree>
+bool operator==(const set<K, Comp, Alloc, Tree>& lhs, const set<K, Comp, Alloc, Tree>& rhs) { return lhs.rep == rhs.rep; }
+template <typename K, typename Comp, typename Alloc, typename Tree>
+bool operator<(const set<K, Comp, Alloc, Tree>& lhs, const set<K, Comp, Alloc, Tree>& rhs) { return lhs.rep < rhs.rep; }
+template <typename K, typename Comp, typename Alloc, typename Tree>
+bool operator!=(const set<K, Comp, Alloc, Tree>& lhs, const set<K, Comp, Alloc, Tree>& rhs) { return !(lhs == rhs); }
+template <typename K, typename Comp, typename Alloc, typename Tree>
+bool operator>(const set<K, Comp, Alloc, Tree>& lhs, const set<K, Comp, Alloc, Tree>& rhs) { return rhs < lhs; }
+template <typename K, typename Comp, typename Alloc, typename Tree>
+bool operator<=(const set<K, Comp, Alloc, Tree>& lhs, const set<K, Comp, Alloc, Tree>& rhs) { return !(rhs < lhs); }
+template <typename K, typename Comp, typename Alloc, typename Tree>
+bool operator>=(const set<K, Comp, Alloc, Tree>& lhs, const set<K, Comp, Alloc, Tree>& rhs) { return !(lhs < rhs); }
+
+template <class K, class Comp, class Alloc, class Tree>
+void swap(set<K, Comp, Alloc, Tree>& lhs, set<K, Comp, Alloc, Tree>& rhs) { lhs.swap(rhs); }
 }	//	FT
 #endif
\ No newline at end of file
@@ -0,0 +1,595 @@
+#ifndef SIMD_HPP
+# define SIMD_HPP
+
+#include "traits.hpp"
+
+#include <cstddef>
+
+#include <stdint.h>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+# define FT_SIMD_X86 1
+# include <immintrin.h>
+#else
+# define FT_SIMD_X86 0
+#endif
+
+namespace ft
+{
+namespace simd
+{
+
+/*
+ *	Element types with a vector kernel
+ */
+template<typename T> struct supported : public false_type {};
+template<> struct supported<int> : public true_type {};
+template<> struct supported<float> : public true_type {};
+
+/*
+ *	Scalar kernels : reference behaviour, tails and non x86 targets
+ */
+template<typename T>
+std::size_t find_scalar(const T* p, std::size_t i, std::size_t n, T v) {
+	for (; i < n; ++i) if (p[i] == v) return i;
+	return n;
+}
+
+template<typename T>
+std::size_t count_scalar(const T* p, std::size_t i, std::size_t n, T v) {
+	std::size_t ret = 0;
+	for (; i < n; ++i) ret += (p[i] == v);
+	return ret;
+}
+
+template<typename T>
+T min_scalar(const T* p, std::size_t i, std::size_t n, T m) {
+	for (; i < n; ++i) if (p[i] < m) m = p[i];
+	return m;
+}
+
+template<typename T>
+T max_scalar(const T* p, std::size_t i, std::size_t n, T m) {
+	for (; i < n; ++i) if (m < p[i]) m = p[i];
+	return m;
+}
+
+template<typename T>
+T sum_scalar(const T* p, std::size_t i, std::size_t n, T init) {
+	for (; i < n; ++i) init = init + p[i];
+	return init;
+}
+
+/*
+ *	Byte masks over 16 keys (radix_map Node16) : bit i set when keys[i] == b / keys[i] > b
+ */
+inline unsigned match_bytes16_scalar(const unsigned char* keys, unsigned char b) {
+	unsigned mask = 0;
+	for (int i = 0; i < 16; ++i) mask |= unsigned(keys[i] == b) << i;
+	return mask;
+}
+
+inline unsigned greater_bytes16_scalar(const unsigned char* keys, unsigned char b) {
+	unsigned mask = 0;
+	for (int i = 0; i < 16; ++i) mask |= unsigned(keys[i] > b) << i;
+	return mask;
+}
+
+/*
+ *	Word kernels over packed bits (vector<bool>)
+ */
+enum word_op { word_and, word_or, word_xor };
+
+template<int Op>
+inline uint64_t apply_word(uint64_t a, uint64_t b) {
+	return Op == word_and ? a & b : Op == word_or ? a | b : a ^ b;
+}
+
+inline std::size_t popcount_word(uint64_t w) {
+	w = w - ((w >> 1) & 0x5555555555555555ULL);
+	w = (w & 0x3333333333333333ULL) + ((w >> 2) & 0x3333333333333333ULL);
+	w = (w + (w >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+	return std::size_t((w * 0x0101010101010101ULL) >> 56);
+}
+
+inline std::size_t popcount_scalar(const uint64_t* p, std::size_t i, std::size_t n) {
+	std::size_t ret = 0;
+	for (; i < n; ++i) ret += popcount_word(p[i]);
+	return ret;
+}
+
+//	first word differing from skip (0 : any set bit, ~0 : any clear bit), n when none
+inline std::size_t find_word_scalar(const uint64_t* p, std::size_t i, std::size_t n, uint64_t skip) {
+	for (; i < n; ++i) if (p[i] != skip) return i;
+	return n;
+}
+
+template<int Op>
+void combine_scalar(uint64_t* dst, const uint64_t* src, std::size_t i, std::size_t n) {
+	for (; i < n; ++i) dst[i] = apply_word<Op>(dst[i], src[i]);
+}
+
+#if FT_SIMD_X86
+
+/*
+ *	Runtime dispatch, checked once per process
+ */
+inline bool has_sse2() {
+	static const bool ret = __builtin_cpu_supports("sse2");
+	return ret;
+}
+inline bool has_avx2() {
+	static const bool ret = __builtin_cpu_supports("avx2");
+	return ret;
+}
+inline bool has_popcnt() {
+	static const bool ret = __builtin_cpu_supports("popcnt");
+	return ret;
+}
+
+//	Lane counters are flushed before they can overflow
+static const std::size_t count_block = std::size_t(1) << 30;
+
+/*
+ *	SSE2
+ */
+__attribute__((target("sse2")))
+inline std::size_t find_sse2(const int* p, std::size_t n, int v) {
+	const __m128i key = _mm_set1_epi32(v);
+	std::size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+		const int mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(x, key)));
+		if (mask) return i + __builtin_ctz(mask);
+	}
+	return find_scalar(p, i, n, v);
+}
+
+__attribute__((target("sse2")))
+inline std::size_t find_sse2(const float* p, std::size_t n, float v) {
+	const __m128 key = _mm_set1_ps(v);
+	std::size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		const int mask = _mm_movemask_ps(_mm_cmpeq_ps(_mm_loadu_ps(p + i), key));
+		if (mask) return i + __builtin_ctz(mask);
+	}
+	return find_scalar(p, i, n, v);
+}
+
+__attribute__((target("sse2")))
+inline std::size_t count_sse2(const int* p, std::size_t n, int v) {
+	const __m128i key = _mm_set1_epi32(v);
+	std::size_t ret = 0;
+	std::size_t i = 0;
+	while (i + 4 <= n) {
+		const std::size_t stop = (n - i) / 4 > count_block ? i + count_block * 4 : n - (n - i) % 4;
+		__m128i acc = _mm_setzero_si128();
+		for (; i < stop; i += 4) {
+			const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+			acc = _mm_sub_epi32(acc, _mm_cmpeq_epi32(x, key));
+		}
+		unsigned int lane[4];
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(lane), acc);
+		ret += std::size_t(lane[0]) + lane[1] + lane[2] + lane[3];
+	}
+	return ret + count_scalar(p, i, n, v);
+}
+
+__attribute__((target("sse2")))
+inline std::size_t count_sse2(const float* p, std::size_t n, float v) {
+	const __m128 key = _mm_set1_ps(v);
+	std::size_t ret = 0;
+	std::size_t i = 0;
+	while (i + 4 <= n) {
+		const std::size_t stop = (n - i) / 4 > count_block ? i + count_block * 4 : n - (n - i) % 4;
+		__m128i acc = _mm_setzero_si128();
+		for (; i < stop; i += 4)
+			acc = _mm_sub_epi32(acc, _mm_castps_si128(_mm_cmpeq_ps(_mm_loadu_ps(p + i), key)));
+		unsigned int lane[4];
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(lane), acc);
+		ret += std::size_t(lane[0]) + lane[1] + lane[2] + lane[3];
+	}
+	return ret + count_scalar(p, i, n, v);
+}
+
+//	SSE2 has no pminsd/pmaxsd : select through a compare mask
+__attribute__((target("sse2")))
+inline int min_sse2(const int* p, std::size_t n) {
+	__m128i acc = _mm_set1_epi32(p[0]);
+	std::size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+		const __m128i lt = _mm_cmplt_epi32(x, acc);
+		acc = _mm_or_si128(_mm_and_si128(lt, x), _mm_andnot_si128(lt, acc));
+	}
+	int lane[4];
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(lane), acc);
+	return min_scalar(p, i, n, min_scalar(lane, 0, 4, lane[0]));
+}
+
+__attribute__((target("sse2")))
+inline int max_sse2(const int* p, std::size_t n) {
+	__m128i acc = _mm_set1_epi32(p[0]);
+	std::size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+		const __m128i gt = _mm_cmpgt_epi32(x, acc);
+		acc = _mm_or_si128(_mm_and_si128(gt, x), _mm_andnot_si128(gt, acc));
+	}
+	int lane[4];
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(lane), acc);
+	return max_scalar(p, i, n, max_scalar(lane, 0, 4, lane[0]));
+}
+
+//	minps returns its second operand on NaN, so NaN elements are skipped like in the scalar loop
+__attribute__((target("sse2")))
+inline float min_sse2(const float* p, std::size_t n) {
+	__m128 acc = _mm_set1_ps(p[0]);
+	std::size_t i = 0;
+	for (; i + 4 <= n; i += 4) acc = _mm_min_ps(_mm_loadu_ps(p + i), acc);
+	float lane[4];
+	_mm_storeu_ps(lane, acc);
+	return min_scalar(p, i, n, min_scalar(lane, 0, 4, lane[0]));
+}
+
+__attribute__((target("sse2")))
+inline float max_sse2(const float* p, std::size_t n) {
+	__m128 acc = _mm_set1_ps(p[0]);
+	std::size_t i = 0;
+	for (; i + 4 <= n; i += 4) acc = _mm_max_ps(_mm_loadu_ps(p + i), acc);
+	float lane[4];
+	_mm_storeu_ps(lane, acc);
+	return max_scalar(p, i, n, max_scalar(lane, 0, 4, lane[0]));
+}
+
+__attribute__((target("sse2")))
+inline unsigned match_bytes16_sse2(const unsigned char* keys, unsigned char b) {
+	const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(keys));
+	return unsigned(_mm_movemask_epi8(_mm_cmpeq_epi8(x, _mm_set1_epi8(char(b)))));
+}
+
+//	no unsigned byte compare : flip the sign bits and compare signed
+__attribute__((target("sse2")))
+inline unsigned greater_bytes16_sse2(const unsigned char* keys, unsigned char b) {
+	const __m128i bias = _mm_set1_epi8(char(0x80));
+	const __m128i x = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(keys)), bias);
+	const __m128i v = _mm_xor_si128(_mm_set1_epi8(char(b)), bias);
+	return unsigned(_mm_movemask_epi8(_mm_cmpgt_epi8(x, v)));
+}
+
+__attribute__((target("sse2")))
+inline int sum_sse2(const int* p, std::size_t n, int init) {
+	__m128i acc = _mm_setzero_si128();
+	std::size_t i = 0;
+	for (; i + 4 <= n; i += 4)
+		acc = _mm_add_epi32(acc, _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i)));
+	unsigned int lane[4];
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(lane), acc);
+	const unsigned int total = unsigned(init) + lane[0] + lane[1] + lane[2] + lane[3];
+	return sum_scalar(p, i, n, int(total));
+}
+
+__attribute__((target("sse2")))
+inline float sum_sse2(const float* p, std::size_t n, float init) {
+	__m128 acc = _mm_setzero_ps();
+	std::size_t i = 0;
+	for (; i + 4 <= n; i += 4) acc = _mm_add_ps(acc, _mm_loadu_ps(p + i));
+	float lane[4];
+	_mm_storeu_ps(lane, acc);
+	return sum_scalar(p, i, n, init + ((lane[0] + lane[1]) + (lane[2] + lane[3])));
+}
+
+__attribute__((target("sse2")))
+inline std::size_t find_word_sse2(const uint64_t* p, std::size_t n, uint64_t skip) {
+	const __m128i key = _mm_set1_epi64x(static_cast<long long>(skip));
+	std::size_t i = 0;
+	for (; i + 2 <= n; i += 2) {
+		const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+		const int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(x, key));
+		if (mask != 0xffff) return i + ((mask & 0xff) == 0xff);
+	}
+	return find_word_scalar(p, i, n, skip);
+}
+
+template<int Op>
+__attribute__((target("sse2")))
+void combine_sse2(uint64_t* dst, const uint64_t* src, std::size_t n) {
+	std::size_t i = 0;
+	for (; i + 2 <= n; i += 2) {
+		const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+		const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+		const __m128i r = Op == word_and ? _mm_and_si128(a, b) : Op == word_or ? _mm_or_si128(a, b) : _mm_xor_si128(a, b);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), r);
+	}
+	combine_scalar<Op>(dst, src, i, n);
+}
+
+//	hardware popcnt, four chains so the adds do not serialize on one register
+__attribute__((target("popcnt")))
+inline std::size_t popcount_popcnt(const uint64_t* p, std::size_t n) {
+	std::size_t a = 0, b = 0, c = 0, d = 0;
+	std::size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		a += __builtin_popcountll(p[i]);
+		b += __builtin_popcountll(p[i + 1]);
+		c += __builtin_popcountll(p[i + 2]);
+		d += __builtin_popcountll(p[i + 3]);
+	}
+	for (; i < n; ++i) a += __builtin_popcountll(p[i]);
+	return a + b + c + d;
+}
+
+/*
+ *	AVX2
+ */
+__attribute__((target("avx2")))
+inline std::size_t find_avx2(const int* p, std::size_t n, int v) {
+	const __m256i key = _mm256_set1_epi32(v);
+	std::size_t i = 0;
+	for (; i + 16 <= n; i += 16) {
+		const __m256i a = _mm256_cmpeq_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i)), key);
+		const __m256i b = _mm256_cmpeq_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i + 8)), key);
+		if (!_mm256_testz_si256(_mm256_or_si256(a, b), _mm256_or_si256(a, b))) {
+			const int mask = _mm256_movemask_ps(_mm256_castsi256_ps(a))
+				| (_mm256_movemask_ps(_mm256_castsi256_ps(b)) << 8);
+			return i + __builtin_ctz(mask);
+		}
+	}
+	return find_scalar(p, i, n, v);
+}
+
+__attribute__((target("avx2")))
+inline std::size_t find_avx2(const float* p, std::size_t n, float v) {
+	const __m256 key = _mm256_set1_ps(v);
+	std::size_t i = 0;
+	for (; i + 16 <= n; i += 16) {
+		const int mask = _mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(p + i), key, _CMP_EQ_OQ))
+			| (_mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(p + i + 8), key, _CMP_EQ_OQ)) << 8);
+		if (mask) return i + __builtin_ctz(mask);
+	}
+	return find_scalar(p, i, n, v);
+}
+
+__attribute__((target("avx2")))
+inline std::size_t count_avx2(const int* p, std::size_t n, int v) {
+	const __m256i key = _mm256_set1_epi32(v);
+	std::size_t ret = 0;
+	std::size_t i = 0;
+	while (i + 8 <= n) {
+		const std::size_t stop = (n - i) / 8 > count_block ? i + count_block * 8 : n - (n - i) % 8;
+		__m256i acc = _mm256_setzero_si256();
+		for (; i < stop; i += 8) {
+			const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+			acc = _mm256_sub_epi32(acc, _mm256_cmpeq_epi32(x, key));
+		}
+		unsigned int lane[8];
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(lane), acc);
+		for (int l = 0; l < 8; ++l) ret += lane[l];
+	}
+	return ret + count_scalar(p, i, n, v);
+}
+
+__attribute__((target("avx2")))
+inline std::size_t count_avx2(const float* p, std::size_t n, float v) {
+	const __m256 key = _mm256_set1_ps(v);
+	std::size_t ret = 0;
+	std::size_t i = 0;
+	while (i + 8 <= n) {
+		const std::size_t stop = (n - i) / 8 > count_block ? i + count_block * 8 : n - (n - i) % 8;
+		__m256i acc = _mm256_setzero_si256();
+		for (; i < stop; i += 8)
+			acc = _mm256_sub_epi32(acc, _mm256_castps_si256(_mm256_cmp_ps(_mm256_loadu_ps(p + i), key, _CMP_EQ_OQ)));
+		unsigned int lane[8];
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(lane), acc);
+		for (int l = 0; l < 8; ++l) ret += lane[l];
+	}
+	return ret + count_scalar(p, i, n, v);
+}
+
+__attribute__((target("avx2")))
+inline int min_avx2(const int* p, std::size_t n) {
+	__m256i acc = _mm256_set1_epi32(p[0]);
+	std::size_t i = 0;
+	for (; i + 8 <= n; i += 8)
+		acc = _mm256_min_epi32(acc, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i)));
+	int lane[8];
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(lane), acc);
+	return min_scalar(p, i, n, min_scalar(lane, 0, 8, lane[0]));
+}
+
+__attribute__((target("avx2")))
+inline int max_avx2(const int* p, std::size_t n) {
+	__m256i acc = _mm256_set1_epi32(p[0]);
+	std::size_t i = 0;
+	for (; i + 8 <= n; i += 8)
+		acc = _mm256_max_epi32(acc, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i)));
+	int lane[8];
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(lane), acc);
+	return max_scalar(p, i, n, max_scalar(lane, 0, 8, lane[0]));
+}
+
+__attribute__((target("avx2")))
+inline float min_avx2(const float* p, std::size_t n) {
+	__m256 acc = _mm256_set1_ps(p[0]);
+	std::size_t i = 0;
+	for (; i + 8 <= n; i += 8) acc = _mm256_min_ps(_mm256_loadu_ps(p + i), acc);
+	float lane[8];
+	_mm256_storeu_ps(lane, acc);
+	return min_scalar(p, i, n, min_scalar(lane, 0, 8, lane[0]));
+}
+
+__attribute__((target("avx2")))
+inline float max_avx2(const float* p, std::size_t n) {
+	__m256 acc = _mm256_set1_ps(p[0]);
+	std::size_t i = 0;
+	for (; i + 8 <= n; i += 8) acc = _mm256_max_ps(_mm256_loadu_ps(p + i), acc);
+	float lane[8];
+	_mm256_storeu_ps(lane, acc);
+	return max_scalar(p, i, n, max_scalar(lane, 0, 8, lane[0]));
+}
+
+__attribute__((target("avx2")))
+inline int sum_avx2(const int* p, std::size_t n, int init) {
+	__m256i acc = _mm256_setzero_si256();
+	std::size_t i = 0;
+	for (; i + 8 <= n; i += 8)
+		acc = _mm256_add_epi32(acc, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i)));
+	unsigned int lane[8];
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(lane), acc);
+	unsigned int total = unsigned(init);
+	for (int l = 0; l < 8; ++l) total += lane[l];
+	return sum_scalar(p, i, n, int(total));
+}
+
+__attribute__((target("avx2")))
+inline float sum_avx2(const float* p, std::size_t n, float init) {
+	__m256 acc = _mm256_setzero_ps();
+	std::size_t i = 0;
+	for (; i + 8 <= n; i += 8) acc = _mm256_add_ps(acc, _mm256_loadu_ps(p + i));
+	float lane[8];
+	_mm256_storeu_ps(lane, acc);
+	return sum_scalar(p, i, n, init + (((lane[0] + lane[1]) + (lane[2] + lane[3]))
+		+ ((lane[4] + lane[5]) + (lane[6] + lane[7]))));
+}
+
+//	nibble lookup through vpshufb, bytes summed by vpsadbw (Mula)
+__attribute__((target("avx2")))
+inline std::size_t popcount_avx2(const uint64_t* p, std::size_t n) {
+	const __m256i lut = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+										 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+	const __m256i low = _mm256_set1_epi8(0x0f);
+	__m256i acc = _mm256_setzero_si256();
+	std::size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+		const __m256i cnt = _mm256_add_epi8(_mm256_shuffle_epi8(lut, _mm256_and_si256(x, low)),
+											_mm256_shuffle_epi8(lut, _mm256_and_si256(_mm256_srli_epi16(x, 4), low)));
+		acc = _mm256_add_epi64(acc, _mm256_sad_epu8(cnt, _mm256_setzero_si256()));
+	}
+	uint64_t lane[4];
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(lane), acc);
+	return std::size_t(lane[0] + lane[1] + lane[2] + lane[3]) + popcount_scalar(p, i, n);
+}
+
+__attribute__((target("avx2")))
+inline std::size_t find_word_avx2(const uint64_t* p, std::size_t n, uint64_t skip) {
+	const __m256i key = _mm256_set1_epi64x(static_cast<long long>(skip));
+	std::size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+		const int mask = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(x, key)));
+		if (mask != 0xf) return i + __builtin_ctz(~mask & 0xf);
+	}
+	return find_word_scalar(p, i, n, skip);
+}
+
+template<int Op>
+__attribute__((target("avx2")))
+void combine_avx2(uint64_t* dst, const uint64_t* src, std::size_t n) {
+	std::size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+		const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+		const __m256i r = Op == word_and ? _mm256_and_si256(a, b)
+			: Op == word_or ? _mm256_or_si256(a, b) : _mm256_xor_si256(a, b);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), r);
+	}
+	combine_scalar<Op>(dst, src, i, n);
+}
+
+#endif	//	FT_SIMD_X86
+
+/*
+ *	Entry points : best kernel for the running cpu
+ *	min / max return the value, callers locate its first position with find
+ */
+template<typename T>
+std::size_t find(const T* p, std::size_t n, T v) {
+#if FT_SIMD_X86
+	if (has_avx2()) return find_avx2(p, n, v);
+	if (has_sse2()) return find_sse2(p, n, v);
+#endif
+	return find_scalar(p, 0, n, v);
+}
+
+template<typename T>
+std::size_t count(const T* p, std::size_t n, T v) {
+#if FT_SIMD_X86
+	if (has_avx2()) return count_avx2(p, n, v);
+	if (has_sse2()) return count_sse2(p, n, v);
+#endif
+	return count_scalar(p, 0, n, v);
+}
+
+template<typename T>
+T min(const T* p, std::size_t n) {
+#if FT_SIMD_X86
+	if (has_avx2()) return min_avx2(p, n);
+	if (has_sse2()) return min_sse2(p, n);
+#endif
+	return min_scalar(p, 0, n, p[0]);
+}
+
+template<typename T>
+T max(const T* p, std::size_t n) {
+#if FT_SIMD_X86
+	if (has_avx2()) return max_avx2(p, n);
+	if (has_sse2()) return max_sse2(p, n);
+#endif
+	return max_scalar(p, 0, n, p[0]);
+}
+
+//	float lanes are summed independently : the result may differ from a left fold in the last bits
+template<typename T>
+T sum(const T* p, std::size_t n, T init) {
+#if FT_SIMD_X86
+	if (has_avx2()) return sum_avx2(p, n, init);
+	if (has_sse2()) return sum_sse2(p, n, init);
+#endif
+	return sum_scalar(p, 0, n, init);
+}
+
+inline unsigned match_bytes16(const unsigned char* keys, unsigned char b) {
+#if FT_SIMD_X86
+	if (has_sse2()) return match_bytes16_sse2(keys, b);
+#endif
+	return match_bytes16_scalar(keys, b);
+}
+
+inline unsigned greater_bytes16(const unsigned char* keys, unsigned char b) {
+#if FT_SIMD_X86
+	if (has_sse2()) return greater_bytes16_sse2(keys, b);
+#endif
+	return greater_bytes16_scalar(keys, b);
+}
+
+inline std::size_t popcount(const uint64_t* p, std::size_t n) {
+#if FT_SIMD_X86
+	if (has_avx2()) return popcount_avx2(p, n);
+	if (has_popcnt()) return popcount_popcnt(p, n);
+#endif
+	return popcount_scalar(p, 0, n);
+}
+
+inline std::size_t find_word(const uint64_t* p, std::size_t n, uint64_t skip) {
+#if FT_SIMD_X86
+	if (has_avx2()) return find_word_avx2(p, n, skip);
+	if (has_sse2()) return find_word_sse2(p, n, skip);
+#endif
+	return find_word_scalar(p, 0, n, skip);
+}
+
+//	dst[i] = dst[i] Op src[i]
+template<int Op>
+void combine(uint64_t* dst, const uint64_t* src, std::size_t n) {
+#if FT_SIMD_X86
+	if (has_avx2()) return combine_avx2<Op>(dst, src, n);
+	if (has_sse2()) return combine_sse2<Op>(dst, src, n);
+#endif
+	combine_scalar<Op>(dst, src, 0, n);
+}
+
+}	//	SIMD
+}	//	FT
+
+#endif
@@ -0,0 +1,350 @@
+#ifndef SNAPSHOT_HPP
+# define SNAPSHOT_HPP
+
+#include "map.hpp"
+#include "set.hpp"
+#include "traits.hpp"
+#include "vector.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+
+#include <stdint.h>
+
+namespace ft
+{
+
+namespace snapshot
+{
+
+enum kind {
+	VECTOR = 1,
+	MAP = 2,
+	SET = 3
+};
+
+/*
+ *	File layout : header, then count raw values in order (sorted for map / set).
+ *	A map entry is stored as its key bytes then its mapped bytes, so the padding
+ *	of pair<const K, T> never reaches the file. checksum covers the values only.
+ */
+struct header
+{
+	char		magic[8];
+	uint32_t	version;
+	uint32_t	kind;
+	uint64_t	value_size;
+	uint64_t	count;
+	uint64_t	checksum;
+};
+
+static const char		magic[8] = { 'F', 'T', 'S', 'N', 'A', 'P', '\0', '\0' };
+static const uint32_t	version = 1;
+static const size_t		block = 1 << 20;
+
+/*
+ *	Word at a time multiplicative hash, independent of how the bytes are split
+ */
+class checksum
+{
+	uint64_t	h;
+	uint64_t	tail;
+	unsigned	tail_len;
+	uint64_t	len;
+
+	void mix(uint64_t w) { h = (h ^ w) * 0x9e3779b97f4a7c15ULL; h ^= h >> 29; }
+
+public:
+	checksum() : h(0x6a09e667f3bcc908ULL), tail(0), tail_len(0), len(0) {}
+
+	void update(const void* data, size_t n) {
+		const unsigned char*	s = static_cast<const unsigned char*>(data);
+
+		len += n;
+		for (; tail_len && n; --n) {
+			tail |= uint64_t(*s++) << (8 * tail_len);
+			if (++tail_len == 8) {
+				mix(tail);
+				tail = 0;
+				tail_len = 0;
+			}
+		}
+		for (; n >= 8; n -= 8, s += 8) {
+			uint64_t	w;
+			std::memcpy(&w, s, 8);
+			mix(w);
+		}
+		for (; n; --n) tail |= uint64_t(*s++) << (8 * tail_len++);
+	}
+
+	uint64_t value() const {
+		checksum	c(*this);
+		if (c.tail_len) c.mix(c.tail);
+		c.mix(len);
+		return c.h;
+	}
+};
+
+class file
+{
+	std::FILE*	f;
+
+	file(const file&);
+	file& operator=(const file&);
+
+public:
+	file(const char* path, const char* mode) : f(std::fopen(path, mode)) {
+		if (f == 0) throw std::runtime_error(std::string("snapshot : cannot open ") + path);
+	}
+	~file() { if (f) std::fclose(f); }
+
+	void write(const void* data, size_t n) {
+		if (n && std::fwrite(data, 1, n, f) != n) throw std::runtime_error("snapshot : write failed");
+	}
+	size_t read_some(void* data, size_t n) { return std::fread(data, 1, n, f); }
+	void read(void* data, size_t n) {
+		if (read_some(data, n) != n) throw std::runtime_error("snapshot : truncated file");
+	}
+	void rewind() { std::rewind(f); }
+	void close() {
+		std::FILE* tmp = f;
+		f = 0;
+		if (std::fclose(tmp) != 0) throw std::runtime_error("snapshot : close failed");
+	}
+};
+
+inline header make_header(kind k, size_t value_size, size_t count) {
+	header	h;
+	std::memcpy(h.magic, magic, sizeof(magic));
+	h.version = version;
+	h.kind = k;
+	h.value_size = value_size;
+	h.count = count;
+	h.checksum = 0;
+	return h;
+}
+
+inline header read_header(file& f, kind k, size_t value_size) {
+	header	h;
+	f.read(&h, sizeof(h));
+	if (std::memcmp(h.magic, magic, sizeof(magic)) != 0 || h.version != version)
+		throw std::runtime_error("snapshot : not a snapshot file");
+	if (h.kind != uint32_t(k) || h.value_size != value_size)
+		throw std::runtime_error("snapshot : container or value type mismatch");
+	return h;
+}
+
+/*
+ *	Record : how one value of a sorted dump is laid out in the file
+ */
+template<typename V>
+struct record
+{
+	static const size_t	size = sizeof(V);
+
+	static void pack(char* dst, const V& v) { std::memcpy(dst, &v, sizeof(V)); }
+
+	//	the bytes are the value, read in place
+	struct slot
+	{
+		const V& load(const char* src) { return *reinterpret_cast<const V*>(src); }
+	};
+};
+
+template<typename K, typename T>
+struct record<pair<const K, T> >
+{
+	typedef pair<const K, T>	value_type;
+
+	static const size_t	size = sizeof(K) + sizeof(T);
+
+	static void pack(char* dst, const value_type& v) {
+		std::memcpy(dst, &v.first, sizeof(K));
+		std::memcpy(dst + sizeof(K), &v.second, sizeof(T));
+	}
+
+	//	rebuilt field by field, the padding of the pair is never touched
+	struct slot
+	{
+		alignas(value_type) unsigned char	storage[sizeof(value_type)];
+
+		const value_type& load(const char* src) {
+			value_type*	v = reinterpret_cast<value_type*>(storage);
+			std::memcpy(const_cast<K*>(&v->first), src, sizeof(K));
+			std::memcpy(&v->second, src + sizeof(K), sizeof(T));
+			return *v;
+		}
+	};
+};
+
+/*
+ *	Values of an ordered container, streamed through a block buffer
+ */
+template<typename Iter>
+void save_sorted(const char* path, kind k, Iter first, size_t count) {
+	typedef typename iterator_traits<Iter>::value_type	value_type;
+	typedef record<value_type>							rec;
+
+	file				f(path, "wb");
+	header				h = make_header(k, rec::size, count);
+	checksum			sum;
+	const size_t		per_block = block / rec::size ? block / rec::size : 1;
+	ft::vector<char>	buf(per_block * rec::size);
+
+	f.write(&h, sizeof(h));
+	for (size_t done = 0; done < count; ) {
+		const size_t	n = count - done < per_block ? count - done : per_block;
+		for (size_t i = 0; i < n; ++i, ++first)
+			rec::pack(&buf[i * rec::size], *first);
+		sum.update(&buf[0], n * rec::size);
+		f.write(&buf[0], n * rec::size);
+		done += n;
+	}
+	h.checksum = sum.value();
+	f.rewind();
+	f.write(&h, sizeof(h));
+	f.close();
+}
+
+/*
+ *	Input iterator over the values of a file, one block read at a time
+ */
+template<typename V>
+class record_reader
+{
+	typedef record<V>	rec;
+
+	file&				f;
+	ft::vector<char>	buf;
+	typename rec::slot	slot;
+	size_t				left;		//	records not read from the file yet
+	size_t				pos;
+	size_t				avail;
+	checksum			sum;
+
+	void refill() {
+		const size_t	per_block = buf.size() / rec::size;
+		const size_t	n = left < per_block ? left : per_block;
+		f.read(&buf[0], n * rec::size);
+		sum.update(&buf[0], n * rec::size);
+		left -= n;
+		avail = n;
+		pos = 0;
+	}
+
+public:
+	record_reader(file& in, size_t count)
+	: f(in), buf((block / rec::size ? block / rec::size : 1) * rec::size), left(count), pos(0), avail(0) {}
+
+	const V& current() {
+		if (pos == avail) refill();
+		return slot.load(&buf[pos * rec::size]);
+	}
+	void next() { ++pos; }
+	uint64_t digest() const { return sum.value(); }
+
+	class iterator
+	{
+		record_reader*	r;
+
+	public:
+		typedef std::input_iterator_tag		iterator_category;
+		typedef V							value_type;
+		typedef std::ptrdiff_t				difference_type;
+		typedef const V*					pointer;
+		typedef const V&					reference;
+
+		explicit iterator(record_reader* reader) : r(reader) {}
+		reference operator*() const { return r->current(); }
+		pointer operator->() const { return &r->current(); }
+		iterator& operator++() {
+			r->next();
+			return *this;
+		}
+	};
+};
+
+template<typename Container, typename V>
+void load_sorted(const char* path, kind k, Container& c, const V*) {
+	file				f(path, "rb");
+	const header		h = read_header(f, k, record<V>::size);
+	record_reader<V>	reader(f, h.count);
+
+	c.assign_sorted(typename record_reader<V>::iterator(&reader), h.count);
+	if (reader.digest() != h.checksum) {
+		c.clear();
+		throw std::runtime_error("snapshot : checksum mismatch");
+	}
+}
+
+}	//	SNAPSHOT
+
+/*
+ *	save / load : binary snapshots of trivially copyable contents.
+ *	Throws std::runtime_error on I/O errors, foreign or corrupted files.
+ *	A vector is read straight into its storage, a map / set is rebuilt in O(n)
+ *	from its sorted dump. Files are only portable between identical builds.
+ */
+template<typename T, typename Alloc>
+void save(const char* path, const ft::vector<T, Alloc>& v) {
+	static_assert(is_bitwise_copyable<T>::value, "snapshot needs trivially copyable values");
+	snapshot::file		f(path, "wb");
+	snapshot::header	h = snapshot::make_header(snapshot::VECTOR, sizeof(T), v.size());
+	snapshot::checksum	sum;
+
+	if (!v.empty()) sum.update(v.data(), v.size() * sizeof(T));
+	h.checksum = sum.value();
+	f.write(&h, sizeof(h));
+	if (!v.empty()) f.write(v.data(), v.size() * sizeof(T));
+	f.close();
+}
+
+template<typename T, typename Alloc>
+void load(const char* path, ft::vector<T, Alloc>& v) {
+	static_assert(is_bitwise_copyable<T>::value, "snapshot needs trivially copyable values");
+	snapshot::file			f(path, "rb");
+	const snapshot::header	h = snapshot::read_header(f, snapshot::VECTOR, sizeof(T));
+	snapshot::checksum		sum;
+
+	v.clear();
+	v.resize_default_init(h.count);
+	if (h.count) {
+		f.read(v.data(), h.count * sizeof(T));
+		sum.update(v.data(), h.count * sizeof(T));
+	}
+	if (sum.value() != h.checksum) {
+		v.clear();
+		throw std::runtime_error("snapshot : checksum mismatch");
+	}
+}
+
+template<typename K, typename T, typename Comp, typename Alloc>
+void save(const char* path, const ft::map<K, T, Comp, Alloc>& m) {
+	static_assert(is_bitwise_copyable<pair<const K, T> >::value, "snapshot needs trivially copyable values");
+	snapshot::save_sorted(path, snapshot::MAP, m.begin(), m.size());
+}
+
+template<typename K, typename T, typename Comp, typename Alloc>
+void load(const char* path, ft::map<K, T, Comp, Alloc>& m) {
+	static_assert(is_bitwise_copyable<pair<const K, T> >::value, "snapshot needs trivially copyable values");
+	snapshot::load_sorted(path, snapshot::MAP, m, static_cast<const pair<const K, T>*>(0));
+}
+
+template<typename K, typename Comp, typename Alloc>
+void save(const char* path, const ft::set<K, Comp, Alloc>& s) {
+	static_assert(is_bitwise_copyable<K>::value, "snapshot needs trivially copyable values");
+	snapshot::save_sorted(path, snapshot::SET, s.begin(), s.size());
+}
+
+template<typename K, typename Comp, typename Alloc>
+void load(const char* path, ft::set<K, Comp, Alloc>& s) {
+	static_assert(is_bitwise_copyable<K>::value, "snapshot needs trivially copyable values");
+	snapshot::load_sorted(path, snapshot::SET, s, static_cast<const K*>(0));
+}
+
+}	//	FT
+
+#endif
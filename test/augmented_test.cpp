@@ -0,0 +1,138 @@
+//	build with any mix of -DFT_RBTREE_THREADED / -DFT_RBTREE_COMPACT
+#include "check.hpp"
+#include "../map.hpp"
+#include "../set.hpp"
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <string>
+
+typedef ft::map<int, long, std::less<int>, std::allocator<ft::pair<const int, long> >,
+				ft::augmented_tree<ft::plus_monoid<long> > >				sum_map;
+typedef ft::map<int, int, std::less<int>, std::allocator<ft::pair<const int, int> >,
+				ft::augmented_tree<ft::max_monoid<int> > >					max_map;
+//	string concatenation is not commutative : checks the fold keeps key order
+typedef ft::map<int, std::string, std::less<int>, std::allocator<ft::pair<const int, std::string> >,
+				ft::augmented_tree<ft::plus_monoid<std::string> > >			concat_map;
+typedef ft::set<int, ft::less<int>, std::allocator<int>, ft::augmented_tree<ft::min_monoid<int> > >	min_set;
+
+static long sum_of(const std::map<int, long>& m, int lo, int hi) {
+	long s = 0;
+	for (std::map<int, long>::const_iterator it = m.lower_bound(lo); it != m.end() && it->first < hi; ++it)
+		s += it->second;
+	return s;
+}
+
+static int max_of(const std::map<int, long>& m, int lo, int hi) {
+	int r = std::numeric_limits<int>::lowest();
+	for (std::map<int, long>::const_iterator it = m.lower_bound(lo); it != m.end() && it->first < hi; ++it)
+		if (it->second > r) r = int(it->second);
+	return r;
+}
+
+static std::string concat_of(const std::map<int, long>& m, int lo, int hi) {
+	std::string s;
+	for (std::map<int, long>::const_iterator it = m.lower_bound(lo); it != m.end() && it->first < hi; ++it)
+		s += char('a' + it->second % 26);
+	return s;
+}
+
+static void random_ops() {
+	sum_map				sums;
+	max_map				maxs;
+	concat_map			concat;
+	min_set				mins;
+	std::map<int, long>	ref;
+	bool				ok = true;
+
+	for (int i = 0; i < 200000; ++i) {
+		const int	k = rand() % 4000;
+		const long	v = rand() % 1000 - 500;
+		switch (rand() % 5) {
+			case 0:
+			case 1:
+				if (ref.insert(std::make_pair(k, v)).second) {
+					sums.insert(ft::make_pair(k, v));
+					maxs.insert(ft::make_pair(k, int(v)));
+					concat.insert(ft::make_pair(k, std::string(1, char('a' + v % 26))));
+					mins.insert(k);
+				}
+				break;
+			case 2:
+				ok = ok && sums.erase(k) == ref.erase(k);
+				maxs.erase(k);
+				concat.erase(k);
+				mins.erase(k);
+				break;
+			case 3:
+				if (ref.count(k)) {		//	in place write
+					ref[k] = v;
+					sums.update(k, v);
+					maxs.update(k, int(v));
+					concat.update(k, std::string(1, char('a' + v % 26)));
+				}
+				break;
+			default: {
+				int lo = rand() % 4200 - 100;
+				int hi = lo + rand() % (rand() % 2 ? 50 : 4200);
+				ok = ok && sums.aggregate(lo, hi) == sum_of(ref, lo, hi);
+				ok = ok && maxs.aggregate(lo, hi) == max_of(ref, lo, hi);
+				ok = ok && concat.aggregate(lo, hi) == concat_of(ref, lo, hi);
+				std::map<int, long>::const_iterator	first = ref.lower_bound(lo);
+				const int	expect = first != ref.end() && first->first < hi ? first->first : std::numeric_limits<int>::max();
+				ok = ok && mins.aggregate(lo, hi) == expect;
+			}
+		}
+	}
+	CHECK("random operations", ok && sums.size() == ref.size());
+	CHECK("whole tree", sums.aggregate() == sum_of(ref, std::numeric_limits<int>::min(), std::numeric_limits<int>::max()));
+	CHECK("empty range", sums.aggregate(10, 10) == 0 && sums.aggregate(20, 10) == 0);
+}
+
+static void copies() {
+	sum_map	a;
+	long	total = 0;
+
+	for (int i = 0; i < 1000; ++i) {
+		a.insert(ft::make_pair(i * 3, long(i)));
+		total += i;
+	}
+	sum_map	b(a);
+	CHECK("copy", b.aggregate() == total && b.aggregate(0, 30) == 45);
+	b.erase(0);
+	b.erase(27);
+	CHECK("copy independent", a.aggregate(0, 30) == 45 && b.aggregate(0, 30) == 36);
+
+	sum_map	c;
+	c.swap(b);
+	CHECK("swap", c.aggregate(0, 30) == 36 && b.aggregate() == 0);
+
+	ft::pair<int, long>	sorted[5000];
+	for (int i = 0; i < 5000; ++i) sorted[i] = ft::make_pair(i, long(1));
+	sum_map	d;
+	d.assign_sorted(sorted, 5000);
+	CHECK("assign_sorted", d.aggregate() == 5000 && d.aggregate(100, 1100) == 1000);
+	d.insert(ft::make_pair(-1, long(10)));
+	CHECK("insert after assign_sorted", d.aggregate(-5, 5) == 15);
+	d = a;
+	CHECK("assignment", d.aggregate() == total);
+	d.clear();
+	CHECK("clear", d.aggregate() == 0 && d.aggregate(0, 100) == 0);
+
+	//	update inserts a missing key ; iterators only read
+	sum_map::iterator	it = d.update(7, 70);
+	d.update(8, 80);
+	d.update(7, 71);
+	CHECK("update", it->second == 71 && d.size() == 2 && d.aggregate() == 151 && d.aggregate(8, 9) == 80);
+	long	seen = 0;
+	for (sum_map::reverse_iterator r = d.rbegin(); r != d.rend(); ++r) seen += r->second;
+	CHECK("read through iterators", seen == 151);
+}
+
+int main() {
+	srand(42);
+	random_ops();
+	copies();
+	return check::report();
+}
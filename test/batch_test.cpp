@@ -0,0 +1,62 @@
+//	build with any mix of -DFT_RBTREE_THREADED / -DFT_RBTREE_COMPACT
+#include "check.hpp"
+#include "../map.hpp"
+#include "../set.hpp"
+#include "../index_tree.hpp"
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+template<typename M>
+static void check_map(const char* name, M& m, const std::vector<int>& keys) {
+	typedef typename M::iterator		iterator;
+	typedef typename M::const_iterator	const_iterator;
+	std::vector<iterator>		found(keys.size());
+	std::vector<const_iterator>	lower(keys.size());
+	const M&					cm = m;
+
+	CHECK(name, m.find_batch(keys.begin(), keys.end(), found.begin()) == found.end());
+	cm.lower_bound_batch(keys.begin(), keys.end(), lower.begin());
+	bool ok = true;
+	for (size_t i = 0; i < keys.size(); ++i)
+		ok = ok && found[i] == m.find(keys[i]) && lower[i] == cm.lower_bound(keys[i]);
+	CHECK(name, ok);
+	if (!found.empty() && found[0] != m.end()) {
+		found[0]->second = -1;
+		CHECK(name, m.find(keys[0])->second == -1);
+	}
+}
+
+int main() {
+	srand(39);
+	std::vector<int> keys;
+	for (int i = 0; i < 1000; ++i) keys.push_back(rand() % 4000 - 100);
+
+	{
+		ft::map<int, int> m;
+		check_map("empty map", m, keys);
+		for (int i = 0; i < 1500; ++i) m[rand() % 3000] = i;
+		check_map("map", m, keys);
+		check_map("map, partial group", m, std::vector<int>(keys.begin(), keys.begin() + 21));
+		check_map("map, no keys", m, std::vector<int>());
+
+		ft::map<int, int, std::less<int>, std::allocator<ft::pair<const int, int> >, ft::index_tree> im;
+		check_map("empty index map", im, keys);
+		for (ft::map<int, int>::iterator it = m.begin(); it != m.end(); ++it) im.insert(*it);
+		check_map("index map", im, keys);
+	}
+	{
+		ft::set<int> s;
+		for (int i = 0; i < 1000; ++i) s.insert(rand() % 3000);
+		std::vector<ft::set<int>::iterator> out(keys.size());
+		s.find_batch(keys.begin(), keys.end(), out.begin());
+		bool ok = true;
+		for (size_t i = 0; i < keys.size(); ++i) ok = ok && out[i] == s.find(keys[i]);
+		CHECK("set find", ok);
+		s.lower_bound_batch(keys.begin(), keys.end(), out.begin());
+		for (size_t i = 0; i < keys.size(); ++i) ok = ok && out[i] == s.lower_bound(keys[i]);
+		CHECK("set lower_bound", ok);
+	}
+
+	return check::report();
+}
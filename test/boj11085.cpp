@@ -32,7 +32,7 @@ int main() {
 	for (conn& i : conns) cin >> i.second.first >> i.second.second >> i.first;
 	for (int i = 0; i < n; i++) parent[i] = i;
 
-	sort(conns.begin(), conns.end());
+	ft::sort(conns.begin(), conns.end());
 	int ret;
 	while (find(c) != find(v)) {
 		ret = conns.back().first;
@@ -0,0 +1,27 @@
+#ifndef CHECK_HPP
+# define CHECK_HPP
+
+#include <iostream>
+
+namespace check
+{
+
+inline int& failures() {
+	static int	count = 0;
+	return count;
+}
+
+/*
+ *	Print the verdict and hand main its exit status
+ */
+inline int report() {
+	std::cout << (failures() ? "FAILED" : "OK") << std::endl;
+	return failures() != 0;
+}
+
+}	//	CHECK
+
+#define CHECK(name, expr) \
+	do { if (!(expr)) { ++check::failures(); std::cout << "FAIL : " << name << std::endl; } } while (0)
+
+#endif
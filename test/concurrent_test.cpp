@@ -0,0 +1,122 @@
+#include "check.hpp"
+#include "../concurrent_stack.hpp"
+#include "../concurrent_queue.hpp"
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <stdexcept>
+#include <string>
+#include <iostream>
+
+//	copies and assignments throw while armed
+struct fragile
+{
+	static bool	armed;
+	int			v;
+
+	fragile(int x = 0) : v(x) {}
+	fragile(const fragile& o) : v(o.v) { if (armed) throw std::runtime_error("copy"); }
+	fragile& operator=(const fragile& o) {
+		if (armed) throw std::runtime_error("assign");
+		v = o.v;
+		return *this;
+	}
+};
+bool fragile::armed = false;
+
+template<typename Container>
+bool stress(Container& con, int producers, int consumers, int per_producer) {
+	const int total = producers * per_producer;
+	std::vector<std::atomic<int> > seen(total);
+	for (int i = 0; i < total; i++) seen[i] = 0;
+	std::atomic<int> consumed(0);
+	std::vector<std::thread> threads;
+
+	for (int p = 0; p < producers; p++)
+		threads.push_back(std::thread([&, p] {
+			for (int i = 0; i < per_producer; i++) con.push(p * per_producer + i);
+		}));
+	for (int c = 0; c < consumers; c++)
+		threads.push_back(std::thread([&] {
+			int v;
+			while (consumed.load() < total) {
+				if (con.try_pop(v)) {
+					seen[v]++;
+					consumed++;
+				}
+				else std::this_thread::yield();
+			}
+		}));
+	for (size_t i = 0; i < threads.size(); i++) threads[i].join();
+
+	for (int i = 0; i < total; i++) if (seen[i] != 1) return false;
+	return con.empty();
+}
+
+int main() {
+	{
+		ft::concurrent_stack<std::string> st;
+		CHECK("stack empty", st.empty());
+		st.push("a");
+		st.push("b");
+		std::string out;
+		CHECK("stack lifo", st.try_pop(out) && out == "b" && st.size() == 1);
+		st.pop();
+		CHECK("stack pop", st.empty() && !st.try_pop(out));
+		st.push("left for the destructor");
+	}
+	{
+		ft::concurrent_queue<std::string> q(3);
+		CHECK("queue capacity", q.capacity() == 4);
+		for (int i = 0; i < 4; i++) q.push(std::string(1, char('a' + i)));
+		CHECK("queue full", !q.try_push("e") && q.size() == 4);
+		std::string out;
+		CHECK("queue fifo", q.try_pop(out) && out == "a");
+		q.pop();
+		CHECK("queue pop", q.try_pop(out) && out == "c" && q.size() == 1);
+	}
+	{
+		ft::concurrent_queue<fragile> q(2);
+		fragile out;
+		q.push(fragile(1));
+		fragile::armed = true;
+		bool threw = false;
+		try { q.try_push(fragile(2)); } catch (const std::runtime_error&) { threw = true; }
+		fragile::armed = false;
+		bool ok = q.try_pop(out) && out.v == 1;
+		q.push(fragile(3));
+		CHECK("queue throwing push", threw && ok && q.try_pop(out) && out.v == 3 && q.empty());
+
+		//	the ring keeps turning past failed pushes and pops
+		for (int i = 0; i < 10; i++) {
+			q.push(fragile(i));
+			fragile::armed = i % 2;
+			threw = false;
+			try { ok = ok && q.try_pop(out) && out.v == i; } catch (const std::runtime_error&) { threw = true; }
+			fragile::armed = false;
+			ok = ok && threw == bool(i % 2);
+		}
+		CHECK("queue throwing pop", ok && q.empty());
+		fragile::armed = true;
+		try { q.try_push(fragile(4)); } catch (const std::runtime_error&) {}
+		fragile::armed = false;
+	}
+	{
+		ft::concurrent_stack<fragile> st;
+		st.push(fragile(1));
+		st.push(fragile(2));
+		fragile out;
+		fragile::armed = true;
+		bool threw = false;
+		try { st.try_pop(out); } catch (const std::runtime_error&) { threw = true; }
+		fragile::armed = false;
+		CHECK("stack throwing pop", threw && st.size() == 2 && st.try_pop(out) && out.v == 2 && st.try_pop(out) && out.v == 1);
+	}
+	for (int threads = 1; threads <= 4; threads++) {
+		ft::concurrent_stack<int> st;
+		CHECK("stack stress", stress(st, threads, threads, 50000));
+		ft::concurrent_queue<int> q(1024);
+		CHECK("queue stress", stress(q, threads, threads, 50000));
+	}
+	return check::report();
+}
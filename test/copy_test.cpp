@@ -0,0 +1,67 @@
+#include "../vector.hpp"
+#include <vector>
+#include <string>
+#include <iostream>
+
+template<typename Vec>
+void print(const char* name, const Vec& v) {
+	std::cout << name << " :";
+	for (size_t i = 0; i < v.size(); i++) std::cout << ' ' << v[i];
+	std::cout << std::endl;
+}
+
+template<typename FtVec, typename StdVec>
+bool same(const FtVec& ft_v, const StdVec& std_v) {
+	if (ft_v.size() != std_v.size()) return false;
+	for (size_t i = 0; i < ft_v.size(); i++)
+		if (!(ft_v[i] == std_v[i])) return false;
+	return true;
+}
+
+int main() {
+	{
+		ft::vector<int> ft_v;
+		std::vector<int> std_v;
+		for (int i = 0; i < 10; i++) { ft_v.push_back(i); std_v.push_back(i); }
+
+		ft_v.erase(ft_v.begin());
+		std_v.erase(std_v.begin());
+		ft_v.erase(ft_v.begin() + 2, ft_v.begin() + 5);
+		std_v.erase(std_v.begin() + 2, std_v.begin() + 5);
+		ft_v.insert(ft_v.begin() + 1, 3, 42);
+		std_v.insert(std_v.begin() + 1, 3, 42);
+		print("ft  int", ft_v);
+		print("std int", std_v);
+		std::cout << "same : " << (same(ft_v, std_v) ? "TRUE" : "FALSE") << std::endl;
+	}
+	std::cout << "======================================" << std::endl;
+	{
+		int src[] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+		int dst[8] = { 0 };
+
+		ft::copy(src, src + 8, dst);
+		print("copy", std::vector<int>(dst, dst + 8));
+		ft::copy(dst + 2, dst + 8, dst);
+		print("copy overlap", std::vector<int>(dst, dst + 8));
+		ft::copy_backward(src, src + 6, dst + 8);
+		print("copy_backward", std::vector<int>(dst, dst + 8));
+		ft::copy_backward(dst, dst + 6, dst + 8);
+		print("copy_backward overlap", std::vector<int>(dst, dst + 8));
+	}
+	std::cout << "======================================" << std::endl;
+	{
+		ft::vector<std::string> ft_v;
+		std::vector<std::string> std_v;
+		const char* words[] = { "a", "bb", "ccc", "dddd", "eeeee" };
+		for (int i = 0; i < 5; i++) { ft_v.push_back(words[i]); std_v.push_back(words[i]); }
+
+		ft_v.erase(ft_v.begin() + 1);
+		std_v.erase(std_v.begin() + 1);
+		ft_v.insert(ft_v.begin(), 2, "zz");
+		std_v.insert(std_v.begin(), 2, "zz");
+		print("ft  string", ft_v);
+		print("std string", std_v);
+		std::cout << "same : " << (same(ft_v, std_v) ? "TRUE" : "FALSE") << std::endl;
+	}
+	return 0;
+}
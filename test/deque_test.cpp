@@ -0,0 +1,100 @@
+#include "check.hpp"
+#include "../deque.hpp"
+#include "../stack.hpp"
+#include <deque>
+#include <string>
+#include <cstdlib>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+
+template<typename FtDeq, typename StdDeq>
+bool same(const FtDeq& ft_d, const StdDeq& std_d) {
+	if (ft_d.size() != std_d.size()) return false;
+	typename FtDeq::const_iterator it = ft_d.begin();
+	for (size_t i = 0; i < std_d.size(); i++, ++it)
+		if (!(*it == std_d[i]) || !(ft_d[i] == std_d[i])) return false;
+	return it == ft_d.end();
+}
+
+int main() {
+	srand(11);
+	{
+		ft::deque<int> ft_d;
+		std::deque<int> std_d;
+		for (int round = 0; round < 20000; round++) {
+			const int v = rand();
+			switch (rand() % 8) {
+				case 0: case 1: ft_d.push_back(v); std_d.push_back(v); break;
+				case 2: case 3: ft_d.push_front(v); std_d.push_front(v); break;
+				case 4: if (!std_d.empty()) { ft_d.pop_back(); std_d.pop_back(); } break;
+				case 5: if (!std_d.empty()) { ft_d.pop_front(); std_d.pop_front(); } break;
+				case 6: {
+					size_t pos = std_d.empty() ? 0 : rand() % std_d.size();
+					size_t n = rand() % 5;
+					ft_d.insert(ft_d.begin() + pos, n, v);
+					std_d.insert(std_d.begin() + pos, n, v);
+					break;
+				}
+				case 7: if (!std_d.empty()) {
+					size_t pos = rand() % std_d.size();
+					size_t n = rand() % (std_d.size() - pos + 1);
+					ft_d.erase(ft_d.begin() + pos, ft_d.begin() + pos + n);
+					std_d.erase(std_d.begin() + pos, std_d.begin() + pos + n);
+				} break;
+			}
+		}
+		CHECK("random ops", same(ft_d, std_d));
+		CHECK("iterator distance", ft_d.end() - ft_d.begin() == (long)std_d.size());
+		CHECK("reverse", ft::equal(ft_d.rbegin(), ft_d.rend(), std_d.rbegin()));
+	}
+	{
+		ft::deque<int> d;
+		d.push_back(0);
+		int* first = &d.front();
+		for (int i = 1; i < 100000; i++) {
+			d.push_back(i);
+			d.push_front(-i);
+		}
+		CHECK("stable reference", *first == 0 && first == &d[99999]);
+		d.clear();
+		CHECK("clear", d.empty() && d.size() == 0);
+	}
+	{
+		const char* words[] = { "a", "bb", "ccc", "dddd", "eeeee", "ffffff" };
+		ft::deque<std::string> ft_d(words, words + 6);
+		std::deque<std::string> std_d(words, words + 6);
+		ft_d.insert(ft_d.begin() + 2, words, words + 3);
+		std_d.insert(std_d.begin() + 2, words, words + 3);
+		ft_d.erase(ft_d.begin() + 4);
+		std_d.erase(std_d.begin() + 4);
+		ft_d.resize(12, "z");
+		std_d.resize(12, "z");
+		CHECK("string ops", same(ft_d, std_d));
+
+		ft::deque<std::string> copy(ft_d);
+		CHECK("copy", copy == ft_d && !(copy < ft_d));
+		copy.push_back("zz");
+		CHECK("compare", copy != ft_d && ft_d < copy);
+		copy.swap(ft_d);
+		CHECK("swap", copy.size() + 1 == ft_d.size());
+	}
+	{
+		//	a single pass range : read once
+		ft::deque<int>		ft_d(5, 0);
+		std::deque<int>		std_d(5, 0);
+		std::istringstream	in("1 2 3 4 5 6 7");
+		std::istringstream	ref("1 2 3 4 5 6 7");
+		ft_d.insert(ft_d.begin() + 2, std::istream_iterator<int>(in), std::istream_iterator<int>());
+		std_d.insert(std_d.begin() + 2, std::istream_iterator<int>(ref), std::istream_iterator<int>());
+		CHECK("input iterator insert", same(ft_d, std_d));
+	}
+	{
+		ft::stack<int, ft::deque<int> > st;
+		for (int i = 0; i < 10000; i++) st.push(i);
+		int sum = 0;
+		while (!st.empty()) { sum += st.top(); st.pop(); }
+		CHECK("stack over deque", sum == 10000 * 9999 / 2);
+	}
+	return check::report();
+}
@@ -0,0 +1,52 @@
+#include "check.hpp"
+#include "../external_sort.hpp"
+#include "../map.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <vector>
+
+template<typename T, typename Comp>
+static bool sorts(const std::vector<T>& input, size_t memory, Comp comp, size_t runs) {
+	ft::external_sorter<T, Comp> s(memory, "/tmp", comp);
+	s.push(input.begin(), input.end());
+	std::vector<T> expect(input);
+	std::sort(expect.begin(), expect.end(), comp);
+
+	if (s.spilled_runs() != runs || s.size() != input.size()) return false;
+	typename ft::external_sorter<T, Comp>::iterator it = s.begin();
+	for (size_t i = 0; i < expect.size(); ++i, ++it)
+		if (it == s.end() || *it != expect[i]) return false;
+	return it == s.end();
+}
+
+int main() {
+	srand(38);
+	std::vector<int> v;
+	for (int i = 0; i < 100000; ++i) v.push_back(rand() % 5000 - 2500);
+
+	CHECK("empty", sorts(std::vector<int>(), 1024, std::less<int>(), 0));
+	CHECK("in memory", sorts(v, v.size() * sizeof(int), std::less<int>(), 0));
+	CHECK("one record per run", sorts(std::vector<int>(v.begin(), v.begin() + 100), 1, std::less<int>(), 99));
+	CHECK("a few runs", sorts(v, 30000 * sizeof(int), std::less<int>(), 3));
+	CHECK("descending", sorts(v, 7000 * sizeof(int), std::greater<int>(), 14));
+	//	more runs than min_block sized buffers : intermediate passes
+	//	(the run still in memory is spilled by begin())
+	CHECK("multi pass", sorts(v, 1000 * sizeof(int), std::less<int>(), 99));
+	{
+		std::vector<long> big;
+		for (int i = 0; i < 400000; ++i) big.push_back(long(rand()) * rand());
+		CHECK("multi pass, large", sorts(big, 1 << 18, std::less<long>(), 12));
+	}
+	{
+		ft::external_sorter<ft::pair<int, int> > s(4096);
+		for (int i = 0; i < 20000; ++i) s.push(ft::make_pair((i * 7919) % 20000, i));
+		ft::map<int, int> m;
+		m.assign_sorted(s.begin(), s.size());
+		CHECK("map build", m.size() == 20000 && m.begin()->first == 0 && m.rbegin()->first == 19999
+			&& m[7919] == 1);
+	}
+
+	return check::report();
+}
@@ -0,0 +1,73 @@
+//	g++ -std=c++14 frozen_map_test.cpp
+#include "check.hpp"
+#include "../frozen_map.hpp"
+#include <iostream>
+#include <string>
+
+constexpr auto	opcodes = ft::make_frozen_map<const char*, int, ft::cstr_less>({
+	{ "mov", 0x89 }, { "add", 0x01 }, { "sub", 0x29 }, { "jmp", 0xe9 },
+	{ "call", 0xe8 }, { "ret", 0xc3 }, { "nop", 0x90 }, { "push", 0x50 },
+});
+
+constexpr auto	statuses = ft::make_frozen_map<int, const char*>({
+	{ 404, "Not Found" }, { 200, "OK" }, { 500, "Internal Server Error" }, { 301, "Moved Permanently" },
+});
+
+constexpr auto	primes = ft::make_frozen_set<int>({ 13, 2, 7, 3, 11, 5 });
+
+//	all of it answered by the compiler
+static_assert(opcodes.size() == 8, "size");
+static_assert(opcodes.at("ret") == 0xc3, "at");
+static_assert(opcodes.count("hlt") == 0, "count");
+static_assert(statuses.begin()->first == 200, "sorted");
+static_assert(primes.contains(11) && !primes.contains(4), "set");
+static_assert(*primes.lower_bound(8) == 11, "lower_bound");
+
+//	a table computed at compile time : squares of 0 .. 99, scrambled
+constexpr ft::frozen_map<int, int, 100> squares() {
+	ft::pair<int, int>	raw[100] = {};
+	for (int i = 0; i < 100; ++i) {
+		const int	k = (i * 37) % 100;
+		raw[i] = ft::pair<int, int>(k, k * k);
+	}
+	return ft::frozen_map<int, int, 100>(raw);
+}
+constexpr ft::frozen_map<int, int, 100>	square_table = squares();
+static_assert(square_table.at(42) == 1764, "generated table");
+
+int main() {
+	CHECK("find", opcodes.find("call") != opcodes.end() && opcodes.find("call")->second == 0xe8);
+	CHECK("find miss", opcodes.find("hlt") == opcodes.end());
+	const std::string	name = "push";
+	CHECK("runtime key", opcodes.at(name.c_str()) == 0x50);
+
+	bool	caught = false;
+	try { opcodes.at("hlt"); } catch (const std::out_of_range&) { caught = true; }
+	CHECK("at throws", caught);
+
+	bool	sorted = true;
+	for (auto it = opcodes.begin(); it + 1 != opcodes.end(); ++it)
+		sorted = sorted && ft::cstr_less()(it->first, (it + 1)->first);
+	CHECK("sorted iteration", sorted);
+	CHECK("reverse iteration", opcodes.rbegin()->first == std::string("sub"));
+
+	CHECK("bounds", statuses.lower_bound(300)->first == 301 && statuses.upper_bound(301)->first == 404
+		&& statuses.upper_bound(500) == statuses.end());
+	ft::pair<ft::frozen_map<int, const char*, 4>::const_iterator, ft::frozen_map<int, const char*, 4>::const_iterator>	r
+		= statuses.equal_range(404);
+	CHECK("equal_range", r.second - r.first == 1 && r.first->second == std::string("Not Found"));
+
+	int		sum = 0;
+	for (int i = 0; i < 100; ++i) sum += square_table.at(i) == i * i;
+	CHECK("generated table", sum == 100);
+
+	caught = false;
+	try {
+		const ft::pair<int, int>	dup[] = { ft::pair<int, int>(1, 1), ft::pair<int, int>(2, 2), ft::pair<int, int>(1, 3) };
+		ft::make_frozen_map(dup);
+	}
+	catch (const std::invalid_argument&) { caught = true; }
+	CHECK("repeated key", caught);
+
+	return check::report();
+}
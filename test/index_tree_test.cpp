@@ -0,0 +1,110 @@
+#include "check.hpp"
+#include "../index_tree.hpp"
+#include "../map.hpp"
+#include "../set.hpp"
+#include <map>
+#include <string>
+#include <cstdlib>
+#include <iostream>
+
+template<typename Map, typename Ref>
+bool same(const Map& m, const Ref& ref) {
+	if (m.size() != ref.size()) return false;
+	typename Map::const_iterator it = m.begin();
+	for (typename Ref::const_iterator r = ref.begin(); r != ref.end(); ++r, ++it)
+		if (it == m.end() || !(it->first == r->first) || !(it->second == r->second)) return false;
+	if (it != m.end()) return false;
+	typename Ref::const_reverse_iterator r = ref.rbegin();
+	for (typename Map::const_reverse_iterator rit = m.rbegin(); rit != m.rend(); ++rit, ++r)
+		if (!(rit->first == r->first)) return false;
+	return true;
+}
+
+template<typename K>
+K make_key(int k);
+template<> int make_key<int>(int k) { return k; }
+template<> std::string make_key<std::string>(int k) { return std::string(20, char('a' + k % 26)) + std::to_string(k); }
+
+template<typename K>
+void random_ops(const char* name) {
+	typedef ft::map<K, int, std::less<K>, std::allocator<ft::pair<const K, int> >, ft::index_tree>	map_type;
+	map_type m;
+	std::map<K, int> ref;
+	bool ok = true;
+	for (int round = 0; round < 30000 && ok; round++) {
+		const K k = make_key<K>(rand() % 1500);
+		switch (rand() % 5) {
+			case 0: case 1:
+				m.insert(ft::make_pair(k, round));
+				ref.insert(std::make_pair(k, round));
+				break;
+			case 2:
+				m[k] = round;
+				ref[k] = round;
+				break;
+			case 3:
+				ok = m.erase(k) == ref.erase(k);
+				break;
+			default: {
+				typename map_type::iterator it = m.lower_bound(k);
+				typename std::map<K, int>::iterator r = ref.lower_bound(k);
+				for (int i = 0; i < 5 && r != ref.end(); ++i, ++it, ++r)
+					ok = ok && it->first == r->first;
+				ok = ok && (m.find(k) == m.end()) == (ref.find(k) == ref.end());
+			}
+		}
+		if (round % 1000 == 0) ok = ok && same(m, ref);
+	}
+	CHECK(std::string(name) + " random ops", ok && same(m, ref));
+
+	map_type copy(m);
+	CHECK(std::string(name) + " copy", same(copy, ref) && copy == m);
+	map_type other;
+	other[make_key<K>(-1)] = 1;
+	other.swap(copy);
+	CHECK(std::string(name) + " swap", same(other, ref) && copy.size() == 1);
+	copy = other;
+	CHECK(std::string(name) + " assign", same(copy, ref));
+
+	m.erase(m.lower_bound(make_key<K>(300)), m.lower_bound(make_key<K>(900)));
+	ref.erase(ref.lower_bound(make_key<K>(300)), ref.lower_bound(make_key<K>(900)));
+	CHECK(std::string(name) + " erase range", same(m, ref));
+	m.clear();
+	ref.clear();
+	m[make_key<K>(4)] = 4;
+	ref[make_key<K>(4)] = 4;
+	CHECK(std::string(name) + " clear", same(m, ref) && copy.size() == other.size());
+}
+
+int main() {
+	srand(35);
+	random_ops<int>("int");
+	random_ops<std::string>("string");
+	{
+		typedef ft::IndexRbTree<int, int, ft::Identity<int>, std::less<int> >	tree_type;
+		tree_type t;
+		for (int i = 0; i < 1000; ++i) t.insert_unique(i);
+		const size_t slots = t.pool_size();
+		for (int i = 0; i < 1000; i += 2) t.erase(i);
+		for (int i = 0; i < 1000; i += 2) t.insert_unique(i + 1000);
+		CHECK("free list reuse", t.pool_size() == slots && t.size() == 1000);
+		int expect = 1;
+		bool ok = true;
+		for (tree_type::const_iterator it = t.begin(); it != t.end(); ++it) {
+			ok = ok && *it == expect;
+			expect += expect == 999 ? 1 : 2;
+		}
+		CHECK("order after reuse", ok);
+	}
+	{
+		ft::set<int, ft::less<int>, std::allocator<int>, ft::index_tree> s;
+		for (int i = 0; i < 1000; ++i) s.insert((i * 7919) % 1000);
+		ft::set<int, ft::less<int>, std::allocator<int>, ft::index_tree>::iterator it = s.begin();
+		s.insert(5000);		//	iterators survive pool growth
+		int expect = 0;
+		bool ok = true;
+		for (; it != s.end() && expect < 1000; ++it) ok = ok && *it == expect++;
+		CHECK("set iterators across growth", ok && *it == 5000 && s.count(5000) == 1);
+	}
+	return check::report();
+}
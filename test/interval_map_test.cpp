@@ -0,0 +1,115 @@
+//	build with any mix of -DFT_RBTREE_THREADED / -DFT_RBTREE_COMPACT
+#include "check.hpp"
+#include "../interval_map.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <iterator>
+#include <vector>
+
+typedef ft::interval_map<int, int>	imap;
+
+struct entry
+{
+	int	lo, hi, v;
+	bool operator<(const entry& rhs) const { return lo < rhs.lo || (lo == rhs.lo && hi < rhs.hi); }
+};
+
+//	expected matches, in start / end order
+static std::vector<int> scan(const std::vector<entry>& all, int lo, int hi, bool point) {
+	std::vector<entry> hit;
+	for (size_t i = 0; i < all.size(); ++i)
+		if (point ? all[i].lo <= lo && lo < all[i].hi : lo < hi && all[i].lo < hi && lo < all[i].hi && all[i].lo < all[i].hi)
+			hit.push_back(all[i]);
+	std::stable_sort(hit.begin(), hit.end());
+	std::vector<int> out;
+	for (size_t i = 0; i < hit.size(); ++i) out.push_back(hit[i].lo * 100000 + hit[i].hi);
+	return out;
+}
+
+static std::vector<int> found(const std::vector<imap::iterator>& its) {
+	std::vector<int> out;
+	for (size_t i = 0; i < its.size(); ++i) out.push_back(its[i]->first.lo * 100000 + its[i]->first.hi);
+	return out;
+}
+
+static void random_ops() {
+	imap				m;
+	std::vector<entry>	all;
+	bool				ok = true;
+
+	for (int i = 0; i < 60000; ++i) {
+		const int lo = rand() % 5000;
+		const int hi = lo + rand() % (rand() % 8 ? 40 : 2000);
+		switch (rand() % 6) {
+			case 0:
+			case 1: {
+				entry e = { lo, hi, i };
+				all.push_back(e);
+				m.insert(lo, hi, i);
+				break;
+			}
+			case 2: {
+				if (all.empty()) break;
+				const size_t j = rand() % all.size();
+				const ft::interval<int> k(all[j].lo, all[j].hi);
+				size_t n = 0;
+				for (size_t a = 0; a < all.size(); ) {
+					if (all[a].lo == k.lo && all[a].hi == k.hi) {
+						all.erase(all.begin() + a);
+						++n;
+					}
+					else ++a;
+				}
+				ok = ok && m.erase(k) == n;
+				break;
+			}
+			case 3: {
+				std::vector<imap::iterator> its;
+				m.overlapping(lo, std::back_inserter(its));
+				ok = ok && found(its) == scan(all, lo, lo, true);
+				break;
+			}
+			default: {
+				std::vector<imap::iterator> its;
+				m.overlapping(lo, hi, std::back_inserter(its));
+				ok = ok && found(its) == scan(all, lo, hi, false);
+			}
+		}
+	}
+	CHECK("random operations", ok && m.size() == all.size());
+
+	const imap	copy(m);
+	std::vector<imap::const_iterator> its;
+	copy.overlapping(0, 10000, std::back_inserter(its));
+	CHECK("copy", its.size() == all.size() - std::count_if(all.begin(), all.end(), [](const entry& e) { return e.hi <= e.lo; }));
+}
+
+static void bulk() {
+	std::vector<ft::pair<const ft::interval<int>, int> >	sorted;
+	for (int i = 0; i < 100000; ++i)
+		sorted.push_back(ft::make_pair(ft::interval<int>(i, i + 10), i));
+
+	imap	m;
+	m.assign_sorted(sorted.begin(), sorted.size());
+	std::vector<imap::iterator> its;
+	m.overlapping(500, std::back_inserter(its));
+	CHECK("assign_sorted point", its.size() == 10 && its.front()->first.lo == 491 && its.back()->first.lo == 500);
+	its.clear();
+	m.overlapping(1000, 1005, std::back_inserter(its));
+	CHECK("assign_sorted range", its.size() == 14);
+	m.insert(0, 1000000, -1);
+	its.clear();
+	m.overlapping(500000, std::back_inserter(its));
+	CHECK("insert after assign_sorted", its.size() == 1 && its[0]->second == -1);
+	its.clear();
+	m.overlapping(7, 7, std::back_inserter(its));
+	CHECK("empty query", its.empty());
+}
+
+int main() {
+	srand(7);
+	random_ops();
+	bulk();
+	return check::report();
+}
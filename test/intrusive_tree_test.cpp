@@ -0,0 +1,91 @@
+//	build with any mix of -DFT_RBTREE_THREADED / -DFT_RBTREE_COMPACT
+#include "check.hpp"
+#include "../intrusive_tree.hpp"
+#include <cstdlib>
+#include <iostream>
+#include <set>
+#include <vector>
+
+//	indexed twice : by id, and by priority with repeats
+struct job
+{
+	int			id;
+	int			priority;
+	bool		linked;
+	ft::tree_node	by_id;
+	ft::tree_node	by_priority;
+};
+
+struct id_of { const int& operator()(const job& j) const { return j.id; } };
+struct priority_of { const int& operator()(const job& j) const { return j.priority; } };
+
+typedef ft::intrusive_tree<job, int, id_of, &job::by_id>									id_index;
+typedef ft::intrusive_tree<job, int, priority_of, &job::by_priority, std::greater<int> >	priority_index;
+
+static void random_ops() {
+	std::vector<job>		slab(2000);
+	id_index				ids;
+	priority_index			prio;
+	std::set<int>			ref_ids;
+	std::multiset<int, std::greater<int> >	ref_prio;
+	bool					ok = true;
+
+	for (size_t i = 0; i < slab.size(); ++i) {
+		slab[i].id = int(i);
+		slab[i].linked = false;
+	}
+	for (int i = 0; i < 200000; ++i) {
+		job&	j = slab[rand() % slab.size()];
+		switch (rand() % 4) {
+			case 0:
+			case 1:
+				if (!j.linked) {
+					j.priority = rand() % 50;
+					ok = ok && ids.insert(j).second && &*ids.find(j.id) == &j;
+					prio.insert_equal(j);
+					ref_ids.insert(j.id);
+					ref_prio.insert(j.priority);
+					j.linked = true;
+				}
+				else ok = ok && !ids.insert(j).second;
+				break;
+			case 2:
+				if (j.linked) {
+					ids.erase(j);
+					prio.erase(j);
+					ref_ids.erase(j.id);
+					ref_prio.erase(ref_prio.find(j.priority));
+					j.linked = false;
+				}
+				ok = ok && ids.find(j.id) == ids.end();
+				break;
+			default: {
+				const int p = rand() % 50;
+				ok = ok && prio.count(p) == ref_prio.count(p);
+				priority_index::iterator lb = prio.lower_bound(p);
+				ok = ok && (lb == prio.end() ? ref_prio.lower_bound(p) == ref_prio.end()
+					: lb->priority == *ref_prio.lower_bound(p));
+			}
+		}
+	}
+	CHECK("random operations", ok && ids.size() == ref_ids.size() && prio.size() == ref_prio.size());
+
+	std::set<int>::const_iterator	r = ref_ids.begin();
+	for (id_index::iterator it = ids.begin(); it != ids.end() && ok; ++it, ++r) ok = it->id == *r;
+	CHECK("in order", ok && r == ref_ids.end());
+	std::multiset<int, std::greater<int> >::const_reverse_iterator	rp = ref_prio.rbegin();
+	for (priority_index::reverse_iterator it = prio.rbegin(); it != prio.rend() && ok; ++it, ++rp) ok = it->priority == *rp;
+	CHECK("reverse order", ok);
+
+	const size_t	n = ids.size();
+	id_index		other;
+	other.swap(ids);
+	CHECK("swap", ids.empty() && other.size() == n && (n == 0 || other.begin()->id == *ref_ids.begin()));
+	CHECK("erase by key", other.erase(*ref_ids.begin()) == 1 && other.size() == n - 1);
+}
+
+int main() {
+	srand(5);
+	random_ops();
+	return check::report();
+}
@@ -0,0 +1,122 @@
+//	build with any mix of -DFT_RBTREE_THREADED / -DFT_RBTREE_COMPACT
+#include "check.hpp"
+#include "../lru_cache.hpp"
+#include <cstdlib>
+#include <iostream>
+#include <list>
+#include <map>
+#include <string>
+#include <vector>
+
+//	reference : map of values plus a list of keys, most recent first
+struct reference
+{
+	size_t					cap;
+	std::list<int>			order;
+	std::map<int, int>		values;
+	std::vector<int>		evicted;
+
+	void touch(int k) {
+		order.remove(k);
+		order.push_front(k);
+	}
+	const int* get(int k) {
+		if (!values.count(k)) return 0;
+		touch(k);
+		return &values[k];
+	}
+	bool put(int k, int v) {
+		const bool fresh = !values.count(k);
+		values[k] = v;
+		touch(k);
+		if (values.size() > cap) {
+			evicted.push_back(order.back());
+			values.erase(order.back());
+			order.pop_back();
+		}
+		return fresh;
+	}
+	bool erase(int k) {
+		order.remove(k);
+		return values.erase(k) != 0;
+	}
+};
+
+template<typename Cache>
+static void random_ops(const char* name) {
+	std::vector<int>	evicted;
+	Cache				c(100, [&evicted](const int& k, int&) { evicted.push_back(k); });
+	reference			ref;
+	bool				ok = true;
+
+	ref.cap = 100;
+	for (int i = 0; i < 100000; ++i) {
+		const int k = rand() % 300;
+		switch (rand() % 6) {
+			case 0:
+			case 1:
+			case 2:
+				ok = ok && c.put(k, i) == ref.put(k, i);
+				break;
+			case 3:
+				ok = ok && c.erase(k) == ref.erase(k);
+				break;
+			case 4: {
+				const int* p = c.peek(k);
+				ok = ok && (p == 0) == (ref.values.count(k) == 0) && (!p || *p == ref.values[k]);
+				ok = ok && c.contains(k) == (p != 0);
+				break;
+			}
+			default: {
+				const int* a = c.get(k);
+				const int* b = ref.get(k);
+				ok = ok && (a == 0) == (b == 0) && (!a || *a == *b);
+			}
+		}
+	}
+	CHECK(name, ok && c.size() == ref.values.size() && c.size() <= c.capacity());
+	CHECK(name, evicted == ref.evicted);
+	c.clear();
+	CHECK(name, c.empty() && c.get(1) == 0 && c.put(1, 1));
+}
+
+static void recency_order() {
+	ft::lru_cache<std::string, int>	c(3);
+	c.put("a", 1);
+	c.put("b", 2);
+	c.put("c", 3);
+	c.get("a");				//	b is now the oldest
+	c.peek("b");			//	and stays so
+	c.put("d", 4);
+	CHECK("evicts the least recent", !c.contains("b") && c.contains("a") && c.contains("c") && c.contains("d"));
+	c.put("c", 30);			//	overwrite : no eviction
+	CHECK("overwrite", c.size() == 3 && *c.peek("c") == 30);
+
+	ft::lru_cache<int, int>	one(1);
+	one.put(1, 1);
+	one.put(2, 2);
+	CHECK("capacity one", one.size() == 1 && one.contains(2));
+}
+
+static void ordered_walk() {
+	ft::ordered_lru_cache<int, int>	c(5);
+	for (int i = 10; i > 0; --i) c.put(i, i * i);
+	int	expect = 1, n = 0;
+	bool ok = true;
+	for (ft::ordered_lru_cache<int, int>::const_iterator it = c.begin(); it != c.end(); ++it, ++expect, ++n)
+		ok = ok && it->first == expect && it->second == expect * expect;
+	CHECK("key order", ok && n == 5);
+	CHECK("bounds", c.lower_bound(3)->first == 3 && c.upper_bound(3)->first == 4 && c.lower_bound(6) == c.end());
+}
+
+int main() {
+	srand(3);
+	random_ops<ft::lru_cache<int, int> >("lru_cache");
+	random_ops<ft::ordered_lru_cache<int, int> >("ordered_lru_cache");
+	recency_order();
+	ordered_walk();
+	bool	caught = false;
+	try { ft::lru_cache<int, int> c(0); } catch (const std::invalid_argument&) { caught = true; }
+	CHECK("zero capacity", caught);
+	return check::report();
+}
@@ -0,0 +1,159 @@
+#include "check.hpp"
+#include "../mapped_map.hpp"
+#include "../map.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+
+static const char* path = "/tmp/ft_mapped_map_test.bin";
+
+template<typename M>
+static bool same(const M& m, const ft::map<int, long>& ref) {
+	if (m.size() != ref.size()) return false;
+	typename M::const_iterator it = m.begin();
+	for (ft::map<int, long>::const_iterator r = ref.begin(); r != ref.end(); ++r, ++it)
+		if (it == m.end() || it->first != r->first || it->second != r->second) return false;
+	return it == m.end();
+}
+
+//	the superblock state word : 0 clean, 1 dirty
+static unsigned state() {
+	unsigned	st = 0;
+	std::FILE*	f = std::fopen(path, "rb");
+	std::fseek(f, 12, SEEK_SET);
+	if (std::fread(&st, sizeof(st), 1, f) != 1) st = ~0u;
+	std::fclose(f);
+	return st;
+}
+
+static long file_size() {
+	std::FILE*	f = std::fopen(path, "rb");
+	std::fseek(f, 0, SEEK_END);
+	const long	bytes = std::ftell(f);
+	std::fclose(f);
+	return bytes;
+}
+
+template<typename F>
+static bool throws(F f) {
+	try {
+		f();
+	}
+	catch (const std::runtime_error&) {
+		return true;
+	}
+	return false;
+}
+
+int main() {
+	srand(37);
+	std::remove(path);
+	ft::map<int, long> ref;
+	{
+		ft::mapped_map<int, long> m(path);
+		CHECK("new file is empty", m.empty() && m.begin() == m.end());
+		for (int i = 0; i < 200000; ++i) {
+			const int k = rand() % 100000;
+			const bool fresh = ref.insert(ft::make_pair(k, long(i))).second;
+			CHECK("insert reports new keys", m.insert(ft::make_pair(k, long(i))).second == fresh);
+		}
+		for (int i = 0; i < 30000; ++i) {
+			const int k = rand() % 100000;
+			CHECK("erase by key", m.erase(k) == ref.erase(k));
+		}
+		m[-5] = 55;
+		ref[-5] = 55;
+		CHECK("contents", same(m, ref));
+	}
+	{
+		ft::mapped_map<int, long> m(path);
+		CHECK("reopen", same(m, ref));
+		CHECK("find", m.find(-5) != m.end() && m.find(-5)->second == 55 && m.find(-6) == m.end());
+		CHECK("lower_bound", m.lower_bound(-4)->first == ref.lower_bound(-4)->first);
+		CHECK("upper_bound", m.upper_bound(-5)->first == ref.upper_bound(-5)->first);
+		CHECK("reverse", m.rbegin()->first == ref.rbegin()->first);
+
+		//	freed nodes are reused before the file grows
+		for (int i = 0; i < 1000; ++i) {
+			ref.erase(m.begin()->first);
+			m.erase(m.begin());
+		}
+		for (int i = 0; i < 1000; ++i) {
+			m[200000 + i] = i;
+			ref[200000 + i] = i;
+		}
+		CHECK("reuse", same(m, ref));
+		m.sync();
+		CHECK("synced file is clean", state() == 0);
+
+		//	writes to existing entries mark the file as well
+		const ft::mapped_map<int, long>&	cm = m;
+		CHECK("const reads keep it clean", cm.find(200001)->second == 1 && cm.begin() != cm.end() && state() == 0);
+		m[200001] = 56;
+		ref[200001] = 56;
+		CHECK("operator[] on an existing key", state() == 1);
+		m.sync();
+		m.find(200001)->second = 57;
+		ref[200001] = 57;
+		CHECK("write through an iterator", state() == 1);
+		m.sync();
+	}
+	{
+		ft::mapped_map<int, long> m(path);
+		CHECK("reopen after sync", same(m, ref));
+		m.clear();
+		ref.clear();
+		for (int i = 0; i < 1000; ++i) m[i] = i;
+		CHECK("clear", m.size() == 1000 && m.begin()->first == 0 && (--m.end())->first == 999);
+	}
+	CHECK("type mismatch", throws([] { ft::mapped_map<long, long> m(path); }));
+	{
+		//	a writer that dies between two sync points leaves a file that is refused
+		std::FILE* f = std::fopen(path, "r+b");
+		std::fseek(f, 12, SEEK_SET);
+		const unsigned dirty = 1;
+		std::fwrite(&dirty, sizeof(dirty), 1, f);
+		std::fclose(f);
+		CHECK("unclean file", throws([] { ft::mapped_map<int, long> m(path); }));
+	}
+	std::remove(path);
+	CHECK("not a mapped_map", throws([] {
+		std::FILE* f = std::fopen(path, "wb");
+		std::fputs("hello, world", f);
+		std::fclose(f);
+		ft::mapped_map<int, long> m(path);
+	}));
+	std::remove(path);
+	{
+		//	a window that is not a power of two of the first extent is used up to its last node
+		const size_t max_bytes = 3 << 20;
+		size_t inserted = 0;
+		bool full = false;
+		{
+			ft::mapped_map<int, long> m(path, max_bytes);
+			try {
+				for (int k = 0; ; ++k, ++inserted) m.insert(ft::make_pair(k, long(k)));
+			}
+			catch (const std::length_error&) { full = true; }
+			CHECK("fills the whole window", full && file_size() == long(max_bytes) && m.size() == inserted);
+		}
+		ft::mapped_map<int, long> m(path, max_bytes);
+		CHECK("full file reopens", m.size() == inserted && (--m.end())->first == int(inserted) - 1);
+	}
+	std::remove(path);
+	{
+		ft::mapped_map<int, long> m(path, 64 << 10);
+		for (int k = 0; k < 100; ++k) m[k] = k;
+		CHECK("window under the first extent", m.size() == 100 && file_size() == 64 << 10);
+	}
+	std::remove(path);
+	bool refused = false;
+	try {
+		ft::mapped_map<int, long> m(path, 16);
+	}
+	catch (const std::length_error&) { refused = true; }
+	CHECK("window too small", refused && std::fopen(path, "rb") == 0);
+
+	return check::report();
+}
@@ -0,0 +1,120 @@
+#include "check.hpp"
+#include "../memory_resource.hpp"
+#include <iostream>
+#include <string>
+
+//	counts what goes through it, to see who allocated and that all of it came back
+struct counting_resource : public ft::pmr::memory_resource
+{
+	size_t	allocs;
+	size_t	live;
+	size_t	bytes;
+
+	counting_resource() : allocs(0), live(0), bytes(0) {}
+
+private:
+	void* do_allocate(size_t n, size_t align) {
+		++allocs;
+		++live;
+		bytes += n;
+		return ft::pmr::new_delete_resource()->allocate(n, align);
+	}
+	void do_deallocate(void* p, size_t n, size_t align) {
+		--live;
+		bytes -= n;
+		ft::pmr::new_delete_resource()->deallocate(p, n, align);
+	}
+};
+
+static bool aligned(void* p, size_t align) { return reinterpret_cast<uintptr_t>(p) % align == 0; }
+
+int main() {
+	{
+		counting_resource	up;
+		char				buf[256];
+		ft::pmr::monotonic_buffer_resource	arena(buf, sizeof(buf), &up);
+
+		void* const	a = arena.allocate(100, 8);
+		void* const	b = arena.allocate(1, 1);
+		void* const	c = arena.allocate(8, 8);
+		CHECK("monotonic initial buffer", up.allocs == 0 && a == buf && b == buf + 100 && c == buf + 104);
+		arena.allocate(1000, 64);
+		arena.allocate(64, 256);
+		CHECK("monotonic upstream", up.allocs >= 1 && up.live == up.allocs);
+		CHECK("monotonic alignment", aligned(arena.allocate(3, 128), 128) && aligned(arena.allocate(5, 8), 8));
+		arena.release();
+		CHECK("monotonic release", up.live == 0 && arena.allocate(16, 8) == buf);
+	}
+	{
+		counting_resource	up;
+		{
+			ft::pmr::unsynchronized_pool_resource	pool(ft::pmr::pool_options(64, 512), &up);
+			void* const	a = pool.allocate(24, 8);
+			pool.deallocate(a, 24, 8);
+			CHECK("pool reuse", pool.allocate(24, 8) == a);
+			void* const	big = pool.allocate(100000, 64);
+			CHECK("pool oversized", aligned(big, 64) && up.bytes >= 100000);
+			pool.deallocate(big, 100000, 64);
+			CHECK("pool oversized free", up.bytes < 100000);
+			CHECK("pool alignment", aligned(pool.allocate(40, 64), 64) && aligned(pool.allocate(8, 8), 8));
+			for (int i = 0; i < 10000; ++i) pool.allocate(size_t(i % 600) + 1, 8);
+			pool.release();
+			CHECK("pool release", up.live == 0);
+			pool.allocate(1000000, 8);
+		}
+		CHECK("pool destructor", up.live == 0);
+	}
+	{
+		counting_resource	up;
+		ft::pmr::monotonic_buffer_resource	arena(&up);
+		{
+			ft::pmr::vector<int>	v(&arena);
+			for (int i = 0; i < 1000; ++i) v.push_back(i);
+			CHECK("vector from arena", up.allocs > 0 && v.get_allocator().resource() == &arena && v[999] == 999);
+
+			ft::pmr::map<int, std::string>	m(&arena);
+			const size_t	before = up.bytes;
+			for (int i = 0; i < 1000; ++i) m[i] = "x";
+			CHECK("map nodes from arena", up.bytes > before && m.get_allocator().resource() == &arena);
+			ft::pmr::map<int, std::string>	copy(m);
+			CHECK("copy shares resource", copy.get_allocator().resource() == &arena && copy.size() == 1000);
+
+			ft::pmr::set<int>	s(&arena);
+			for (int i = 0; i < 100; ++i) s.insert(i);
+			CHECK("set from arena", s.size() == 100 && s.get_allocator().resource() == &arena);
+
+			ft::pmr::stack<int>	st((ft::pmr::vector<int>(&arena)));
+			for (int i = 0; i < 100; ++i) st.push(i);
+			CHECK("stack", st.size() == 100 && st.top() == 99);
+		}
+		arena.release();
+		CHECK("arena frees the request", up.live == 0);
+	}
+	{
+		counting_resource	up;
+		ft::pmr::synchronized_pool_resource	pool(&up);
+		{
+			ft::pmr::map<int, int>	m(&pool);
+			for (int i = 0; i < 1000; ++i) m[i] = i;
+			for (int i = 0; i < 1000; i += 2) m.erase(i);
+			CHECK("map on pool", m.size() == 500 && m.begin()->first == 1);
+		}
+		pool.release();
+		CHECK("pool frees the request", up.live == 0);
+	}
+	{
+		counting_resource	up;
+		ft::pmr::memory_resource* const	old = ft::pmr::set_default_resource(&up);
+		ft::pmr::vector<int>	v;
+		v.push_back(1);
+		CHECK("default resource", up.allocs == 1 && v.get_allocator().resource() == &up);
+		ft::pmr::set_default_resource(old);
+		CHECK("restore default", ft::pmr::get_default_resource() == ft::pmr::new_delete_resource());
+
+		ft::pmr::polymorphic_allocator<int>		a(&up);
+		ft::pmr::polymorphic_allocator<double>	b(a);
+		CHECK("allocator equality", a == b && a != ft::pmr::polymorphic_allocator<int>());
+	}
+
+	return check::report();
+}
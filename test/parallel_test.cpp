@@ -0,0 +1,99 @@
+#include "check.hpp"
+#include "../execution.hpp"
+#include "../vector.hpp"
+#include "../pair.hpp"
+#include <algorithm>
+#include <numeric>
+#include <vector>
+#include <cstdlib>
+#include <iostream>
+
+typedef ft::pair<int, ft::pair<int, int> >	conn;
+
+struct by_first
+{
+	bool operator()(const conn& lhs, const conn& rhs) const { return lhs.first < rhs.first; }
+};
+
+void check_sort(ft::thread_pool& pool, size_t n) {
+	ft::vector<int> v;
+	for (size_t i = 0; i < n; i++) v.push_back(rand() % 1000);
+	std::vector<int> ref(v.begin(), v.end());
+	std::sort(ref.begin(), ref.end());
+
+	ft::vector<int> a = v;
+	ft::sort(a.begin(), a.end());
+	CHECK("seq sort int", std::equal(ref.begin(), ref.end(), a.begin()));
+	a = v;
+	ft::sort(ft::execution::par.on(pool), a.begin(), a.end());
+	CHECK("par sort int", std::equal(ref.begin(), ref.end(), a.begin()));
+	a = v;
+	ft::sort(ft::execution::par.on(pool), a.begin(), a.end(), ft::greater<int>());
+	CHECK("par sort greater", std::equal(ref.rbegin(), ref.rend(), a.begin()));
+
+	ft::vector<conn> c;
+	for (size_t i = 0; i < n; i++) c.push_back(conn(rand() % 100, ft::make_pair(int(i), rand())));
+	std::vector<conn> cref(c.begin(), c.end());
+	std::sort(cref.begin(), cref.end());
+	ft::vector<conn> s = c;
+	ft::sort(ft::execution::par.on(pool), s.begin(), s.end());
+	CHECK("par sort conn", std::equal(cref.begin(), cref.end(), s.begin()));
+
+	std::vector<conn> sref(c.begin(), c.end());
+	std::stable_sort(sref.begin(), sref.end(), by_first());
+	s = c;
+	ft::stable_sort(s.begin(), s.end(), by_first());
+	CHECK("seq stable_sort conn", std::equal(sref.begin(), sref.end(), s.begin()));
+	s = c;
+	ft::stable_sort(ft::execution::par.on(pool), s.begin(), s.end(), by_first());
+	CHECK("par stable_sort conn", std::equal(sref.begin(), sref.end(), s.begin()));
+}
+
+struct twice
+{
+	int operator()(int x) const { return x * 2; }
+};
+
+struct increment
+{
+	void operator()(int& x) const { ++x; }
+};
+
+void check_others(ft::thread_pool& pool, size_t n) {
+	ft::vector<int> v(n);
+	for (size_t i = 0; i < n; i++) v[i] = int(i % 97);
+	std::vector<int> ref(v.begin(), v.end());
+
+	ft::for_each(ft::execution::par.on(pool), v.begin(), v.end(), increment());
+	std::for_each(ref.begin(), ref.end(), increment());
+	CHECK("par for_each", std::equal(ref.begin(), ref.end(), v.begin()));
+
+	ft::vector<int> out(n);
+	std::vector<int> ref_out(n);
+	ft::transform(ft::execution::par.on(pool), v.begin(), v.end(), out.begin(), twice());
+	std::transform(ref.begin(), ref.end(), ref_out.begin(), twice());
+	CHECK("par transform", std::equal(ref_out.begin(), ref_out.end(), out.begin()));
+
+	long long sum = std::accumulate(ref.begin(), ref.end(), 0LL);
+	CHECK("par reduce", ft::reduce(ft::execution::par.on(pool), v.begin(), v.end(), 0LL) == sum);
+	CHECK("seq reduce", ft::reduce(ft::execution::seq, v.begin(), v.end(), 0LL) == sum);
+}
+
+int main() {
+	srand(7);
+	const size_t sizes[] = { 0, 1, 17, 1000, 100000, 1000003 };
+	for (unsigned threads = 1; threads <= 4; threads++) {
+		ft::thread_pool pool(threads);
+		for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+			check_sort(pool, sizes[i]);
+			check_others(pool, sizes[i]);
+		}
+	}
+	{
+		ft::vector<int> v(1000);
+		for (size_t i = 0; i < v.size(); i++) v[i] = rand();
+		ft::sort(ft::execution::seq, v.begin(), v.end());
+		CHECK("seq policy sort", std::is_sorted(v.begin(), v.end()));
+	}
+	return check::report();
+}
@@ -0,0 +1,85 @@
+//	build with any mix of -DFT_RBTREE_THREADED / -DFT_RBTREE_COMPACT
+#include "check.hpp"
+#include "../map.hpp"
+#include "../set.hpp"
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+typedef std::allocator<ft::pair<const std::string, int> >	alloc_type;
+
+static const char alphabet[] = { 'a', 'b', '\0', '\x80', '\xff' };
+
+//	random lengths around the 8 cached bytes, sharing long prefixes
+static std::string make_key() {
+	std::string s(rand() % 2 ? "prefix__" : "");
+	for (int n = rand() % 12; n; --n) s += alphabet[rand() % sizeof(alphabet)];
+	return s;
+}
+
+template<typename Comp>
+static void compare_maps(const char* name) {
+	ft::map<std::string, int, Comp, alloc_type, ft::prefix_tree> cached;
+	ft::map<std::string, int, Comp> plain;
+	bool ok = true;
+
+	for (int i = 0; i < 100000; ++i) {
+		const std::string k = make_key();
+		switch (rand() % 4) {
+			case 0:
+			case 1:
+				ok = ok && cached.insert(ft::make_pair(k, i)).second == plain.insert(ft::make_pair(k, i)).second;
+				break;
+			case 2:
+				ok = ok && cached.erase(k) == plain.erase(k);
+				break;
+			default: {
+				const bool end_l = plain.lower_bound(k) == plain.end();
+				ok = ok && (end_l ? cached.lower_bound(k) == cached.end()
+					: cached.lower_bound(k)->first == plain.lower_bound(k)->first);
+				const bool end_u = plain.upper_bound(k) == plain.end();
+				ok = ok && (end_u ? cached.upper_bound(k) == cached.end()
+					: cached.upper_bound(k)->first == plain.upper_bound(k)->first);
+				ok = ok && (cached.find(k) == cached.end()) == (plain.find(k) == plain.end());
+			}
+		}
+	}
+	CHECK(name, ok && cached.size() == plain.size());
+	ft::map<std::string, int>::size_type n = 0;
+	typename ft::map<std::string, int, Comp>::iterator j = plain.begin();
+	for (typename ft::map<std::string, int, Comp, alloc_type, ft::prefix_tree>::iterator it = cached.begin();
+			it != cached.end(); ++it, ++j, ++n)
+		ok = ok && it->first == j->first && it->second == j->second;
+	CHECK(name, ok && n == plain.size());
+
+	std::vector<std::string> keys;
+	for (int i = 0; i < 500; ++i) keys.push_back(make_key());
+	std::vector<typename ft::map<std::string, int, Comp, alloc_type, ft::prefix_tree>::iterator> found(keys.size());
+	cached.find_batch(keys.begin(), keys.end(), found.begin());
+	for (size_t i = 0; i < keys.size(); ++i) ok = ok && found[i] == cached.find(keys[i]);
+	CHECK(name, ok);
+
+	ft::map<std::string, int, Comp, alloc_type, ft::prefix_tree> copy(cached);
+	CHECK(name, copy == cached);
+}
+
+int main() {
+	srand(41);
+	compare_maps<std::less<std::string> >("std::less");
+	compare_maps<ft::less<std::string> >("ft::less");
+	//	not byte ordered : prefix_tree falls back to the plain node
+	compare_maps<std::greater<std::string> >("std::greater");
+	{
+		ft::set<std::string, std::less<std::string>, std::allocator<std::string>, ft::prefix_tree> s;
+		s.insert("b");
+		s.insert(std::string("a\0", 2));
+		s.insert("a");
+		s.insert("");
+		ft::set<std::string, std::less<std::string>, std::allocator<std::string>, ft::prefix_tree>::iterator it = s.begin();
+		CHECK("set order", *it++ == "" && *it++ == "a" && *it++ == std::string("a\0", 2) && *it++ == "b");
+	}
+
+	return check::report();
+}
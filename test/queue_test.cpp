@@ -0,0 +1,71 @@
+#include "check.hpp"
+#include "../queue.hpp"
+#include <queue>
+#include <vector>
+#include <cstdlib>
+#include <iostream>
+
+template<typename PQ, typename Ref>
+void check_heap(const char* name) {
+	PQ pq;
+	Ref ref;
+	bool ok = true;
+	for (int round = 0; round < 20000; round++) {
+		const int v = rand() % 1000;
+		switch (rand() % 4) {
+			case 0: case 1: pq.push(v); ref.push(v); break;
+			case 2: if (!ref.empty()) { pq.pop(); ref.pop(); } break;
+			case 3: if (!ref.empty()) { pq.pop_push(v); ref.pop(); ref.push(v); } break;
+		}
+		if (pq.size() != ref.size() || (!ref.empty() && pq.top() != ref.top())) ok = false;
+	}
+	std::vector<int> batch;
+	for (int i = 0; i < 5000; i++) batch.push_back(rand());
+	pq.push_range(batch.begin(), batch.end());
+	for (size_t i = 0; i < batch.size(); i++) ref.push(batch[i]);
+	while (!ref.empty()) {
+		if (pq.empty() || pq.top() != ref.top()) { ok = false; break; }
+		pq.pop();
+		ref.pop();
+	}
+	CHECK(name, ok && pq.empty());
+}
+
+int main() {
+	srand(5);
+	check_heap<ft::priority_queue<int>, std::priority_queue<int> >("4-ary max");
+	check_heap<ft::priority_queue<int, ft::vector<int>, ft::less<int>, 2>, std::priority_queue<int> >("binary max");
+	check_heap<ft::priority_queue<int, ft::vector<int>, ft::greater<int>, 8>,
+		std::priority_queue<int, std::vector<int>, std::greater<int> > >("8-ary min");
+	{
+		std::vector<int> v;
+		for (int i = 0; i < 100; i++) v.push_back(i * 37 % 101);
+		ft::priority_queue<int> pq(v.begin(), v.end());
+		int prev = pq.top();
+		bool sorted = true;
+		for (pq.pop(); !pq.empty(); pq.pop()) {
+			if (pq.top() > prev) sorted = false;
+			prev = pq.top();
+		}
+		CHECK("range ctor", sorted);
+	}
+	{
+		ft::priority_queue<int> pq;
+		for (int i = 0; i < 1000; i++) pq.push(i);
+		const std::size_t	buffer = reinterpret_cast<std::size_t>(&pq.top()) - 3 * sizeof(int);
+		CHECK("line aligned buffer", buffer % 64 == 0);
+	}
+	{
+		ft::queue<int> q;
+		std::queue<int> ref;
+		for (int i = 0; i < 10000; i++) {
+			if (rand() % 3 && !ref.empty()) { q.pop(); ref.pop(); }
+			else { q.push(i); ref.push(i); }
+			if (q.size() != ref.size() || (!ref.empty() && (q.front() != ref.front() || q.back() != ref.back())))
+				CHECK("queue", false);
+		}
+		ft::queue<int> copy(q);
+		CHECK("queue compare", copy == q && !(copy < q));
+	}
+	return check::report();
+}
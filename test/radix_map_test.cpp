@@ -0,0 +1,114 @@
+#include "check.hpp"
+#include "../radix_map.hpp"
+#include "../map.hpp"
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+template<typename R, typename M>
+static bool same(const R& r, const M& m) {
+	if (r.size() != m.size()) return false;
+	typename R::const_iterator it = r.begin();
+	for (typename M::const_iterator j = m.begin(); j != m.end(); ++j, ++it)
+		if (it == r.end() || it->first != j->first || it->second != j->second) return false;
+	if (it != r.end()) return false;
+	//	and backwards through the leaf list
+	typename R::const_reverse_iterator rit = r.rbegin();
+	for (typename M::const_reverse_iterator j = m.rbegin(); j != m.rend(); ++j, ++rit)
+		if (rit->first != j->first) return false;
+	return true;
+}
+
+template<typename R, typename M, typename Gen>
+static void stress(const char* name, Gen gen, int rounds) {
+	R r;
+	M m;
+	bool ok = true;
+	for (int i = 0; i < rounds; ++i) {
+		const typename M::key_type k = gen();
+		switch (rand() % 4) {
+			case 0:
+			case 1:
+				ok = ok && r.insert(ft::make_pair(k, i)).second == m.insert(ft::make_pair(k, i)).second;
+				break;
+			case 2:
+				ok = ok && r.erase(k) == m.erase(k);
+				break;
+			default: {
+				typename R::iterator lr = r.lower_bound(k);
+				typename M::iterator lm = m.lower_bound(k);
+				ok = ok && (lm == m.end() ? lr == r.end() : lr != r.end() && lr->first == lm->first);
+				typename R::iterator ur = r.upper_bound(k);
+				typename M::iterator um = m.upper_bound(k);
+				ok = ok && (um == m.end() ? ur == r.end() : ur != r.end() && ur->first == um->first);
+				ok = ok && (r.find(k) == r.end()) == (m.find(k) == m.end());
+			}
+		}
+		if (i % 997 == 0) ok = ok && same(r, m);
+	}
+	CHECK(name, ok && same(r, m));
+
+	R copy(r);
+	CHECK(name, same(copy, m));
+	R other;
+	other.swap(copy);
+	CHECK(name, copy.empty() && copy.begin() == copy.end() && same(other, m));
+	while (!m.empty()) {
+		const typename M::key_type k = m.begin()->first;
+		m.erase(k);
+		r.erase(r.begin());
+	}
+	CHECK(name, r.empty() && r.begin() == r.end());
+}
+
+static const char alphabet[] = { 'a', 'b', 'c', '\0', '\xff', 'z' };
+
+//	short keys over a small alphabet : many shared prefixes, keys prefix of others
+static std::string short_string() {
+	std::string s;
+	for (int n = rand() % 5; n; --n) s += alphabet[rand() % sizeof(alphabet)];
+	return s;
+}
+
+//	long shared prefixes, past what a node stores
+static std::string long_string() {
+	std::string s(rand() % 3 ? "http://example.com/very/long/common/path/" : "http://example.com/other/");
+	for (int n = rand() % 4; n; --n) s += alphabet[rand() % sizeof(alphabet)];
+	if (rand() % 3 == 0) s += std::string(20, 'q');
+	return s;
+}
+
+static long small_int() { return rand() % 2000 - 1000; }
+static long wide_int() { return long(rand()) * rand() * (rand() % 2 ? 1 : -1); }
+static unsigned dense_uint() { return unsigned(rand() % 70000); }
+
+int main() {
+	srand(40);
+	stress<ft::radix_map<std::string, int>, ft::map<std::string, int> >("short strings", short_string, 200000);
+	stress<ft::radix_map<std::string, int>, ft::map<std::string, int> >("long strings", long_string, 100000);
+	stress<ft::radix_map<long, int>, ft::map<long, int> >("small ints", small_int, 200000);
+	stress<ft::radix_map<long, int>, ft::map<long, int> >("wide ints", wide_int, 200000);
+	stress<ft::radix_map<unsigned, int>, ft::map<unsigned, int> >("dense unsigned", dense_uint, 300000);
+	{
+		ft::radix_map<std::string, int> r;
+		r["b"] = 2;
+		r[""] = 1;
+		r["ab"] = 3;
+		CHECK("operator[]", r.size() == 3 && r.begin()->first.empty() && r.at("ab") == 3);
+		bool thrown = false;
+		try {
+			r.at("c");
+		}
+		catch (const std::out_of_range&) {
+			thrown = true;
+		}
+		CHECK("at", thrown);
+		ft::radix_map<std::string, int> a(r);
+		CHECK("==", a == r && !(a != r));
+		a.clear();
+		a = r;
+		CHECK("=", a == r);
+	}
+
+	return check::report();
+}
@@ -0,0 +1,91 @@
+#include "check.hpp"
+#include "../radix_sort.hpp"
+#include "../vector.hpp"
+#include "../pair.hpp"
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <iostream>
+
+typedef ft::pair<int, ft::pair<int, int> >	conn;
+
+struct by_first
+{
+	bool operator()(const conn& lhs, const conn& rhs) const { return lhs.first < rhs.first; }
+};
+
+struct by_second_second
+{
+	int operator()(const conn& x) const { return x.second.second; }
+};
+
+struct counting_allocator : public std::allocator<conn>
+{
+	template<typename U> struct rebind { typedef counting_allocator other; };
+	static int calls;
+
+	conn* allocate(size_t n) { ++calls; return std::allocator<conn>::allocate(n); }
+};
+int counting_allocator::calls = 0;
+
+template<typename T>
+void check_integral(const char* name, size_t n, long long lo, long long span) {
+	ft::vector<T> v;
+	for (size_t i = 0; i < n; i++) v.push_back(T(lo + (long long)(((unsigned long long)rand() << 31 | rand()) % span)));
+	std::vector<T> ref(v.begin(), v.end());
+	std::sort(ref.begin(), ref.end());
+	ft::radix_sort(v);
+	CHECK(name, std::equal(ref.begin(), ref.end(), v.begin()));
+}
+
+int main() {
+	srand(3);
+	const size_t sizes[] = { 0, 1, 2, 100, 255, 256, 1000, 100000 };
+	for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+		const size_t n = sizes[s];
+		check_integral<int>("int", n, -1000000, 2000000);
+		check_integral<int>("int narrow", n, 5, 3);
+		check_integral<unsigned int>("unsigned", n, 0, 4000000000LL);
+		check_integral<char>("char", n, -128, 256);
+		check_integral<short>("short", n, -30000, 60000);
+		check_integral<long long>("long long", n, -(1LL << 60), 1LL << 61);
+		check_integral<unsigned long>("unsigned long", n, 0, 1LL << 62);
+
+		ft::vector<conn> c;
+		for (size_t i = 0; i < n; i++) c.push_back(conn(rand() % 1000 - 500, ft::make_pair(int(i), rand() % 100)));
+		std::vector<conn> ref(c.begin(), c.end());
+		std::stable_sort(ref.begin(), ref.end(), by_first());
+		ft::vector<conn> r = c;
+		ft::radix_sort(r);
+		CHECK("conn stable by first", std::equal(ref.begin(), ref.end(), r.begin()));
+
+		ref.assign(c.begin(), c.end());
+		std::stable_sort(ref.begin(), ref.end(), [](const conn& a, const conn& b) { return a.second.second < b.second.second; });
+		r = c;
+		ft::radix_sort(r, by_second_second());
+		CHECK("conn key extractor", std::equal(ref.begin(), ref.end(), r.begin()));
+	}
+	{
+		ft::vector<conn> c;
+		for (int i = 0; i < 5000; i++) c.push_back(conn(rand(), ft::make_pair(i, i)));
+		ft::radix_sort(c.begin(), c.end(), ft::radix_key<conn>(), counting_allocator());
+		CHECK("allocator hook", counting_allocator::calls == 1);
+	}
+	{
+		ft::vector<std::string>	s;
+		for (int i = 0; i < 1000; i++) s.push_back(std::to_string(rand() % 500));
+		std::vector<std::string>	ref(s.begin(), s.end());
+		std::stable_sort(ref.begin(), ref.end());
+		ft::radix_sort(s);
+		CHECK("string keys fall back", std::equal(ref.begin(), ref.end(), s.begin()));
+
+		ft::vector<double>	d;
+		for (int i = 0; i < 1000; i++) d.push_back(rand() / 7.0);
+		std::vector<double>	dref(d.begin(), d.end());
+		std::sort(dref.begin(), dref.end());
+		ft::radix_sort(d);
+		CHECK("floating keys fall back", std::equal(dref.begin(), dref.end(), d.begin()));
+	}
+	return check::report();
+}
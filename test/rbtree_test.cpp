@@ -0,0 +1,142 @@
+//	build with any mix of -DFT_RBTREE_THREADED and -DFT_RBTREE_COMPACT
+#include "check.hpp"
+#include "../map.hpp"
+#include "../set.hpp"
+#include <map>
+#include <vector>
+#include <cstdlib>
+#include <iostream>
+
+typedef ft::tree_node_traits	traits;
+
+//	black height of the subtree, -1 on a broken invariant
+static int black_height(const ft::tree_node* x, const ft::tree_node* parent) {
+	if (x == 0) return 1;
+	if (traits::get_parent(x) != parent) return -1;
+	const ft::tree_node* l = traits::get_left(x);
+	const ft::tree_node* r = traits::get_right(x);
+	if (traits::get_color(x) == ft::RED
+		&& ((l && traits::get_color(l) == ft::RED) || (r && traits::get_color(r) == ft::RED)))
+		return -1;
+	const int lh = black_height(l, x);
+	const int rh = black_height(r, x);
+	if (lh < 0 || lh != rh) return -1;
+	return lh + (traits::get_color(x) == ft::BLACK);
+}
+
+template<typename Map>
+bool valid(const Map& m) {
+	const ft::tree_node* header = m.end().node;
+	const ft::tree_node* root = traits::get_parent(header);
+	if (root == 0) return m.begin() == m.end();
+	return traits::get_color(root) == ft::BLACK && black_height(root, header) > 0;
+}
+
+template<typename Map, typename Ref>
+bool same(const Map& m, const Ref& ref) {
+	if (m.size() != ref.size()) return false;
+	typename Map::const_iterator it = m.begin();
+	for (typename Ref::const_iterator r = ref.begin(); r != ref.end(); ++r, ++it)
+		if (it == m.end() || it->first != r->first || it->second != r->second) return false;
+	if (it != m.end()) return false;
+	typename Ref::const_reverse_iterator r = ref.rbegin();
+	for (typename Map::const_reverse_iterator rit = m.rbegin(); rit != m.rend(); ++rit, ++r)
+		if (rit->first != r->first) return false;
+	return valid(m);
+}
+
+int main() {
+	srand(33);
+	{
+		ft::map<int, int> m;
+		std::map<int, int> ref;
+		bool ok = true;
+		for (int round = 0; round < 40000 && ok; round++) {
+			const int k = rand() % 2000;
+			switch (rand() % 6) {
+				case 0: case 1: case 2:
+					m.insert(ft::make_pair(k, round));
+					ref.insert(std::make_pair(k, round));
+					break;
+				case 3:
+					m.erase(k);
+					ref.erase(k);
+					break;
+				case 4: {
+					ft::map<int, int>::iterator it = m.lower_bound(k);
+					std::map<int, int>::iterator r = ref.lower_bound(k);
+					for (int i = 0; i < 8 && r != ref.end(); ++i, ++it, ++r)
+						ok = ok && it->first == r->first;
+					break;
+				}
+				default:
+					if (!ref.empty()) {
+						ft::map<int, int>::iterator it = m.upper_bound(k);
+						std::map<int, int>::iterator r = ref.upper_bound(k);
+						if (r != ref.begin()) {
+							--it; --r;
+							ok = ok && it->first == r->first;
+						}
+					}
+			}
+			if (round % 1000 == 0) ok = ok && same(m, ref);
+		}
+		CHECK("random insert / erase / scans", ok && same(m, ref));
+
+		ft::map<int, int> copy(m);
+		CHECK("copy", same(copy, ref));
+		ft::map<int, int> other;
+		other[-1] = 1;
+		other.swap(copy);
+		CHECK("swap", same(other, ref) && copy.size() == 1 && copy.begin()->first == -1
+			&& (--copy.end())->first == -1 && valid(copy));
+		copy = other;
+		CHECK("assign", same(copy, ref));
+
+		ft::map<int, int>::iterator first = m.lower_bound(500), last = m.lower_bound(1500);
+		m.erase(first, last);
+		ref.erase(ref.lower_bound(500), ref.lower_bound(1500));
+		CHECK("erase range", same(m, ref));
+
+		while (!ref.empty()) {
+			m.erase(m.begin());
+			ref.erase(ref.begin());
+			if (!ref.empty()) {
+				m.erase(--m.end());
+				ref.erase(--ref.end());
+			}
+		}
+		CHECK("erase extremes", same(m, ref) && m.empty());
+		m[3] = 3;
+		CHECK("reuse after empty", m.size() == 1 && ++m.begin() == m.end() && --m.end() == m.begin());
+	}
+	{
+		bool ok = true;
+		std::vector<ft::pair<int, int> > sorted;
+		for (int n = 0; n < 300 && ok; ++n) {
+			ft::map<int, int> m;
+			std::map<int, int> ref;
+			m[-5] = 0;
+			m.assign_sorted(sorted.begin(), sorted.size());
+			for (size_t i = 0; i < sorted.size(); ++i) ref[sorted[i].first] = sorted[i].second;
+			ok = same(m, ref);
+			m.insert(ft::make_pair(n * 3 + 1, 0));
+			ref.insert(std::make_pair(n * 3 + 1, 0));
+			m.erase(0);
+			ref.erase(0);
+			ok = ok && same(m, ref);
+			sorted.push_back(ft::make_pair(n * 3, n));
+		}
+		CHECK("assign_sorted", ok);
+	}
+	{
+		ft::set<int> s;
+		for (int i = 0; i < 1000; ++i) s.insert((i * 7919) % 1000);
+		int expect = 0;
+		bool ok = true;
+		for (ft::set<int>::iterator it = s.begin(); it != s.end(); ++it) ok = ok && *it == expect++;
+		for (ft::set<int>::iterator it = s.end(); it != s.begin(); ) ok = ok && *--it == --expect;
+		CHECK("set order", ok && expect == 0);
+	}
+	return check::report();
+}
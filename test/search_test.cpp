@@ -0,0 +1,68 @@
+#include "check.hpp"
+#include "../vector.hpp"
+#include <algorithm>
+#include <numeric>
+#include <vector>
+#include <list>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+template<typename T>
+void check_range(const ft::vector<T>& v, T probe, const char* name) {
+	std::vector<T> ref(v.begin(), v.end());
+
+	CHECK(name, (ft::find(v.begin(), v.end(), probe) - v.begin())
+		== (std::find(ref.begin(), ref.end(), probe) - ref.begin()));
+	CHECK(name, ft::count(v.begin(), v.end(), probe) == std::count(ref.begin(), ref.end(), probe));
+	CHECK(name, (ft::min_element(v.begin(), v.end()) - v.begin())
+		== (std::min_element(ref.begin(), ref.end()) - ref.begin()));
+	CHECK(name, (ft::max_element(v.begin(), v.end()) - v.begin())
+		== (std::max_element(ref.begin(), ref.end()) - ref.begin()));
+}
+
+int main() {
+	srand(42);
+	for (size_t n = 0; n < 200; n++) {
+		ft::vector<int> vi;
+		ft::vector<float> vf;
+		for (size_t i = 0; i < n; i++) {
+			vi.push_back(rand() % 50 - 25);
+			vf.push_back(float(rand() % 50) / 4.0f - 6.0f);
+		}
+		check_range(vi, 7, "int");
+		check_range(vi, 1000, "int missing");
+		check_range(vf, 0.25f, "float");
+		check_range(vf, 1000.0f, "float missing");
+
+		std::vector<int> ri(vi.begin(), vi.end());
+		CHECK("int accumulate", ft::accumulate(vi.begin(), vi.end(), 3) == std::accumulate(ri.begin(), ri.end(), 3));
+		std::vector<float> rf(vf.begin(), vf.end());
+		CHECK("float accumulate", std::fabs(ft::accumulate(vf.begin(), vf.end(), 0.5f)
+			- std::accumulate(rf.begin(), rf.end(), 0.5f)) < 1e-3f);
+	}
+	{
+		ft::vector<float> vf;
+		vf.push_back(NAN);
+		for (int i = 0; i < 20; i++) vf.push_back(float(i % 7));
+		vf[9] = NAN;
+		check_range(vf, NAN, "float nan first");
+		vf[0] = 3.0f;
+		check_range(vf, 3.0f, "float nan middle");
+	}
+	{
+		std::list<int> l;
+		for (int i = 0; i < 100; i++) l.push_back(i * 7 % 13);
+		CHECK("list find", *ft::find(l.begin(), l.end(), 5) == 5);
+		CHECK("list count", ft::count(l.begin(), l.end(), 5) == std::count(l.begin(), l.end(), 5));
+		CHECK("list min", *ft::min_element(l.begin(), l.end()) == 0);
+		CHECK("list max", *ft::max_element(l.begin(), l.end()) == 12);
+		CHECK("list accumulate", ft::accumulate(l.begin(), l.end(), 0) == std::accumulate(l.begin(), l.end(), 0));
+	}
+	{
+		ft::vector<int> vi(1000, 1);
+		CHECK("widening accumulate", ft::accumulate(vi.begin(), vi.end(), 0LL) == 1000LL);
+		CHECK("long find", ft::find(vi.begin(), vi.end(), 1L) == vi.begin());
+	}
+	return check::report();
+}
@@ -0,0 +1,86 @@
+#include "check.hpp"
+#include "../snapshot.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+
+template<typename F>
+bool throws(F f) {
+	try {
+		f();
+	}
+	catch (const std::runtime_error&) {
+		return true;
+	}
+	return false;
+}
+
+static const char* path = "/tmp/ft_snapshot_test.bin";
+
+static void flip_byte(long offset) {
+	std::FILE* f = std::fopen(path, "r+b");
+	std::fseek(f, offset, SEEK_SET);
+	const int c = std::fgetc(f);
+	std::fseek(f, offset, SEEK_SET);
+	std::fputc(c ^ 0x40, f);
+	std::fclose(f);
+}
+
+int main() {
+	srand(36);
+	{
+		ft::vector<long> v, back;
+		for (int i = 0; i < 300000; ++i) v.push_back(rand());
+		ft::save(path, v);
+		back.push_back(1);
+		ft::load(path, back);
+		CHECK("vector round trip", back == v);
+
+		ft::vector<long> empty;
+		ft::save(path, empty);
+		ft::load(path, back);
+		CHECK("empty vector", back.empty());
+	}
+	{
+		ft::map<int, double> m, back;
+		for (int i = 0; i < 200000; ++i) m[rand()] = i * 0.5;
+		ft::save(path, m);
+		back[-1] = 1;
+		ft::load(path, back);
+		CHECK("map round trip", back == m);
+		std::FILE* f = std::fopen(path, "rb");
+		std::fseek(f, 0, SEEK_END);
+		const long bytes = std::ftell(f);
+		std::fclose(f);
+		CHECK("map entries without padding", bytes == long(sizeof(ft::snapshot::header) + m.size() * (sizeof(int) + sizeof(double))));
+		back[-1] = 2;
+		back.erase(back.begin());
+		CHECK("map usable after load", back.size() == m.size() && back.find(-1) == back.end());
+
+		flip_byte(sizeof(ft::snapshot::header) + 12345);
+		CHECK("corrupted map", throws([&] { ft::load(path, back); }) && back.empty());
+
+		ft::set<int> wrong;
+		CHECK("kind mismatch", throws([&] { ft::load(path, wrong); }));
+		ft::map<long, double> wrong_type;
+		CHECK("type mismatch", throws([&] { ft::load(path, wrong_type); }));
+	}
+	{
+		ft::set<unsigned> s, back;
+		for (unsigned i = 0; i < 100000; ++i) s.insert(i * 2654435761u);
+		ft::save(path, s);
+		ft::load(path, back);
+		CHECK("set round trip", back == s);
+	}
+	{
+		std::FILE* f = std::fopen(path, "wb");
+		std::fputs("not a snapshot at all, just text long enough for a header", f);
+		std::fclose(f);
+		ft::vector<int> v;
+		CHECK("foreign file", throws([&] { ft::load(path, v); }));
+		CHECK("missing file", throws([&] { ft::load("/nonexistent/dir/file", v); }));
+	}
+	std::remove(path);
+	return check::report();
+}
@@ -0,0 +1,134 @@
+#include "check.hpp"
+#include "../thread_cache_allocator.hpp"
+#include "../map.hpp"
+#include "../set.hpp"
+#include <iostream>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <stdint.h>
+
+typedef ft::map<int, std::string, std::less<int>, ft::thread_cache_allocator<ft::pair<const int, std::string> > >	cached_map;
+typedef ft::set<int, ft::less<int>, ft::thread_cache_allocator<int> >	cached_set;
+
+//	a block size no other test uses, so its cache starts empty
+struct probe
+{
+	char	bytes[40];
+};
+
+static unsigned long long xorshift(unsigned long long& x) {
+	x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+	return x;
+}
+
+//	insert / erase churn against std::set, true when they always agree
+static bool churn(unsigned long long seed, int rounds) {
+	cached_set		s;
+	std::set<int>	ref;
+
+	for (int i = 0; i < rounds; ++i) {
+		const int	k = int(xorshift(seed) % 2000);
+		if (xorshift(seed) % 3) {
+			s.insert(k);
+			ref.insert(k);
+		}
+		else {
+			s.erase(k);
+			ref.erase(k);
+		}
+	}
+	if (s.size() != ref.size()) return false;
+	std::set<int>::const_iterator	r = ref.begin();
+	for (cached_set::const_iterator it = s.begin(); it != s.end(); ++it, ++r)
+		if (*it != *r) return false;
+	return true;
+}
+
+struct alignas(256) line { char bytes[256]; };
+
+int main() {
+	{
+		ft::thread_cache_allocator<int>	a;
+		int* const	p = a.allocate(1);
+		a.deallocate(p, 1);
+		CHECK("reuse", a.allocate(1) == p);
+		int* const	arr = a.allocate(100);
+		arr[99] = 1;
+		a.deallocate(arr, 100);
+		CHECK("equality", a == ft::thread_cache_allocator<double>());
+
+		bool refused = false;
+		try { a.allocate(a.max_size() + 1); } catch (const std::bad_alloc&) { refused = true; }
+		CHECK("past max_size", refused);
+	}
+	{
+		ft::thread_cache_allocator<line>	a;
+		line* const	one = a.allocate(1);
+		line* const	arr = a.allocate(7);
+		CHECK("over aligned", reinterpret_cast<uintptr_t>(one) % alignof(line) == 0 && reinterpret_cast<uintptr_t>(arr) % alignof(line) == 0);
+		a.deallocate(one, 1);
+		a.deallocate(arr, 7);
+	}
+	{
+		cached_map	m;
+		for (int i = 0; i < 10000; ++i) m[i] = std::string(20, char('a' + i % 26));
+		for (int i = 0; i < 10000; i += 2) m.erase(i);
+		CHECK("map", m.size() == 5000 && m[1] == std::string(20, 'b'));
+		cached_map	copy(m);
+		CHECK("copy", copy.size() == 5000 && copy.begin()->first == 1);
+	}
+	CHECK("single thread churn", churn(88172645463325252ULL, 100000));
+	{
+		std::vector<std::thread>	threads;
+		bool						ok[8];
+		for (int t = 0; t < 8; ++t)
+			threads.push_back(std::thread([t, &ok] { ok[t] = churn(2463534242ULL + t, 50000); }));
+		for (size_t t = 0; t < threads.size(); ++t) threads[t].join();
+		bool	all = true;
+		for (int t = 0; t < 8; ++t) all = all && ok[t];
+		CHECK("threads churn", all);
+	}
+	{
+		//	built on one thread, freed on another
+		std::vector<cached_map*>	maps;
+		std::thread	producer([&maps] {
+			for (int i = 0; i < 16; ++i) {
+				cached_map* const	m = new cached_map;
+				for (int k = 0; k < 1000; ++k) (*m)[k] = "v";
+				maps.push_back(m);
+			}
+		});
+		producer.join();
+		bool	ok = true;
+		std::thread	consumer([&maps, &ok] {
+			for (size_t i = 0; i < maps.size(); ++i) {
+				ok = ok && maps[i]->size() == 1000;
+				delete maps[i];
+			}
+		});
+		consumer.join();
+		CHECK("cross thread free", ok);
+		cached_map	m;
+		for (int k = 0; k < 16000; ++k) m[k] = "w";
+		CHECK("reuse after cross thread free", m.size() == 16000 && m[15999] == "w");
+	}
+	{
+		//	a thread that only frees still hands its blocks back when it exits
+		ft::thread_cache_allocator<probe>	a;
+		std::vector<probe*>				blocks;
+		for (int i = 0; i < 100; ++i) blocks.push_back(a.allocate(1));
+		std::thread	freer([&blocks, a]() mutable {
+			for (size_t i = 0; i < blocks.size(); ++i) a.deallocate(blocks[i], 1);
+		});
+		freer.join();
+		std::set<probe*>	freed(blocks.begin(), blocks.end());
+		size_t				back = 0;
+		for (int i = 0; i < 300; ++i) back += freed.count(a.allocate(1));
+		CHECK("free only thread", back == 100);
+	}
+
+	return check::report();
+}
@@ -0,0 +1,137 @@
+#include "check.hpp"
+#include "../vector.hpp"
+#include <iostream>
+#include <vector>
+
+static unsigned long long xorshift(unsigned long long& x) {
+	x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+	return x;
+}
+
+static bool same(const ft::vector<bool>& v, const std::vector<bool>& ref) {
+	if (v.size() != ref.size()) return false;
+	for (size_t i = 0; i < ref.size(); ++i) if (v[i] != ref[i]) return false;
+	//	the bits past size() stay clear
+	return v.word_count() == 0 || (v.size() % 64 == 0) || (v.words()[v.word_count() - 1] >> v.size() % 64) == 0;
+}
+
+int main() {
+	unsigned long long	x = 88172645463325252ULL;
+	ft::vector<bool>	v;
+	std::vector<bool>	ref;
+
+	for (int i = 0; i < 1000; ++i) {
+		const bool	b = xorshift(x) % 3 == 0;
+		v.push_back(b);
+		ref.push_back(b);
+	}
+	CHECK("push_back", same(v, ref));
+	CHECK("packed", v.capacity() >= 1000 && v.word_count() == 16);
+
+	v[3] = true;
+	ref[3] = true;
+	v[4] = v[3];
+	ref[4] = ref[3];
+	v[5].flip();
+	ref[5].flip();
+	ft::vector<bool>::swap(v[6], v[7]);
+	std::vector<bool>::swap(ref[6], ref[7]);
+	CHECK("proxies", same(v, ref));
+
+	size_t	n = 0;
+	for (size_t i = 0; i < ref.size(); ++i) n += ref[i];
+	CHECK("count", v.count() == n);
+	n = 0;
+	for (size_t i = 70; i < 900; ++i) n += ref[i];
+	CHECK("count range", v.count(70, 900) == n && v.count(5, 5) == 0);
+
+	{
+		std::vector<size_t>	set;
+		for (size_t i = 0; i < ref.size(); ++i) if (ref[i]) set.push_back(i);
+		std::vector<size_t>	found;
+		for (size_t i = v.find_first(); i != v.npos; i = v.find_next(i)) found.push_back(i);
+		CHECK("find_first / find_next", found == set);
+	}
+	{
+		ft::vector<bool>	sparse(100000);
+		CHECK("none", sparse.none() && sparse.find_first() == sparse.npos);
+		sparse[99999] = true;
+		sparse[64] = true;
+		CHECK("sparse find", sparse.find_first() == 64 && sparse.find_next(64) == 99999 && sparse.find_next(99999) == sparse.npos);
+	}
+
+	v.set(10, 200);
+	for (size_t i = 10; i < 200; ++i) ref[i] = true;
+	v.reset(300, 301);
+	ref[300] = false;
+	v.flip(63, 700);
+	for (size_t i = 63; i < 700; ++i) ref[i] = !ref[i];
+	CHECK("ranges", same(v, ref));
+	v.flip();
+	ref.flip();
+	CHECK("flip all keeps the tail clear", same(v, ref));
+	bool	caught = false;
+	try { v.set(5, 2000); } catch (const std::out_of_range&) { caught = true; }
+	CHECK("bad range", caught);
+
+	{
+		ft::vector<bool>	a(130), b(130);
+		std::vector<bool>	ra(130), rb(130);
+		for (size_t i = 0; i < 130; ++i) {
+			a[i] = ra[i] = xorshift(x) & 1;
+			b[i] = rb[i] = xorshift(x) & 1;
+		}
+		ft::vector<bool>	c = a & b;
+		ft::vector<bool>	d = a | b;
+		ft::vector<bool>	e = a ^ b;
+		bool	ok = true;
+		for (size_t i = 0; i < 130; ++i)
+			ok = ok && c[i] == (ra[i] && rb[i]) && d[i] == (ra[i] || rb[i]) && e[i] == (ra[i] != rb[i]);
+		CHECK("and / or / xor", ok);
+		caught = false;
+		try { a &= ft::vector<bool>(3); } catch (const std::invalid_argument&) { caught = true; }
+		CHECK("size mismatch", caught);
+	}
+
+	v.insert(v.begin() + 5, 3, true);
+	ref.insert(ref.begin() + 5, 3, true);
+	v.insert(v.begin() + 70, false);
+	ref.insert(ref.begin() + 70, false);
+	v.erase(v.begin() + 100, v.begin() + 300);
+	ref.erase(ref.begin() + 100, ref.begin() + 300);
+	v.erase(v.begin());
+	ref.erase(ref.begin());
+	bool	arr[] = { true, false, true };
+	v.insert(v.begin() + 2, arr, arr + 3);
+	ref.insert(ref.begin() + 2, arr, arr + 3);
+	CHECK("insert / erase", same(v, ref));
+
+	v.resize(2000, true);
+	ref.resize(2000, true);
+	v.resize(777);
+	ref.resize(777);
+	v.pop_back();
+	ref.pop_back();
+	CHECK("resize / pop_back", same(v, ref));
+	v.resize(900);
+	ref.resize(900);
+	CHECK("regrow after shrink is clear", same(v, ref));
+
+	{
+		ft::vector<bool>	copy(v);
+		CHECK("copy", copy == v && !(copy != v));
+		copy[0] = !copy[0];
+		CHECK("compare", copy != v && (copy < v) != (v < copy));
+		ft::vector<bool>	ranged(ref.begin(), ref.end());
+		CHECK("range ctor", ranged == v);
+		size_t	back = 0;
+		for (ft::vector<bool>::const_reverse_iterator it = v.rbegin(); it != v.rend(); ++it) back += *it;
+		CHECK("reverse iteration", back == v.count());
+		ft::vector<bool>::iterator	it = v.begin() + 500;
+		CHECK("iterator arithmetic", (it - 437) - v.begin() == 63 && v.end() - it == 400 && it[-1] == ref[499]);
+		ft::vector<bool>	empty1, empty2;
+		CHECK("empty", empty1 == empty2 && empty1.count() == 0 && empty1.find_first() == empty1.npos);
+	}
+
+	return check::report();
+}
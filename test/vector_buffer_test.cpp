@@ -0,0 +1,76 @@
+#include "check.hpp"
+#include "../vector.hpp"
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+
+//	counts live objects, to see shrinking destroy exactly what it drops
+struct counted
+{
+	static int	live;
+	int			v;
+
+	counted() : v(7) { ++live; }
+	counted(const counted& o) : v(o.v) { ++live; }
+	~counted() { --live; }
+	counted& operator=(const counted& o) { v = o.v; return *this; }
+};
+int counted::live = 0;
+
+//	a short read : fills at most 100 bytes per call
+struct short_read
+{
+	const char*	src;
+	size_t*		pos;
+	size_t		left;
+
+	size_t operator()(char* dst, size_t n) const {
+		if (n > 100) n = 100;
+		if (n > left - *pos) n = left - *pos;
+		std::memcpy(dst, src + *pos, n);
+		*pos += n;
+		return n;
+	}
+};
+
+struct throwing
+{
+	size_t operator()(counted*, size_t) const { throw std::runtime_error("read failed"); }
+};
+
+int main() {
+	ft::vector<char>	buf;
+	buf.resize_default_init(4096);
+	CHECK("grow", buf.size() == 4096 && buf.capacity() >= 4096);
+	std::memset(buf.data(), 'x', buf.size());
+	buf.resize_default_init(10);
+	CHECK("shrink", buf.size() == 10 && buf[9] == 'x');
+
+	char	src[1000];
+	for (int i = 0; i < 1000; ++i) src[i] = char(i);
+	size_t		pos = 0;
+	short_read	r = { src, &pos, sizeof(src) };
+	buf.clear();
+	while (buf.append_uninitialized(256, r) != 0) {}
+	CHECK("short reads", buf.size() == 1000 && std::memcmp(buf.data(), src, 1000) == 0);
+
+	{
+		ft::vector<counted>	v;
+		v.resize_default_init(5);
+		CHECK("non trivial constructed", counted::live == 5 && v[4].v == 7);
+		bool	caught = false;
+		try { v.append_uninitialized(10, throwing()); } catch (const std::runtime_error&) { caught = true; }
+		CHECK("filler throws", caught && v.size() == 5 && counted::live == 5);
+		v.resize_default_init(2);
+		CHECK("non trivial shrink", v.size() == 2 && counted::live == 2);
+		v.clear();
+		CHECK("clear", counted::live == 0);
+	}
+	{
+		ft::vector<counted>	v(6);
+		ft::vector<counted>	copy(v);
+	}
+	CHECK("destructor destroys the elements", counted::live == 0);
+
+	return check::report();
+}
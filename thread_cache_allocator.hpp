@@ -0,0 +1,214 @@
+#ifndef THREAD_CACHE_ALLOCATOR_HPP
+# define THREAD_CACHE_ALLOCATOR_HPP
+
+#include <cstddef>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+#include <utility>
+
+namespace ft
+{
+
+namespace detail
+{
+
+/*
+ *	Block Cache : fixed size blocks of Size bytes, one cache per thread.
+ *	A thread allocates from and frees to its own free list without locking.
+ *	Past two batches it hands a batch to the shared depot, and an empty
+ *	cache takes one back (or carves a fresh slab), so blocks freed by one
+ *	thread flow back to the threads that allocate. Any thread may free any
+ *	block. Slabs are never returned : the blocks are reused for good.
+ */
+template<std::size_t Size, std::size_t Align>
+class block_cache
+{
+	struct block
+	{
+		block*		next;
+		block*		batch;		//	next batch in the depot, batch heads only
+		std::size_t	count;		//	blocks in the batch, batch heads only
+	};
+
+	enum
+	{
+		batch_size = 64,
+		raw = Size > sizeof(block) ? Size : sizeof(block),
+		stride = (raw + Align - 1) / Align * Align
+	};
+
+	struct depot
+	{
+		std::mutex	lock;
+		block*		batches;
+		block*		slabs;		//	first block of every slab, only so they stay reachable
+
+		depot() : batches(0), slabs(0) {}
+	};
+
+	//	plain data, so reaching it costs no thread_local guard
+	struct cache
+	{
+		block*		head;
+		std::size_t	count;
+	};
+
+	//	set up the first time a thread's cache holds blocks, flushes it to the depot when the thread exits
+	struct flusher
+	{
+		~flusher() {
+			cache&	c = local;
+			while (c.count > std::size_t(batch_size)) give_batch(c, batch_size);
+			if (c.count) give_batch(c, c.count);
+		}
+	};
+
+	static thread_local cache	local;
+
+	//	never destroyed : thread caches may flush into it during exit
+	static depot& shared() {
+		static depot* const	d = new depot();
+		return *d;
+	}
+
+	//	the slow paths stay out of line, so the fast ones inline into the tree code
+	__attribute__((noinline)) static void give_batch(cache& c, std::size_t n) {
+		block* const	first = c.head;
+		block*			last = first;
+
+		for (std::size_t i = 1; i < n; ++i) last = last->next;
+		c.head = last->next;
+		c.count -= n;
+		last->next = 0;
+		first->count = n;
+
+		depot&	d = shared();
+		std::lock_guard<std::mutex>	guard(d.lock);
+		first->batch = d.batches;
+		d.batches = first;
+	}
+
+	__attribute__((noinline)) static void flush_at_exit() {
+		static thread_local flusher	at_exit;
+		(void)at_exit;
+	}
+
+	__attribute__((noinline)) static void refill(cache& c) {
+		depot&	d = shared();
+
+		flush_at_exit();
+		{
+			std::lock_guard<std::mutex>	guard(d.lock);
+			if (d.batches) {
+				block* const	b = d.batches;
+				d.batches = b->batch;
+				c.head = b;
+				c.count = b->count;
+				return ;
+			}
+		}
+		char* const		slab = static_cast<char*>(::operator new(stride * (batch_size + 1)));
+		{
+			std::lock_guard<std::mutex>	guard(d.lock);
+			reinterpret_cast<block*>(slab)->next = d.slabs;
+			d.slabs = reinterpret_cast<block*>(slab);
+		}
+		for (std::size_t k = batch_size; k; --k) {
+			block* const	b = reinterpret_cast<block*>(slab + k * stride);
+			b->next = c.head;
+			c.head = b;
+		}
+		c.count = batch_size;
+	}
+
+public:
+	static void* allocate() {
+		cache&	c = local;
+
+		if (c.head == 0) refill(c);
+		block* const	b = c.head;
+		c.head = b->next;
+		--c.count;
+		return b;
+	}
+
+	static void deallocate(void* p) {
+		cache&			c = local;
+		block* const	b = static_cast<block*>(p);
+
+		b->next = c.head;
+		c.head = b;
+		//	a thread that only frees never refills : its flusher is set up here
+		if (++c.count == 1) flush_at_exit();
+		else if (c.count >= 2 * batch_size) give_batch(c, batch_size);
+	}
+};
+
+template<std::size_t Size, std::size_t Align>
+thread_local typename block_cache<Size, Align>::cache	block_cache<Size, Align>::local = { 0, 0 };
+
+}	//	DETAIL
+
+/*
+ *	Thread Cache Allocator : single objects come from a per thread cache of
+ *	sizeof(T) blocks, arrays from operator new, over aligned types from posix_memalign.
+ *	Meant for node containers, as the Alloc of map or set : the tree rebinds it
+ *	to its node type, so every node of every tree of that type shares the cache,
+ *	and a tree may be destroyed on another thread than the one that built it.
+ *	Stateless : all instances are equal.
+ */
+template<typename T>
+class thread_cache_allocator
+{
+	enum { cached = alignof(T) <= alignof(std::max_align_t) };
+
+	typedef detail::block_cache<sizeof(T), alignof(T)>	cache;
+
+public:
+	typedef T					value_type;
+	typedef T*					pointer;
+	typedef const T*			const_pointer;
+	typedef T&					reference;
+	typedef const T&			const_reference;
+	typedef std::size_t			size_type;
+	typedef std::ptrdiff_t		difference_type;
+
+	template<typename U> struct rebind { typedef thread_cache_allocator<U> other; };
+
+	thread_cache_allocator() {}
+	template<typename U>
+	thread_cache_allocator(const thread_cache_allocator<U>&) {}
+
+	T* allocate(size_type n) {
+		if (n > max_size()) throw std::bad_alloc();
+		if (n == 1 && cached) return static_cast<T*>(cache::allocate());
+		if (cached) return static_cast<T*>(::operator new(n * sizeof(T)));
+
+		void*	p = 0;
+		if (::posix_memalign(&p, alignof(T), n * sizeof(T)) != 0) throw std::bad_alloc();
+		return static_cast<T*>(p);
+	}
+	void deallocate(T* p, size_type n) {
+		if (p == 0) return ;
+		if (n == 1 && cached) cache::deallocate(p);
+		else if (cached) ::operator delete(p);
+		else std::free(p);
+	}
+
+	template<typename U, typename... Args>
+	void construct(U* p, Args&&... args) { ::new(static_cast<void*>(p)) U(std::forward<Args>(args)...); }
+	template<typename U>
+	void destroy(U* p) { p->~U(); }
+
+	size_type max_size() const { return size_type(-1) / sizeof(T); }
+};
+
+template<typename T, typename U>
+bool operator==(const thread_cache_allocator<T>&, const thread_cache_allocator<U>&) { return true; }
+template<typename T, typename U>
+bool operator!=(const thread_cache_allocator<T>&, const thread_cache_allocator<U>&) { return false; }
+
+}	//	FT
+
+#endif
@@ -0,0 +1,186 @@
+#ifndef THREAD_POOL_HPP
+# define THREAD_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ft
+{
+
+/*
+ *	Work Stealing Pool
+ *	every worker owns a deque : it pushes and pops at the back (LIFO, cache warm),
+ *	idle workers steal from the front of the others (FIFO, biggest pieces first).
+ *	threads(n) spawns n - 1 workers, the thread waiting on a task_group is the n-th.
+ */
+class thread_pool
+{
+public:
+	typedef std::function<void()>	task;
+
+private:
+	struct queue
+	{
+		std::mutex			lock;
+		std::deque<task>	tasks;
+	};
+
+	unsigned					nthreads;
+	queue*						queues;		//	[0, nthreads - 1) workers, [nthreads - 1] callers
+	std::vector<std::thread>	workers;
+	std::atomic<bool>			stopping;
+	std::atomic<long>			queued;
+	std::mutex					idle_lock;
+	std::condition_variable		idle;
+
+	thread_pool(const thread_pool&);
+	thread_pool& operator=(const thread_pool&);
+
+	static thread_pool*& current_pool() {
+		static thread_local thread_pool* pool = 0;
+		return pool;
+	}
+	static unsigned& current_index() {
+		static thread_local unsigned index = 0;
+		return index;
+	}
+
+	unsigned own_queue() const {
+		return current_pool() == this ? current_index() : nthreads - 1;
+	}
+
+	bool pop(unsigned idx, task& out) {
+		std::lock_guard<std::mutex> guard(queues[idx].lock);
+		if (queues[idx].tasks.empty()) return false;
+		out.swap(queues[idx].tasks.back());
+		queues[idx].tasks.pop_back();
+		return true;
+	}
+
+	bool steal(unsigned idx, task& out) {
+		std::unique_lock<std::mutex> guard(queues[idx].lock, std::try_to_lock);
+		if (!guard.owns_lock() || queues[idx].tasks.empty()) return false;
+		out.swap(queues[idx].tasks.front());
+		queues[idx].tasks.pop_front();
+		return true;
+	}
+
+	bool take(unsigned self, task& out) {
+		if (pop(self, out)) return true;
+		for (unsigned i = 1; i < nthreads; ++i)
+			if (steal((self + i) % nthreads, out)) return true;
+		return false;
+	}
+
+	void work(unsigned idx) {
+		current_pool() = this;
+		current_index() = idx;
+		while (!stopping.load()) {
+			if (run_one()) continue;
+			std::unique_lock<std::mutex> guard(idle_lock);
+			idle.wait(guard, [this] { return stopping.load() || queued.load() > 0; });
+		}
+	}
+
+public:
+	explicit thread_pool(unsigned threads = std::thread::hardware_concurrency())
+	: nthreads(threads ? threads : 1), queues(new queue[nthreads]), workers(), stopping(false), queued(0)
+	{
+		workers.reserve(nthreads - 1);
+		for (unsigned i = 0; i + 1 < nthreads; ++i)
+			workers.push_back(std::thread(&thread_pool::work, this, i));
+	}
+
+	~thread_pool() {
+		{
+			std::lock_guard<std::mutex> guard(idle_lock);
+			stopping = true;
+		}
+		idle.notify_all();
+		for (std::size_t i = 0; i < workers.size(); ++i) workers[i].join();
+		delete[] queues;
+	}
+
+	unsigned size() const { return nthreads; }
+
+	void submit(const task& t) {
+		const unsigned idx = own_queue();
+		{
+			std::lock_guard<std::mutex> guard(queues[idx].lock);
+			queues[idx].tasks.push_back(t);
+		}
+		{
+			std::lock_guard<std::mutex> guard(idle_lock);
+			++queued;
+		}
+		idle.notify_one();
+	}
+
+	//	run a single pending task on the calling thread, false when nothing was found
+	bool run_one() {
+		task	t;
+		if (!take(own_queue(), t)) return false;
+		--queued;
+		t();
+		return true;
+	}
+
+	static thread_pool& instance() {
+		static thread_pool pool;
+		return pool;
+	}
+};
+
+/*
+ *	Task Group : fork / join on a pool.
+ *	wait() keeps executing queued tasks instead of blocking, so nested groups cannot starve the pool.
+ */
+class task_group
+{
+	thread_pool&			pool;
+	std::atomic<long>		pending;
+	std::mutex				error_lock;
+	std::exception_ptr		error;
+
+	task_group(const task_group&);
+	task_group& operator=(const task_group&);
+
+public:
+	explicit task_group(thread_pool& p) : pool(p), pending(0), error_lock(), error() {}
+	~task_group() { while (pending.load()) if (!pool.run_one()) std::this_thread::yield(); }
+
+	template<typename Func>
+	void run(Func f) {
+		++pending;
+		pool.submit([this, f] {
+			try {
+				f();
+			}
+			catch (...) {
+				std::lock_guard<std::mutex> guard(error_lock);
+				if (!error) error = std::current_exception();
+			}
+			--pending;
+		});
+	}
+
+	void wait() {
+		while (pending.load())
+			if (!pool.run_one()) std::this_thread::yield();
+		if (error) {
+			std::exception_ptr e = error;
+			error = std::exception_ptr();
+			std::rethrow_exception(e);
+		}
+	}
+};
+
+}	//	FT
+
+#endif
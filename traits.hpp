@@ -80,6 +80,37 @@ struct	enable_if<true, T> { typedef T	type; };
 template <typename T>
 struct is_pod : public ft::integral_constant<bool, __is_pod(T)> {};
 
+/*
+ *	is_bitwise_copyable : a byte copy is a valid copy and destruction does nothing.
+ *	pod, or an ft::pair of such (pair spells out its own copy constructor)
+ */
+template <typename T, typename U> struct pair;
+
+template <typename T>
+struct is_bitwise_copyable : public is_pod<T> {};
+
+template <typename T, typename U>
+struct is_bitwise_copyable<pair<T, U> >
+: public ft::integral_constant<bool, is_bitwise_copyable<T>::value && is_bitwise_copyable<U>::value> {};
+
+/*
+ *	is_same
+ */
+template <typename T, typename U>
+struct	is_same : public false_type {};
+
+template <typename T>
+struct	is_same<T, T> : public true_type {};
+
+/*
+ *	conditional
+ */
+template <bool, typename T, typename F>
+struct	conditional { typedef T	type; };
+
+template <typename T, typename F>
+struct	conditional<false, T, F> { typedef F	type; };
+
 /*
  *	Iter Traits
  */
@@ -5,6 +5,7 @@
 #include "algorithm.hpp"
 
 #include <memory>
+#include <new>
 #include <algorithm>
 #include <stdexcept>
 #include <limits>
@@ -61,11 +62,16 @@ private:	//	Function
 		for (; n; ++_end_, --n) _alloc_.construct(_end_, v);
 	}
 
+	//	default initialization : trivial types are left as the memory was
+	void	_default_construct(size_type n) {
+		for (; n; ++_end_, --n) ::new(static_cast<void*>(&*_end_)) value_type;
+	}
+
 	void	_destruct(size_type n) {
-		for (; n && _end_; --_end_, --n) _alloc_.destroy(_end_);
+		for (; n && _end_; --n) _alloc_.destroy(--_end_);
 	}
 	void	_destruct(pointer until) {
-		for (; _end_ != until && _end_; --_end_) _alloc_.destroy(_end_);
+		while (_end_ != until) _alloc_.destroy(--_end_);
 	}
 
 public:		//	Cannonical
@@ -107,6 +113,7 @@ public:		//	Cannonical
 
 	~vector(void) {
 		if (_begin_ == 0) return ;
+		_destruct(_begin_);
 		size_type pre_cap = capacity();
 		_alloc_.deallocate(_begin_, pre_cap);
 	}
@@ -150,6 +157,42 @@ public:		//	Cannonical
 		else insert(_end_, n - size(), value);
 	}
 
+	/*
+	 *	resize without value initialization : the new elements of a trivial type
+	 *	are not written at all, for a buffer about to be overwritten anyway.
+	 */
+	void resize_default_init(size_type n) {
+		if (n > max_size()) throw std::out_of_range("Too much allocation");
+		if (size() > n) _destruct(size() - n);
+		else {
+			if (capacity() < n) reserve(n);
+			_default_construct(n - size());
+		}
+	}
+
+	/*
+	 *	Grows by up to n elements that filler(first, n) writes in place, and keeps
+	 *	the count it returns : read(fd, first, n) style producers, short reads included.
+	 *	If filler throws, the size is restored.
+	 */
+	template<typename Filler>
+	size_type append_uninitialized(size_type n, Filler filler) {
+		const size_type	old = size();
+		size_type		written;
+
+		resize_default_init(old + n);
+		try {
+			written = filler(data() + old, n);
+		}
+		catch (...) {
+			_destruct(_begin_ + old);
+			throw ;
+		}
+		if (written > n) written = n;
+		_destruct(_begin_ + old + written);
+		return written;
+	}
+
 	void assign( size_type count, const T& value )
 	{
 		clear();
@@ -347,4 +390,6 @@ void swap (ft::vector<T,Alloc>& lhs, ft::vector<T,Alloc>& rhs) {
 }
 }	//	STD
 
+#include "vector_bool.hpp"
+
 #endif
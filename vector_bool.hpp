@@ -0,0 +1,481 @@
+#ifndef VECTOR_BOOL_HPP
+# define VECTOR_BOOL_HPP
+
+#include "vector.hpp"
+#include "simd.hpp"
+
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+
+#include <stdint.h>
+
+namespace ft
+{
+
+/*
+ *	Bit Reference : what vector<bool> hands out for a writable element,
+ *	the word holding it and the mask of its bit
+ */
+class bit_reference
+{
+	uint64_t*	word;
+	uint64_t	mask;
+
+public:
+	bit_reference(uint64_t* w, uint64_t m) : word(w), mask(m) {}
+	bit_reference(const bit_reference& rhs) : word(rhs.word), mask(rhs.mask) {}
+
+	operator bool() const { return (*word & mask) != 0; }
+	bool operator~() const { return (*word & mask) == 0; }
+
+	bit_reference& operator=(bool v) {
+		if (v) *word |= mask;
+		else *word &= ~mask;
+		return *this;
+	}
+	bit_reference& operator=(const bit_reference& rhs) { return *this = bool(rhs); }
+
+	void flip() { *word ^= mask; }
+};
+
+inline void swap(bit_reference a, bit_reference b) {
+	const bool	tmp = a;
+	a = b;
+	b = tmp;
+}
+
+/*
+ *	Bit Iterator : a word and a bit offset in it
+ */
+struct bit_iterator_base
+{
+	uint64_t*	word;
+	unsigned	offset;
+
+	bit_iterator_base(uint64_t* w, unsigned o) : word(w), offset(o) {}
+
+	void bump_up() {
+		if (offset++ == 63) {
+			offset = 0;
+			++word;
+		}
+	}
+	void bump_down() {
+		if (offset-- == 0) {
+			offset = 63;
+			--word;
+		}
+	}
+	void advance(std::ptrdiff_t n) {
+		std::ptrdiff_t	bit = n + std::ptrdiff_t(offset);
+		std::ptrdiff_t	step = bit / 64;
+
+		bit %= 64;
+		if (bit < 0) {
+			bit += 64;
+			--step;
+		}
+		word += step;
+		offset = unsigned(bit);
+	}
+};
+
+inline std::ptrdiff_t operator-(const bit_iterator_base& lhs, const bit_iterator_base& rhs) {
+	return 64 * (lhs.word - rhs.word) + std::ptrdiff_t(lhs.offset) - std::ptrdiff_t(rhs.offset);
+}
+inline bool operator==(const bit_iterator_base& lhs, const bit_iterator_base& rhs) {
+	return lhs.word == rhs.word && lhs.offset == rhs.offset;
+}
+inline bool operator!=(const bit_iterator_base& lhs, const bit_iterator_base& rhs) { return !(lhs == rhs); }
+inline bool operator<(const bit_iterator_base& lhs, const bit_iterator_base& rhs) {
+	return lhs.word < rhs.word || (lhs.word == rhs.word && lhs.offset < rhs.offset);
+}
+inline bool operator>(const bit_iterator_base& lhs, const bit_iterator_base& rhs) { return rhs < lhs; }
+inline bool operator<=(const bit_iterator_base& lhs, const bit_iterator_base& rhs) { return !(rhs < lhs); }
+inline bool operator>=(const bit_iterator_base& lhs, const bit_iterator_base& rhs) { return !(lhs < rhs); }
+
+struct bit_iterator : public bit_iterator_base
+{
+	typedef std::random_access_iterator_tag	iterator_category;
+	typedef bool							value_type;
+	typedef std::ptrdiff_t					difference_type;
+	typedef bit_reference*					pointer;
+	typedef bit_reference					reference;
+
+	bit_iterator() : bit_iterator_base(0, 0) {}
+	bit_iterator(uint64_t* w, unsigned o) : bit_iterator_base(w, o) {}
+
+	reference operator*() const { return reference(word, uint64_t(1) << offset); }
+	reference operator[](difference_type n) const { return *(*this + n); }
+
+	bit_iterator& operator++() { bump_up(); return *this; }
+	bit_iterator operator++(int) { bit_iterator tmp = *this; bump_up(); return tmp; }
+	bit_iterator& operator--() { bump_down(); return *this; }
+	bit_iterator operator--(int) { bit_iterator tmp = *this; bump_down(); return tmp; }
+	bit_iterator& operator+=(difference_type n) { advance(n); return *this; }
+	bit_iterator& operator-=(difference_type n) { advance(-n); return *this; }
+	bit_iterator operator+(difference_type n) const { bit_iterator tmp = *this; return tmp += n; }
+	bit_iterator operator-(difference_type n) const { bit_iterator tmp = *this; return tmp -= n; }
+};
+
+inline bit_iterator operator+(std::ptrdiff_t n, const bit_iterator& it) { return it + n; }
+
+struct bit_const_iterator : public bit_iterator_base
+{
+	typedef std::random_access_iterator_tag	iterator_category;
+	typedef bool							value_type;
+	typedef std::ptrdiff_t					difference_type;
+	typedef const bool*						pointer;
+	typedef bool							reference;
+
+	bit_const_iterator() : bit_iterator_base(0, 0) {}
+	bit_const_iterator(const uint64_t* w, unsigned o) : bit_iterator_base(const_cast<uint64_t*>(w), o) {}
+	bit_const_iterator(const bit_iterator& it) : bit_iterator_base(it.word, it.offset) {}
+
+	reference operator*() const { return (*word >> offset) & 1; }
+	reference operator[](difference_type n) const { return *(*this + n); }
+
+	bit_const_iterator& operator++() { bump_up(); return *this; }
+	bit_const_iterator operator++(int) { bit_const_iterator tmp = *this; bump_up(); return tmp; }
+	bit_const_iterator& operator--() { bump_down(); return *this; }
+	bit_const_iterator operator--(int) { bit_const_iterator tmp = *this; bump_down(); return tmp; }
+	bit_const_iterator& operator+=(difference_type n) { advance(n); return *this; }
+	bit_const_iterator& operator-=(difference_type n) { advance(-n); return *this; }
+	bit_const_iterator operator+(difference_type n) const { bit_const_iterator tmp = *this; return tmp += n; }
+	bit_const_iterator operator-(difference_type n) const { bit_const_iterator tmp = *this; return tmp -= n; }
+};
+
+inline bit_const_iterator operator+(std::ptrdiff_t n, const bit_const_iterator& it) { return it + n; }
+
+/*
+ *	vector<bool> : one bit per element, packed in 64 bit words.
+ *	Elements are reached through bit_reference proxies : no bool& and no data().
+ *	Every bit past size() in the allocated words stays 0, so whole word kernels
+ *	(simd.hpp) count, search and combine without masking the tail.
+ *	npos is returned by the searches when no bit qualifies.
+ */
+template<typename _Alloc>
+class vector<bool, _Alloc>
+{
+public:
+	typedef bool										value_type;
+	typedef _Alloc										allocator_type;
+	typedef bit_reference								reference;
+	typedef bool										const_reference;
+	typedef std::size_t									size_type;
+	typedef std::ptrdiff_t								difference_type;
+	typedef uint64_t									word_type;
+	typedef bit_iterator								iterator;
+	typedef bit_const_iterator							const_iterator;
+	typedef ft::reverse_iterator<iterator>				reverse_iterator;
+	typedef ft::reverse_iterator<const_iterator>		const_reverse_iterator;
+
+	static const size_type	npos = size_type(-1);
+
+private:
+	typedef typename allocator_type::template rebind<word_type>::other	word_allocator;
+
+	enum { word_bits = 64 };
+
+	word_allocator	_alloc_;
+	word_type*		_words_;
+	size_type		_size_;
+	size_type		_cap_;		//	in words
+
+	static size_type words_for(size_type bits) { return (bits + word_bits - 1) / word_bits; }
+	static word_type low_mask(size_type bits) { return bits % word_bits ? (word_type(1) << bits % word_bits) - 1 : ~word_type(0); }
+
+	size_type _used(void) const { return words_for(_size_); }
+
+	//	every new word is zeroed, keeping the tail invariant
+	void _grow(size_type bits) {
+		const size_type	need = words_for(bits);
+		if (need <= _cap_) return ;
+
+		const size_type	cap = need < _cap_ * 2 ? _cap_ * 2 : need;
+		word_type* const	w = _alloc_.allocate(cap);
+		if (_words_) std::memcpy(w, _words_, _used() * sizeof(word_type));
+		std::memset(w + _used(), 0, (cap - _used()) * sizeof(word_type));
+		if (_words_) _alloc_.deallocate(_words_, _cap_);
+		_words_ = w;
+		_cap_ = cap;
+	}
+
+	void _fill(size_type first, size_type last, bool v) {
+		if (first >= last) return ;
+		const size_type	fw = first / word_bits;
+		const size_type	lw = (last - 1) / word_bits;
+		const word_type	fm = ~word_type(0) << first % word_bits;
+		const word_type	lm = low_mask(last);
+
+		if (fw == lw) {
+			if (v) _words_[fw] |= fm & lm;
+			else _words_[fw] &= ~(fm & lm);
+			return ;
+		}
+		if (v) _words_[fw] |= fm;
+		else _words_[fw] &= ~fm;
+		std::memset(_words_ + fw + 1, v ? 0xff : 0, (lw - fw - 1) * sizeof(word_type));
+		if (v) _words_[lw] |= lm;
+		else _words_[lw] &= ~lm;
+	}
+
+	void _flip(size_type first, size_type last) {
+		if (first >= last) return ;
+		const size_type	fw = first / word_bits;
+		const size_type	lw = (last - 1) / word_bits;
+		const word_type	fm = ~word_type(0) << first % word_bits;
+		const word_type	lm = low_mask(last);
+
+		if (fw == lw) {
+			_words_[fw] ^= fm & lm;
+			return ;
+		}
+		_words_[fw] ^= fm;
+		for (size_type i = fw + 1; i < lw; ++i) _words_[i] = ~_words_[i];
+		_words_[lw] ^= lm;
+	}
+
+	//	drops the bits from n on, clearing them
+	void _shrink(size_type n) {
+		_fill(n, _size_, false);
+		_size_ = n;
+	}
+
+	void _check_range(size_type first, size_type last) const {
+		if (first > last || last > _size_) throw std::out_of_range("vector<bool> : bad range");
+	}
+
+	template<int Op>
+	vector& _combine(const vector& rhs) {
+		if (rhs._size_ != _size_) throw std::invalid_argument("vector<bool> : size mismatch");
+		simd::combine<Op>(_words_, rhs._words_, _used());
+		return *this;
+	}
+
+public:
+	explicit vector(const allocator_type& alloc = allocator_type())
+	: _alloc_(alloc), _words_(0), _size_(0), _cap_(0) {}
+	explicit vector(size_type n, const bool& value = false, const allocator_type& alloc = allocator_type())
+	: _alloc_(alloc), _words_(0), _size_(0), _cap_(0) { resize(n, value); }
+	template<typename InputIterator>
+	vector(InputIterator first, InputIterator last, const allocator_type& alloc = allocator_type(),
+		   typename enable_if<!ft::is_integral<InputIterator>::value>::type* = 0)
+	: _alloc_(alloc), _words_(0), _size_(0), _cap_(0) { assign(first, last); }
+	vector(const vector& v) : _alloc_(v._alloc_), _words_(0), _size_(0), _cap_(0) { *this = v; }
+
+	~vector(void) {
+		if (_words_) _alloc_.deallocate(_words_, _cap_);
+	}
+
+	vector& operator=(const vector& v) {
+		if (this == &v) return *this;
+		clear();
+		_grow(v._size_);
+		if (v._used()) std::memcpy(_words_, v._words_, v._used() * sizeof(word_type));
+		_size_ = v._size_;
+		return *this;
+	}
+
+	allocator_type get_allocator(void) const { return allocator_type(_alloc_); }
+
+	//	Size
+	bool empty(void) const { return _size_ == 0; }
+	size_type size(void) const { return _size_; }
+	size_type max_size(void) const {
+		const size_type	words = _alloc_.max_size();
+		return words > npos / word_bits ? npos : words * word_bits;
+	}
+	size_type capacity(void) const { return _cap_ * word_bits; }
+	void reserve(size_type n) {
+		if (n > max_size()) throw std::length_error("vector<bool> : too much allocation");
+		_grow(n);
+	}
+	void resize(size_type n, bool value = false) {
+		if (n <= _size_) return _shrink(n);
+		if (n > max_size()) throw std::out_of_range("Too much allocation");
+		_grow(n);
+		if (value) _fill(_size_, n, true);
+		_size_ = n;
+	}
+
+	//	Iterator
+	iterator begin(void) { return iterator(_words_, 0); }
+	const_iterator begin(void) const { return const_iterator(_words_, 0); }
+	iterator end(void) { return begin() + difference_type(_size_); }
+	const_iterator end(void) const { return begin() + difference_type(_size_); }
+	reverse_iterator rbegin(void) { return reverse_iterator(end()); }
+	const_reverse_iterator rbegin(void) const { return const_reverse_iterator(end()); }
+	reverse_iterator rend(void) { return reverse_iterator(begin()); }
+	const_reverse_iterator rend(void) const { return const_reverse_iterator(begin()); }
+
+	//	Elem Access
+	reference operator[](size_type n) { return reference(_words_ + n / word_bits, word_type(1) << n % word_bits); }
+	const_reference operator[](size_type n) const { return (_words_[n / word_bits] >> n % word_bits) & 1; }
+	reference at(size_type n) {
+		if (n >= _size_) throw std::out_of_range("index out of range");
+		return (*this)[n];
+	}
+	const_reference at(size_type n) const {
+		if (n >= _size_) throw std::out_of_range("index out of range");
+		return (*this)[n];
+	}
+	reference front(void) { return (*this)[0]; }
+	const_reference front(void) const { return (*this)[0]; }
+	reference back(void) { return (*this)[_size_ - 1]; }
+	const_reference back(void) const { return (*this)[_size_ - 1]; }
+
+	//	the packed words, size() bits then zeros
+	const word_type* words(void) const { return _words_; }
+	size_type word_count(void) const { return _used(); }
+
+	//	Modifier
+	void push_back(bool value) {
+		if (_size_ == capacity()) _grow(_size_ + 1);
+		if (value) _words_[_size_ / word_bits] |= word_type(1) << _size_ % word_bits;
+		++_size_;
+	}
+	void pop_back(void) { _shrink(_size_ - 1); }
+
+	void clear(void) {
+		if (_words_) std::memset(_words_, 0, _used() * sizeof(word_type));
+		_size_ = 0;
+	}
+
+	void assign(size_type n, bool value) {
+		clear();
+		resize(n, value);
+	}
+	template<typename Iter>
+	void assign(Iter first, Iter last, typename enable_if<!ft::is_integral<Iter>::value>::type* = 0) {
+		clear();
+		for (; first != last; ++first) push_back(bool(*first));
+	}
+
+	iterator insert(iterator pos, bool value) {
+		const size_type	len = size_type(pos - begin());
+		insert(pos, 1, value);
+		return begin() + difference_type(len);
+	}
+	void insert(iterator pos, size_type n, bool value) {
+		const size_type	at = size_type(pos - begin());
+		const size_type	old = _size_;
+
+		reserve(_size_ + n);
+		_size_ += n;
+		for (size_type i = old; i-- > at; ) (*this)[i + n] = bool((*this)[i]);
+		_fill(at, at + n, value);
+	}
+	template<typename Iter>
+	void insert(iterator pos, Iter first, Iter last, typename enable_if<!ft::is_integral<Iter>::value>::type* = 0) {
+		vector	tail(pos, end());
+		_shrink(size_type(pos - begin()));
+		for (; first != last; ++first) push_back(bool(*first));
+		for (const_iterator it = tail.begin(); it != tail.end(); ++it) push_back(*it);
+	}
+
+	iterator erase(iterator pos) { return erase(pos, pos + 1); }
+	iterator erase(iterator first, iterator last) {
+		const size_type	at = size_type(first - begin());
+		const size_type	n = size_type(last - first);
+
+		for (size_type i = at; i + n < _size_; ++i) (*this)[i] = bool((*this)[i + n]);
+		_shrink(_size_ - n);
+		return begin() + difference_type(at);
+	}
+
+	void swap(vector& v) {
+		if (this == &v) return ;
+		std::swap(_words_, v._words_);
+		std::swap(_size_, v._size_);
+		std::swap(_cap_, v._cap_);
+		std::swap(_alloc_, v._alloc_);
+	}
+	static void swap(reference a, reference b) { ft::swap(a, b); }
+
+	/*
+	 *	Word at a time operations
+	 */
+	//	set bits
+	size_type count(void) const { return simd::popcount(_words_, _used()); }
+	size_type count(size_type first, size_type last) const {
+		_check_range(first, last);
+		if (first == last) return 0;
+		const size_type	fw = first / word_bits;
+		const size_type	lw = (last - 1) / word_bits;
+		const word_type	fm = ~word_type(0) << first % word_bits;
+		const word_type	lm = low_mask(last);
+
+		if (fw == lw) return simd::popcount_word(_words_[fw] & fm & lm);
+		return simd::popcount_word(_words_[fw] & fm) + simd::popcount(_words_ + fw + 1, lw - fw - 1)
+			+ simd::popcount_word(_words_[lw] & lm);
+	}
+	bool any(void) const { return find_first() != npos; }
+	bool none(void) const { return !any(); }
+
+	//	index of the first set bit
+	size_type find_first(void) const {
+		const size_type	w = simd::find_word(_words_, _used(), 0);
+		return w == _used() ? npos : w * word_bits + size_type(__builtin_ctzll(_words_[w]));
+	}
+	//	index of the first set bit after pos
+	size_type find_next(size_type pos) const {
+		if (pos >= _size_ || ++pos >= _size_) return npos;
+		size_type		w = pos / word_bits;
+		const word_type	head = _words_[w] & (~word_type(0) << pos % word_bits);
+
+		if (head) return w * word_bits + size_type(__builtin_ctzll(head));
+		++w;
+		w += simd::find_word(_words_ + w, _used() - w, 0);
+		return w == _used() ? npos : w * word_bits + size_type(__builtin_ctzll(_words_[w]));
+	}
+
+	//	[first, last) to value / false / toggled
+	void set(size_type first, size_type last, bool value = true) {
+		_check_range(first, last);
+		_fill(first, last, value);
+	}
+	void reset(size_type first, size_type last) { set(first, last, false); }
+	void flip(size_type first, size_type last) {
+		_check_range(first, last);
+		_flip(first, last);
+	}
+	void set(void) { _fill(0, _size_, true); }
+	void reset(void) { _fill(0, _size_, false); }
+	void flip(void) { _flip(0, _size_); }
+
+	//	element wise with a vector of the same size, std::invalid_argument otherwise
+	vector& operator&=(const vector& rhs) { return _combine<simd::word_and>(rhs); }
+	vector& operator|=(const vector& rhs) { return _combine<simd::word_or>(rhs); }
+	vector& operator^=(const vector& rhs) { return _combine<simd::word_xor>(rhs); }
+};
+
+template<typename _Alloc>
+const typename vector<bool, _Alloc>::size_type	vector<bool, _Alloc>::npos;
+
+template<typename _Alloc>
+bool operator==(const ft::vector<bool, _Alloc>& lhs, const ft::vector<bool, _Alloc>& rhs) {
+	return lhs.size() == rhs.size() && (lhs.empty()
+		|| std::memcmp(lhs.words(), rhs.words(), lhs.word_count() * sizeof(uint64_t)) == 0);
+}
+
+template<typename _Alloc>
+ft::vector<bool, _Alloc> operator&(const ft::vector<bool, _Alloc>& lhs, const ft::vector<bool, _Alloc>& rhs) {
+	ft::vector<bool, _Alloc>	ret(lhs);
+	return ret &= rhs;
+}
+template<typename _Alloc>
+ft::vector<bool, _Alloc> operator|(const ft::vector<bool, _Alloc>& lhs, const ft::vector<bool, _Alloc>& rhs) {
+	ft::vector<bool, _Alloc>	ret(lhs);
+	return ret |= rhs;
+}
+template<typename _Alloc>
+ft::vector<bool, _Alloc> operator^(const ft::vector<bool, _Alloc>& lhs, const ft::vector<bool, _Alloc>& rhs) {
+	ft::vector<bool, _Alloc>	ret(lhs);
+	return ret ^= rhs;
+}
+
+}	//	FT
+
+#endif